@@ -4,31 +4,57 @@
  */
 
 #include "AdaptiveVolumeControl.h"
-#include <iostream>
+#include "BasicVolumeControl.h"
+#include "VolumeEventSink.h"
+#include "GainRamp.h"
+#include "Instrumentation.h"
+#include "PolicyEngine.h"
+#include "DuckingArbiter.h"
+#include "VolumeSmoother.h"
+#include "VolumeState.h"
+#include "SpeedTrend.h"
+#ifdef ADAPTIVE_VOLUME_USE_LUT
+#include "VolumeLut.h"
+#endif
 #include <thread>
+#include <cassert>
 #include <cmath>
 #include <algorithm>
 
 using namespace std::chrono;
 
-// ANSI color codes for console output
-#define RESET   "\033[0m"
-#define RED     "\033[31m"
-#define GREEN   "\033[32m"
-#define YELLOW  "\033[33m"
-#define BLUE    "\033[34m"
-#define CYAN    "\033[36m"
+// Sink notifications; real-time builds compile them out (still type-checked) so the control path performs no I/O
+#ifdef ADAPTIVE_VOLUME_RT
+#define AVC_NOTIFY(call) do { if(false) sink->call; } while(0)
+#else
+#define AVC_NOTIFY(call) do { if(sink) sink->call; } while(0)
+#endif
 
 /**
  * @brief Constructor initializes all member variables.
+ * @param clock Time source for timed events.
  */
-AdaptiveVolumeControl::AdaptiveVolumeControl()
+AdaptiveVolumeControl::AdaptiveVolumeControl(Clock& clock)
     : speed(0), previousSpeed(0), cabinNoise(30),
       reverseGear(false), hornActive(false), navSpeaking(false),
       mode(Mode::COMFORT), controlType(VolumeControlType::ADAPTIVE), manualVolume(25),
       targetVolume(DEFAULT_VOLUME), currentVolume(DEFAULT_VOLUME),
-      hornDuckActive(false),
-      hornDuckStartTime(system_clock::now()) {}
+      clock(&clock), frameTime(), hasFrameTime(false), hornDuckActive(false),
+      hornDuckStartTime(clock.now()),
+      activeModifiers(0), sink(nullptr), events(nullptr), policy(nullptr), profile(), profileGeneration(0), ducking(nullptr), smoother(nullptr), smootherTime(0.0), speedTrend(nullptr),
+      pending(), cachedBaseVolume(BASE_VOLUME), externalDuckGain(1.0f), baseVolumeStale(true),
+      sampleRate(DEFAULT_SAMPLE_RATE), tickDt(SMOOTH_INTERVAL), tickFactor(SMOOTH_FACTOR) {}
+
+/**
+ * @brief Evaluates the adaptive policy from a profile instead of the built-in constants.
+ * @param engine Policy engine, or nullptr for the built-in policy.
+ */
+void AdaptiveVolumeControl::setPolicyEngine(const PolicyEngine* engine) {
+    policy = engine;
+    if(engine) profile = engine->acquire(profileGeneration);
+    else profile.reset();
+    baseVolumeStale = true;
+}
 
 /**
  * @brief Updates internal state and recalculates volume based on new inputs.
@@ -44,26 +70,97 @@ AdaptiveVolumeControl::AdaptiveVolumeControl()
 void AdaptiveVolumeControl::update(int newSpeed, int newNoise, bool newReverseGear, bool newHornActive,
                                    bool newNavSpeaking, Mode newMode,
                                    VolumeControlType newControlType, int newManualVolume) {
+    pending.speed = newSpeed;
+    pending.cabinNoise = newNoise;
+    pending.reverseGear = newReverseGear;
+    pending.hornActive = newHornActive;
+    pending.navSpeaking = newNavSpeaking;
+    pending.mode = newMode;
+    pending.controlType = newControlType;
+    if (newControlType == VolumeControlType::MANUAL) pending.manualVolume = newManualVolume;
+    commit();
+}
+
+/**
+ * @brief Updates internal state from a packed set of inputs stamped by the caller.
+ * @param inputs New inputs.
+ * @param now Frame time.
+ */
+void AdaptiveVolumeControl::update(ControlInputs inputs, Clock::time_point now) {
+    if(inputs.controlType != VolumeControlType::MANUAL) inputs.manualVolume = pending.manualVolume;
+    pending = inputs;
+    commit(now);
+}
+
+/**
+ * @brief Applies the staged inputs as one control frame at a caller-supplied time.
+ * @param now Frame time.
+ */
+void AdaptiveVolumeControl::commit(Clock::time_point now) {
+    frameTime = now;
+    hasFrameTime = true;
+    commit();
+    hasFrameTime = false;
+}
+
+/**
+ * @brief Applies the staged inputs as one control frame.
+ */
+void AdaptiveVolumeControl::commit() {
+    AVC_INSTR_TRACE(UPDATE);
+    AVC_INSTR_COUNT(updates);
+
+    bool speedChanged = pending.speed != speed;
+    bool baseChanged = speedChanged || pending.cabinNoise != cabinNoise || pending.mode != mode;
+    bool hornChanged = pending.hornActive != hornActive;
+    bool manual = pending.controlType == VolumeControlType::MANUAL;
+    bool profileChanged = policy && policy->generation() != profileGeneration;
+    if(speedTrend) speedTrend->addSample(now(), static_cast<float>(pending.speed));
+
+    // Fast path: repeated frames keep the cached target. Speed must also have
+    // been stable for a frame (brake modifiers compare against previousSpeed),
+    // and a running horn-duck hold must be re-evaluated against the clock.
+    bool unchanged = !baseChanged && !hornChanged && previousSpeed == speed && !profileChanged &&
+                     pending.reverseGear == reverseGear && pending.navSpeaking == navSpeaking &&
+                     pending.controlType == controlType && (!manual || pending.manualVolume == manualVolume);
+    if(unchanged && !speedTrend && (!hornDuckActive || hornActive) && (!ducking || ducking->isIdle())) {
+        if(hornActive) hornDuckStartTime = now(); // horn still held: the hold restarts from now
+        return;
+    }
+
+    if(profileChanged) profile = policy->acquire(profileGeneration);
     previousSpeed = speed;
-    speed = newSpeed;
-    cabinNoise = newNoise;
-    reverseGear = newReverseGear;
+    speed = pending.speed;
+    cabinNoise = pending.cabinNoise;
+    reverseGear = pending.reverseGear;
 
-    // Horn press/release messages
-    if(newHornActive && !hornActive) std::cout << YELLOW << "[Horn Pressed]" << RESET << "\n";
-    if(!newHornActive && hornActive) std::cout << YELLOW << "[Horn Released]" << RESET << "\n";
+    // Horn press/release notification
+    if(hornChanged) AVC_NOTIFY(onHornChanged(pending.hornActive));
 
-    hornActive = newHornActive;
-    navSpeaking = newNavSpeaking;
-    mode = newMode;
+    hornActive = pending.hornActive;
+    navSpeaking = pending.navSpeaking;
+    mode = pending.mode;
 
-    controlType = newControlType;
-    if (controlType == VolumeControlType::MANUAL) manualVolume = newManualVolume;
+    controlType = pending.controlType;
+    if (manual) manualVolume = pending.manualVolume;
 
-    handleHornDucking(newHornActive);
-    handleNavigationDucking(newNavSpeaking);
+    // The duck timer only needs the clock while the horn is involved
+    if(hornActive || hornDuckActive) handleHornDucking(hornActive);
+    handleNavigationDucking(navSpeaking);
 
+    if(baseChanged) baseVolumeStale = true;
     calculateTargetVolume();
+
+    // External duck sources scale the target in both control modes
+    externalDuckGain = 1.0f;
+    if(ducking && !ducking->isIdle()) {
+        float duckGain = ducking->evaluate(now());
+        if(duckGain < 1.0f) {
+            targetVolume *= duckGain;
+            externalDuckGain = duckGain;
+            activeModifiers |= MODIFIER_EXTERNAL_DUCK;
+        }
+    }
 }
 
 /**
@@ -71,11 +168,12 @@ void AdaptiveVolumeControl::update(int newSpeed, int newNoise, bool newReverseGe
  * @param newHornActive Horn active status.
  */
 void AdaptiveVolumeControl::handleHornDucking(bool newHornActive) {
-    auto now = system_clock::now();
+    Clock::time_point now = this->now();
 
     // --- Horn Ducking Logic ---
     // If horn is pressed, activate ducking and start timer
     if (newHornActive) {
+        if(!hornDuckActive) AVC_INSTR_COUNT(hornDuckActivations);
         hornDuckActive = true;
         hornDuckStartTime = now;
     } 
@@ -87,7 +185,8 @@ void AdaptiveVolumeControl::handleHornDucking(bool newHornActive) {
     // If ducking is active, check if duration has passed to deactivate
     else if (hornDuckActive) {
         duration<double> elapsed = now - hornDuckStartTime;
-        if (elapsed.count() >= HORN_DUCK_DURATION) {
+        double hold = profile ? profile->hornDuckDuration : HORN_DUCK_DURATION;
+        if (elapsed.count() >= hold) {
             hornDuckActive = false;
         }
     }
@@ -103,45 +202,51 @@ void AdaptiveVolumeControl::handleNavigationDucking(bool newNavSpeaking) {
     navSpeaking = newNavSpeaking;
 }
 
+/**
+ * @brief Determines which event modifiers apply in the current state.
+ * @return VolumeModifier bits.
+ */
+std::uint8_t AdaptiveVolumeControl::modifierMask() const {
+    std::uint8_t modifiers = 0;
+
+    if(hornDuckActive) modifiers |= MODIFIER_HORN_DUCK;
+    if(navSpeaking) modifiers |= MODIFIER_NAVIGATION;
+    if(reverseGear) modifiers |= MODIFIER_REVERSE;
+
+    // Braking is only considered when not reversing
+    if(!reverseGear && speedTrend) {
+        // Fitted deceleration, independent of the update rate
+        float deceleration = -speedTrend->acceleration();
+        if(deceleration > SUDDEN_BRAKE_DECELERATION) modifiers |= MODIFIER_SUDDEN_BRAKE;
+        else if(deceleration > SPEED_DECREASE_DECELERATION) modifiers |= MODIFIER_SPEED_DECREASE;
+    } else if(!reverseGear) {
+        int speedDiff = previousSpeed - speed;
+        int brakeThreshold = profile ? profile->suddenBrakeThreshold : SUDDEN_BRAKE_THRESHOLD;
+        if(speedDiff > brakeThreshold) modifiers |= MODIFIER_SUDDEN_BRAKE;
+        else if(speed < previousSpeed) modifiers |= MODIFIER_SPEED_DECREASE;
+    }
+
+    return modifiers;
+}
+
 /**
  * @brief Applies event-based volume modifiers (horn, navigation, reverse, braking).
  * @param baseVolume Base volume before modifiers.
  * @return Modified volume after applying events.
  */
 float AdaptiveVolumeControl::applyVolumeModifiers(float baseVolume) {
-    // --- Horn Ducking ---
-    if(hornDuckActive) {
-        std::cout << YELLOW << "[Horn Duck Active]" << RESET << "\n";
-        baseVolume *= HORN_DUCK_MULTIPLIER; // Reduce volume while horn is active
-    }
+    std::uint8_t modifiers = modifierMask();
 
-    // --- Navigation Speaking ---
-    if(navSpeaking) {
-        std::cout << BLUE << "[Navigation Speaking]" << RESET << "\n";
-        baseVolume *= 0.5f; // Further reduce volume for navigation prompts
-    }
+    // Horn, navigation, reverse and braking multipliers (shared with BasicVolumeControl)
+    baseVolume = scaleByModifiers(baseVolume, modifiers);
 
-    // --- Reverse Gear Logic ---
-    if(reverseGear) {
-        std::cout << RED << "[Reverse Gear Active]" << RESET << "\n";
-        baseVolume *= 0.25f; // Drastically lower volume when reversing
-    }
-
-    // --- Sudden Brake / Speed Decrease ---
-    if(!reverseGear) {
-        int speedDiff = previousSpeed - speed;
-        if(speedDiff > 10) {
-            std::cout << RED << "[Sudden Brake]" << RESET << "\n";
-            baseVolume *= 0.5f; // Sudden brake: halve the volume
-        } else if(speed < previousSpeed) {
-            std::cout << CYAN << "[Speed Decrease]" << RESET << "\n";
-            baseVolume *= 0.9f; // Small speed decrease: slightly lower volume
-        }
-    }
+    activeModifiers = modifiers;
+    AVC_NOTIFY(onModifiersApplied(modifiers));
+    if(modifiers & MODIFIER_SUDDEN_BRAKE) AVC_INSTR_COUNT(suddenBrakes);
 
     // Clamp volume to allowed range
-    if(baseVolume < MIN_VOLUME) baseVolume = MIN_VOLUME;
-    if(baseVolume > MAX_ADAPTIVE_VOLUME) baseVolume = MAX_ADAPTIVE_VOLUME;
+    if(baseVolume < MIN_VOLUME) { baseVolume = MIN_VOLUME; AVC_INSTR_COUNT(clampMin); }
+    if(baseVolume > MAX_ADAPTIVE_VOLUME) { baseVolume = MAX_ADAPTIVE_VOLUME; AVC_INSTR_COUNT(clampMax); }
 
     return baseVolume;
 }
@@ -151,80 +256,250 @@ float AdaptiveVolumeControl::applyVolumeModifiers(float baseVolume) {
  */
 void AdaptiveVolumeControl::calculateTargetVolume() {
     if(controlType == VolumeControlType::MANUAL) {
-        targetVolume = std::min<float>(manualVolume, MAX_VOLUME);
+        // Clamped into [MIN_VOLUME, MAX_VOLUME], the range MAX_SMOOTH_STEPS is derived from
+        targetVolume = std::clamp<float>(manualVolume, MIN_VOLUME, MAX_VOLUME);
+        activeModifiers = 0;
+        return;
+    }
+
+    // Tuned policy: flat tables and multipliers from the profile
+    if(profile) {
+        activeModifiers = modifierMask();
+        AVC_NOTIFY(onModifiersApplied(activeModifiers));
+        targetVolume = profile->targetVolume(speed, cabinNoise, mode, activeModifiers);
+        if(activeModifiers & MODIFIER_SUDDEN_BRAKE) AVC_INSTR_COUNT(suddenBrakes);
+        if(targetVolume == profile->minVolume) AVC_INSTR_COUNT(clampMin);
+        if(targetVolume == profile->maxVolume) AVC_INSTR_COUNT(clampMax);
         return;
     }
 
-    float baseVolume = 25.0f;
+#ifdef ADAPTIVE_VOLUME_USE_LUT
+    // Precomputed policy: two table loads instead of the arithmetic below
+    if(volumeLutCovers(cabinNoise)) {
+        activeModifiers = modifierMask();
+        AVC_NOTIFY(onModifiersApplied(activeModifiers));
+        targetVolume = lookupTargetVolume(speed, cabinNoise, mode, activeModifiers);
+        // The table hides the unclamped value; a result on a rail counts as a clamp hit
+        if(activeModifiers & MODIFIER_SUDDEN_BRAKE) AVC_INSTR_COUNT(suddenBrakes);
+        if(targetVolume == MIN_VOLUME) AVC_INSTR_COUNT(clampMin);
+        if(targetVolume == MAX_ADAPTIVE_VOLUME) AVC_INSTR_COUNT(clampMax);
+        return;
+    }
+#endif
 
-    if(speed > 70) baseVolume += 15;
-    else if(speed > 30) baseVolume += 10;
-    else if(speed > 0) baseVolume += 5;
+    // Speed, noise and mode terms only change with their inputs; modifiers are reapplied every frame
+    if(baseVolumeStale) {
+        cachedBaseVolume = adaptiveBaseVolume(speed, cabinNoise, mode);
+        baseVolumeStale = false;
+    }
 
-    baseVolume += cabinNoise * 0.2f;
+    targetVolume = applyVolumeModifiers(cachedBaseVolume);
+}
 
+/**
+ * @brief Computes the speed, noise and mode terms of the built-in policy.
+ * @param speed Vehicle speed.
+ * @param noise Cabin noise level.
+ * @param mode Driving mode.
+ * @return Adaptive volume before event modifiers.
+ */
+float AdaptiveVolumeControl::adaptiveBaseVolume(int speed, int noise, Mode mode) {
     switch(mode) {
-        case Mode::ECO: baseVolume *= 0.8f; break;
-        case Mode::COMFORT: break;
-        case Mode::SPORTS: baseVolume *= 1.2f; break;
+        case Mode::ECO: return adaptiveBaseVolumeFor<Mode::ECO>(speed, noise);
+        case Mode::SPORTS: return adaptiveBaseVolumeFor<Mode::SPORTS>(speed, noise);
+        default: return adaptiveBaseVolumeFor<Mode::COMFORT>(speed, noise);
     }
+}
 
-    targetVolume = applyVolumeModifiers(baseVolume);
+/**
+ * @brief Evaluates the target the current state would have at another cabin noise level.
+ * @param noise Cabin noise level to evaluate.
+ * @return Target volume (the manual volume in manual mode).
+ */
+float AdaptiveVolumeControl::targetVolumeAtNoise(int noise) const {
+    if(controlType == VolumeControlType::MANUAL || noise == cabinNoise) return targetVolume;
+
+    std::uint8_t modifiers = activeModifiers;
+    float volume;
+    if(profile) {
+        volume = profile->targetVolume(speed, noise, mode, modifiers);
+    } else {
+        // Same multiplier order and clamp as applyVolumeModifiers()
+        volume = scaleByModifiers(adaptiveBaseVolume(speed, noise, mode), modifiers);
+        volume = std::max(MIN_VOLUME, std::min(volume, MAX_ADAPTIVE_VOLUME));
+    }
+    return volume * externalDuckGain;
 }
 
 /**
  * @brief Smoothly transitions current volume towards target volume.
+ * @param factor Fraction of the remaining distance to cover in this step.
  */
-void AdaptiveVolumeControl::smoothVolumeTransition() {
+void AdaptiveVolumeControl::smoothVolumeTransition(float factor) {
     // --- Smooth Volume Transition ---
-    // Gradually move currentVolume towards targetVolume using SMOOTH_FACTOR
+    // Gradually move currentVolume towards targetVolume by the given factor
     float diff = targetVolume - currentVolume;
-    currentVolume += diff * SMOOTH_FACTOR;
+    currentVolume += diff * factor;
 }
 
 /**
- * @brief Prints event header information.
- * @param eventName Name of the event.
+ * @brief Advances the volume smoothing by one step covering elapsed time.
+ * @param dt Elapsed time in seconds since the previous tick.
  */
-void AdaptiveVolumeControl::printEventHeader(const std::string& eventName) {
-    std::cout << CYAN << "\n===============================" << RESET << "\n";
-    std::cout << CYAN << " EVENT: " << eventName << RESET << "\n";
-    std::cout << CYAN << "===============================" << RESET << "\n";
+void AdaptiveVolumeControl::tick(double dt) {
+    AVC_INSTR_TRACE(TICK);
+    if(!(dt > 0.0)) return; // No elapsed time (or a negative/NaN dt): nothing to smooth
+    if(smoother) {
+        // Whole ticks at the smoother's own interval: block sizes that vary
+        // (480/512 frames) neither restart nor reconfigure its transition
+        double interval = smoother->getTickInterval();
+        int limit = smoother->maxTicks();
+        int steps = 0;
+        float previous = currentVolume;
+        smootherTime += dt;
+        for(; smootherTime >= interval * (1.0 - 1e-9) && steps < limit; ++steps) {
+            currentVolume = smoother->step(currentVolume, targetVolume);
+            smootherTime -= interval;
+        }
+        if(steps == limit) smootherTime = 0.0; // settled: the leftover time has nothing to move
+        if(currentVolume != previous) printCurrentVolume();
+        return;
+    }
+    if(isSettled()) {
+        currentVolume = targetVolume;
+        return;
+    }
 
-    std::cout << "Speed: " << speed << " km/h | Noise: " << cabinNoise << " dB | Mode: "
-              << (mode == Mode::ECO ? "Eco" : mode == Mode::COMFORT ? "Comfort" : "Sports") << "\n";
+    // SMOOTH_FACTOR covers SMOOTH_INTERVAL; scale it to dt so that N ticks of
+    // dt/N converge exactly like one tick of dt. Recomputed only when dt changes.
+    if(dt != tickDt) {
+        tickDt = dt;
+        tickFactor = 1.0f - static_cast<float>(std::pow(1.0 - SMOOTH_FACTOR, dt / SMOOTH_INTERVAL));
+    }
 
-    std::cout << "Reverse: " << (reverseGear ? RED "Yes" RESET : GREEN "No" RESET)
-              << " | Horn: " << (hornActive ? YELLOW "Yes" RESET : GREEN "No" RESET)
-              << " | Navigation: " << (navSpeaking ? BLUE "Yes" RESET : GREEN "No" RESET) << "\n";
+    smoothVolumeTransition(tickFactor);
+    if(isSettled()) currentVolume = targetVolume;
+    printCurrentVolume();
+}
 
-    std::cout << "Control: " << (controlType == VolumeControlType::ADAPTIVE ? CYAN "Adaptive" RESET : GREEN "Manual" RESET) << "\n";
-    if(controlType == VolumeControlType::MANUAL) std::cout << GREEN << "Manual Volume: " << manualVolume << RESET << "\n";
+/**
+ * @brief Applies the smoothed volume to an interleaved PCM block.
+ * @param samples Interleaved samples, modified in place.
+ * @param n Number of frames (samples per channel).
+ * @param channels Number of interleaved channels.
+ */
+void AdaptiveVolumeControl::processBlock(float* samples, std::size_t n, int channels) {
+    float startGain = currentVolume / MAX_VOLUME;
+    advance(n);
+    applyGainRamp(samples, n, channels, startGain, currentVolume / MAX_VOLUME);
+}
 
-    std::cout << "Target Volume: " << YELLOW << (int)targetVolume << RESET
-              << " | Current Volume: " << BLUE << (int)currentVolume << RESET << "\n";
-    std::cout << "-------------------------------\n";
+/**
+ * @brief Reports event header information to the attached sink.
+ * @param eventName Name of the event.
+ */
+void AdaptiveVolumeControl::printEventHeader(std::string_view eventName) {
+    AVC_NOTIFY(onEventStart(eventName, *this));
 }
 
 /**
- * @brief Prints the current volume value.
+ * @brief Reports the current volume value to the attached sink.
  */
 void AdaptiveVolumeControl::printCurrentVolume() {
-    std::cout << GREEN << "[Volume Update] Current: " << (int)currentVolume << RESET << "\n";
+    AVC_NOTIFY(onVolumeStep(currentVolume));
 }
 
 /**
  * @brief Prints event info and smoothly transitions volume to target.
  * @param eventName Name of the event to display.
  */
-void AdaptiveVolumeControl::printAndSmooth(const std::string& eventName) {
+void AdaptiveVolumeControl::printAndSmooth(std::string_view eventName) {
     printEventHeader(eventName);
-    while(std::abs(currentVolume - targetVolume) > 0.5f) {
-        smoothVolumeTransition(); // Smoothly approach target volume
+    if(smoother) {
+        // Bounded: a transition takes at most maxTicks() steps, no settle polling
+        auto interval = duration<double>(smoother->getTickInterval());
+        for(int left = smoother->maxTicks(); left > 0 && currentVolume != targetVolume; --left) {
+            currentVolume = smoother->step(currentVolume, targetVolume);
+            printCurrentVolume();
+            std::this_thread::sleep_for(interval);
+        }
+    }
+    // Bounded too: volumes stay in [MIN_VOLUME, MAX_VOLUME], so no transition needs more than MAX_SMOOTH_STEPS factor steps
+    assert(currentVolume >= MIN_VOLUME && currentVolume <= MAX_VOLUME && targetVolume >= MIN_VOLUME && targetVolume <= MAX_VOLUME);
+    for(int left = MAX_SMOOTH_STEPS; left > 0 && !isSettled(); --left) {
+        smoothVolumeTransition(SMOOTH_FACTOR); // Smoothly approach target volume
         printCurrentVolume();
         std::this_thread::sleep_for(std::chrono::milliseconds(200));
     }
     currentVolume = targetVolume;
-    std::cout << GREEN << "[Final Volume Reached Target: " << (int)currentVolume << "]" << RESET << "\n";
-    std::cout << CYAN << "===============================\n\n" << RESET;
+    AVC_NOTIFY(onTargetReached(currentVolume));
+}
+
+/**
+ * @brief Prints an interned event and smoothly transitions volume to target.
+ * @param id Event ID from the attached registry.
+ */
+void AdaptiveVolumeControl::printAndSmooth(EventId id) {
+    printAndSmooth(events ? events->name(id) : std::string_view());
+}
+
+/**
+ * @brief Captures the controller state into a sealed, trivially copyable snapshot.
+ * @param state Receives the snapshot.
+ */
+void AdaptiveVolumeControl::saveState(VolumeStateSnapshot& state) const {
+    state.currentVolume = currentVolume;
+    state.targetVolume = targetVolume;
+    state.speed = speed;
+    state.previousSpeed = previousSpeed;
+    state.cabinNoise = cabinNoise;
+    state.manualVolume = manualVolume;
+    state.hornDuckElapsedNs = hornDuckActive ? duration_cast<nanoseconds>(clock->now() - hornDuckStartTime).count() : 0;
+    state.mode = static_cast<std::uint8_t>(mode);
+    state.controlType = static_cast<std::uint8_t>(controlType);
+    state.flags = (reverseGear ? STATE_REVERSE_GEAR : 0) | (hornActive ? STATE_HORN_ACTIVE : 0) |
+                  (navSpeaking ? STATE_NAV_SPEAKING : 0) | (hornDuckActive ? STATE_HORN_DUCK_ACTIVE : 0);
+    state.activeModifiers = activeModifiers;
+    sealVolumeState(state);
+}
+
+/**
+ * @brief Restores a snapshot taken by saveState().
+ * @param state Snapshot to restore.
+ * @return False (and nothing changed) if the snapshot fails validation.
+ */
+bool AdaptiveVolumeControl::restoreState(const VolumeStateSnapshot& state) {
+    VolumeStateSnapshot checked;
+    if(!validateVolumeState(&state, sizeof(state), checked) || checked.mode > static_cast<std::uint8_t>(Mode::SPORTS) ||
+       checked.controlType > static_cast<std::uint8_t>(VolumeControlType::MANUAL) ||
+       !(checked.currentVolume >= MIN_VOLUME && checked.currentVolume <= MAX_VOLUME) ||
+       !(checked.targetVolume >= MIN_VOLUME && checked.targetVolume <= MAX_VOLUME))
+        return false;
+
+    currentVolume = checked.currentVolume;
+    targetVolume = checked.targetVolume;
+    speed = checked.speed;
+    previousSpeed = checked.previousSpeed;
+    cabinNoise = checked.cabinNoise;
+    manualVolume = checked.manualVolume;
+    mode = static_cast<Mode>(checked.mode);
+    controlType = static_cast<VolumeControlType>(checked.controlType);
+    reverseGear = (checked.flags & STATE_REVERSE_GEAR) != 0;
+    hornActive = (checked.flags & STATE_HORN_ACTIVE) != 0;
+    navSpeaking = (checked.flags & STATE_NAV_SPEAKING) != 0;
+    hornDuckActive = (checked.flags & STATE_HORN_DUCK_ACTIVE) != 0;
+    hornDuckStartTime = clock->now() - duration_cast<Clock::duration>(nanoseconds(checked.hornDuckElapsedNs));
+    activeModifiers = checked.activeModifiers;
+
+    // The next commit() sees the restored inputs as unchanged; the base volume is recomputed on demand
+    pending.speed = speed;
+    pending.cabinNoise = cabinNoise;
+    pending.manualVolume = manualVolume;
+    pending.mode = mode;
+    pending.controlType = controlType;
+    pending.reverseGear = reverseGear;
+    pending.hornActive = hornActive;
+    pending.navSpeaking = navSpeaking;
+    baseVolumeStale = true;
+    return true;
 }
@@ -6,8 +6,25 @@
 #ifndef ADAPTIVE_VOLUME_CONTROL_H
 #define ADAPTIVE_VOLUME_CONTROL_H
 
-#include <string>
+#include <string_view>
 #include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include "Clock.h"
+#include "EventRegistry.h"
+#include "ProfileRef.h"
+#ifdef ADAPTIVE_VOLUME_INSTRUMENTATION
+#include "Instrumentation.h"
+#endif
+
+class VolumeEventSink;
+class PolicyEngine;
+class DuckingArbiter;
+class VolumeSmoother;
+class SpeedTrend;
+struct VolumeProfileData;
+struct VolumeStateSnapshot;
 
 /**
  * @enum Mode
@@ -28,9 +45,62 @@ enum class VolumeControlType {
     MANUAL    ///< User sets a fixed volume
 };
 
+/**
+ * @struct ControlInputs
+ * @brief All inputs of one update() call, with the defaults of a new controller.
+ */
+struct ControlInputs {
+    int speed = 0;                                                  ///< Vehicle speed
+    int cabinNoise = 30;                                            ///< Cabin noise level
+    int manualVolume = 25;                                          ///< Manual volume value
+    Mode mode = Mode::COMFORT;                                      ///< Driving mode
+    VolumeControlType controlType = VolumeControlType::ADAPTIVE;    ///< Volume control type
+    bool reverseGear = false;                                       ///< Reverse gear status
+    bool hornActive = false;                                        ///< Horn active status
+    bool navSpeaking = false;                                       ///< Navigation speaking status
+};
+
+/**
+ * @enum VolumeModifier
+ * @brief Event modifiers applied on top of the base adaptive volume (bit flags).
+ */
+enum VolumeModifier : std::uint8_t {
+    MODIFIER_HORN_DUCK      = 1u << 0, ///< Horn ducking active
+    MODIFIER_NAVIGATION     = 1u << 1, ///< Navigation prompt speaking
+    MODIFIER_REVERSE        = 1u << 2, ///< Reverse gear engaged
+    MODIFIER_SUDDEN_BRAKE   = 1u << 3, ///< Speed dropped by more than 10 km/h
+    MODIFIER_SPEED_DECREASE = 1u << 4, ///< Speed dropped slightly
+    MODIFIER_EXTERNAL_DUCK  = 1u << 5  ///< Ducked by a DuckingArbiter source
+};
+
+/**
+ * @brief Counts the smoothing steps needed to close a distance to within the settle threshold.
+ * @param distance Initial distance to the target.
+ * @param factor Fraction of the remaining distance covered per step.
+ * @param threshold Distance considered settled.
+ * @return Steps of the worst case (used for MAX_SMOOTH_STEPS).
+ */
+constexpr int smoothStepBound(float distance, float factor, float threshold) {
+    int steps = 0;
+    while(distance > threshold) {
+        distance -= distance * factor;
+        ++steps;
+    }
+    return steps;
+}
+
 /**
  * @class AdaptiveVolumeControl
  * @brief Simulates an automotive audio system with adaptive and manual volume control.
+ *
+ * The class itself performs no I/O; attach a VolumeEventSink to observe events.
+ * Hot loops with a fixed mode and none of the optional components can use
+ * BasicVolumeControl / RuntimeVolumeControl instead (same results, no
+ * runtime mode branches).
+ *
+ * Building with ADAPTIVE_VOLUME_RT compiles out every sink notification,
+ * so update(), commit() and tick() contain no I/O; with the timestamped
+ * overloads they do not read the clock either (see WCET.md).
  */
 class AdaptiveVolumeControl {
 public:
@@ -41,14 +111,111 @@ public:
     static constexpr float SMOOTH_FACTOR = 0.3f;          ///< Smoothing factor for volume transitions
     static constexpr float HORN_DUCK_MULTIPLIER = 0.6f;   ///< Volume multiplier when horn is active
     static constexpr double HORN_DUCK_DURATION = 0.5;     ///< Duration (seconds) for horn ducking
+    static constexpr float NAV_DUCK_MULTIPLIER = 0.5f;    ///< Volume multiplier while navigation speaks
+    static constexpr float REVERSE_MULTIPLIER = 0.25f;    ///< Volume multiplier in reverse gear
+    static constexpr float SUDDEN_BRAKE_MULTIPLIER = 0.5f; ///< Volume multiplier on sudden brake
+    static constexpr float SPEED_DECREASE_MULTIPLIER = 0.9f; ///< Volume multiplier on small speed decrease
+    static constexpr int SUDDEN_BRAKE_THRESHOLD = 10;     ///< Speed drop (km/h) between updates treated as sudden brake
+    static constexpr float SUDDEN_BRAKE_DECELERATION = 5.0f;   ///< Deceleration (m/s^2) treated as sudden brake with a SpeedTrend
+    static constexpr float SPEED_DECREASE_DECELERATION = 0.5f; ///< Deceleration (m/s^2) treated as speed decrease with a SpeedTrend
+    static constexpr float BASE_VOLUME = 25.0f;           ///< Adaptive volume before speed/noise terms
+    static constexpr int LOW_SPEED_THRESHOLD = 30;        ///< Speeds above this get MEDIUM_SPEED_BOOST
+    static constexpr int HIGH_SPEED_THRESHOLD = 70;       ///< Speeds above this get HIGH_SPEED_BOOST
+    static constexpr int LOW_SPEED_BOOST = 5;             ///< Boost for moving below LOW_SPEED_THRESHOLD
+    static constexpr int MEDIUM_SPEED_BOOST = 10;         ///< Boost between the two thresholds
+    static constexpr int HIGH_SPEED_BOOST = 15;           ///< Boost above HIGH_SPEED_THRESHOLD
+    static constexpr float NOISE_SLOPE = 0.2f;            ///< Volume added per unit of cabin noise
+    static constexpr float ECO_MULTIPLIER = 0.8f;         ///< Volume multiplier in Eco mode
+    static constexpr float SPORTS_MULTIPLIER = 1.2f;      ///< Volume multiplier in Sports mode
+    static constexpr double SMOOTH_INTERVAL = 0.2;        ///< Time (seconds) over which SMOOTH_FACTOR applies once
+    static constexpr float SETTLE_THRESHOLD = 0.5f;       ///< Distance to target considered settled
+    static constexpr float DEFAULT_SAMPLE_RATE = 48000.0f; ///< Default sample rate for advance()
+    static constexpr int MAX_SMOOTH_STEPS =
+        smoothStepBound(MAX_VOLUME - MIN_VOLUME, SMOOTH_FACTOR, SETTLE_THRESHOLD); ///< Built-in smoothing steps of the largest transition
 
     /**
      * @brief Constructor initializes volume control state.
+     * @param clock Time source for timed events (defaults to the steady clock).
      */
-    AdaptiveVolumeControl();
+    explicit AdaptiveVolumeControl(Clock& clock = SteadyClock::instance());
+
+    /**
+     * @brief Replaces the time source used for horn ducking.
+     * @param newClock Clock to read timestamps from.
+     */
+    void setClock(Clock& newClock) { clock = &newClock; }
+
+    /**
+     * @brief Attaches an observer for events and volume steps.
+     *
+     * Ignored in ADAPTIVE_VOLUME_RT builds, which never notify a sink.
+     * @param newSink Sink to notify, or nullptr for a silent controller.
+     */
+    void setEventSink(VolumeEventSink* newSink) {
+#ifndef ADAPTIVE_VOLUME_RT
+        sink = newSink;
+#else
+        (void)newSink;
+#endif
+    }
+
+    VolumeEventSink* getEventSink() const { return sink; }              ///< @return Attached sink (nullptr = silent)
+
+    /**
+     * @brief Attaches the registry resolving the IDs passed to printAndSmooth(EventId).
+     * @param registry Interned event names, or nullptr (IDs then print as empty names).
+     */
+    void setEventRegistry(const EventRegistry* registry) { events = registry; }
+
+    /**
+     * @brief Evaluates the adaptive policy from a profile instead of the built-in constants.
+     *
+     * The engine's generation is checked at every commit, so hot-swapped
+     * profiles apply from the next frame. The controller holds a reference to
+     * the profile it uses, so PolicyEngine::collectRetired() cannot free it
+     * until the controller has moved on to a newer one.
+     * @param engine Policy engine, or nullptr for the built-in policy.
+     */
+    void setPolicyEngine(const PolicyEngine* engine);
+
+    /**
+     * @brief Attaches an arbiter for additional duck sources (chimes, calls, ADAS, voice assistant).
+     *
+     * Its gain is evaluated at every commit and scales the target in both
+     * control modes; the built-in horn/navigation/reverse modifiers still apply.
+     * @param arbiter Arbiter driven by the same thread, or nullptr to detach.
+     */
+    void setDuckingArbiter(DuckingArbiter* arbiter) { ducking = arbiter; }
+
+    /**
+     * @brief Replaces the built-in linear smoothing with a VolumeSmoother curve.
+     *
+     * The smoother's tick interval is fixed here: tick() accumulates dt and
+     * runs one step per whole interval (at most maxTicks() per call), so it
+     * never reconfigures or allocates. printAndSmooth() runs at most
+     * maxTicks() steps at that interval instead of polling isSettled() every 200 ms.
+     * @param newSmoother Smoother owned by the caller, or nullptr for the built-in smoothing.
+     */
+    void setVolumeSmoother(VolumeSmoother* newSmoother) { smoother = newSmoother; smootherTime = 0.0; }
+
+    /**
+     * @brief Keys sudden-brake and speed-decrease detection on a fitted deceleration.
+     *
+     * Every commit adds the speed, stamped with the controller's clock, to the
+     * trend; the modifiers then fire above SUDDEN_BRAKE_DECELERATION and
+     * SPEED_DECREASE_DECELERATION regardless of the update rate, instead of
+     * comparing two consecutive speeds. Repeated frames are no longer
+     * skipped while a trend is attached, since the estimate evolves.
+     * @param trend Trend fed only by this controller, or nullptr for the per-update speed difference.
+     */
+    void setSpeedTrend(SpeedTrend* trend) { speedTrend = trend; }
 
     /**
      * @brief Updates internal state and recalculates volume based on new inputs.
+     *
+     * Frames identical to the previous one return immediately with the cached
+     * target (no clock read, no sink notifications) unless a horn-duck hold is
+     * still running out.
      * @param newSpeed Current vehicle speed.
      * @param newNoise Current cabin noise level.
      * @param newReverseGear Reverse gear status.
@@ -62,11 +229,150 @@ public:
                 bool newNavSpeaking, Mode newMode,
                 VolumeControlType newControlType, int newManualVolume);
 
+    /**
+     * @brief Updates internal state from a packed set of inputs.
+     * @param inputs New inputs (e.g. a snapshot from an InputMailbox).
+     */
+    void update(ControlInputs inputs) {
+        update(inputs.speed, inputs.cabinNoise, inputs.reverseGear, inputs.hornActive, inputs.navSpeaking,
+               inputs.mode, inputs.controlType, inputs.manualVolume);
+    }
+
+    /**
+     * @brief Updates internal state from a packed set of inputs stamped by the caller.
+     *
+     * Same as update(inputs), but horn ducking, the speed trend and the
+     * ducking arbiter use now instead of reading the clock, so the call makes
+     * no clock read (no syscall on any platform). Timestamps must not go
+     * backwards.
+     * @param inputs New inputs.
+     * @param now Frame time.
+     */
+    void update(ControlInputs inputs, Clock::time_point now);
+
+    /**
+     * @name Per-signal setters
+     * Stage one input for the next commit(); signals that are not set keep
+     * their previous value, so callers only send what changed.
+     * @{
+     */
+    void setSpeed(int value) { pending.speed = value; }                              ///< @param value Vehicle speed
+    void setCabinNoise(int value) { pending.cabinNoise = value; }                    ///< @param value Cabin noise level
+    void setReverseGear(bool value) { pending.reverseGear = value; }                 ///< @param value Reverse gear status
+    void setHorn(bool value) { pending.hornActive = value; }                         ///< @param value Horn active status
+    void setNavSpeaking(bool value) { pending.navSpeaking = value; }                 ///< @param value Navigation speaking status
+    void setMode(Mode value) { pending.mode = value; }                               ///< @param value Driving mode
+    void setControlType(VolumeControlType value) { pending.controlType = value; }    ///< @param value Volume control type
+    void setManualVolume(int value) { pending.manualVolume = value; }                ///< @param value Manual volume (applied in manual mode)
+    /** @} */
+
+    /**
+     * @brief Applies the staged inputs as one control frame.
+     *
+     * Equivalent to update() with every signal, but only the affected parts
+     * are recomputed: the speed/noise/mode base volume is cached, and the
+     * clock is only read while the horn duck is involved.
+     */
+    void commit();
+
+    /**
+     * @brief Applies the staged inputs as one control frame at a caller-supplied time.
+     *
+     * Like commit(), without reading the clock.
+     * @param now Frame time.
+     */
+    void commit(Clock::time_point now);
+
+    /**
+     * @brief Captures the controller state into a sealed, trivially copyable snapshot.
+     *
+     * Cheap enough to call on every change (no allocation, one CRC over 44
+     * bytes); the clock is only read while a horn duck is running.
+     * @param state Receives the snapshot.
+     */
+    void saveState(VolumeStateSnapshot& state) const;
+
+    /**
+     * @brief Restores a snapshot taken by saveState(), e.g. after an ECU wake.
+     *
+     * A running horn-duck hold continues from its stored elapsed time on this
+     * controller's clock. Attached sinks, engines, arbiters and smoothers are
+     * kept; the staged inputs are set to the restored ones.
+     * @param state Snapshot to restore.
+     * @return False (and nothing changed) if the snapshot fails validation.
+     */
+    bool restoreState(const VolumeStateSnapshot& state);
+
     /**
      * @brief Prints event info and smoothly transitions volume to target.
+     *
+     * Blocking demo path: sleeps between steps. The built-in smoothing runs
+     * at most MAX_SMOOTH_STEPS steps, a VolumeSmoother at most its maxTicks().
      * @param eventName Name of the event to display.
      */
-    void printAndSmooth(const std::string& eventName);
+    void printAndSmooth(std::string_view eventName);
+
+    /**
+     * @brief Prints an interned event and smoothly transitions volume to target.
+     *
+     * The name is looked up in the attached EventRegistry, so the event path
+     * neither copies nor allocates a string.
+     * @param id Event ID from the registry.
+     */
+    void printAndSmooth(EventId id);
+
+    /**
+     * @brief Advances the volume smoothing by one step covering elapsed time.
+     *
+     * Non-blocking replacement for the printAndSmooth() loop; the caller's
+     * scheduler decides how often to call it. The smoothing coefficient is
+     * derived from dt, so convergence speed does not depend on the tick rate.
+     * Snaps to the target once within SETTLE_THRESHOLD. A dt <= 0 leaves
+     * the volume unchanged.
+     * @param dt Elapsed time in seconds since the previous tick.
+     */
+    void tick(double dt);
+
+    /**
+     * @brief Advances the volume smoothing by a number of audio samples.
+     * @param nSamples Number of samples elapsed at the configured sample rate.
+     */
+    void advance(std::size_t nSamples) { tick(static_cast<double>(nSamples) / sampleRate); }
+
+    /**
+     * @brief Applies the smoothed volume to an interleaved PCM block.
+     *
+     * Advances the smoothing by n samples and ramps the gain per sample from the
+     * volume at the end of the previous block to the new current volume, so
+     * there are no zipper artifacts. Gain is currentVolume / MAX_VOLUME.
+     * @param samples Interleaved samples, modified in place.
+     * @param n Number of frames (samples per channel).
+     * @param channels Number of interleaved channels.
+     */
+    void processBlock(float* samples, std::size_t n, int channels);
+
+    /**
+     * @brief Evaluates the target the current state would have at another cabin noise level.
+     *
+     * Same speed, mode, control type, event modifiers and external duck gain
+     * as the last commit; only the noise term differs. Used by MultibandGain
+     * to derive per-band targets from band noise levels.
+     * @param noise Cabin noise level to evaluate.
+     * @return Target volume (the manual volume in manual mode).
+     */
+    float targetVolumeAtNoise(int noise) const;
+
+    /**
+     * @brief Sets the sample rate used by advance().
+     * @param newSampleRate Sample rate in Hz.
+     */
+    void setSampleRate(float newSampleRate) { sampleRate = newSampleRate; }
+
+    /**
+     * @brief Checks whether the current volume has converged to the target.
+     * @return True if within SETTLE_THRESHOLD of the target volume.
+     */
+    bool isSettled() const { return std::abs(currentVolume - targetVolume) <= SETTLE_THRESHOLD; }
 
     /**
      * @brief Gets the current volume.
@@ -80,6 +386,24 @@ public:
      */
     float getTargetVolume() const { return targetVolume; }
 
+    int getSpeed() const { return speed; }                               ///< @return Current speed
+    int getCabinNoise() const { return cabinNoise; }                     ///< @return Current cabin noise
+    bool isReverseGear() const { return reverseGear; }                   ///< @return Reverse gear status
+    bool isHornActive() const { return hornActive; }                     ///< @return Horn active status
+    bool isNavSpeaking() const { return navSpeaking; }                   ///< @return Navigation speaking status
+    Mode getMode() const { return mode; }                                ///< @return Current driving mode
+    VolumeControlType getControlType() const { return controlType; }     ///< @return Volume control type
+    int getManualVolume() const { return manualVolume; }                 ///< @return Manual volume value
+    std::uint8_t getActiveModifiers() const { return activeModifiers; }  ///< @return VolumeModifier bits applied to the target
+
+#ifdef ADAPTIVE_VOLUME_INSTRUMENTATION
+    /**
+     * @brief Gets the counters and call trace (drain the trace from one diagnostics thread).
+     * @return Instrumentation of this controller.
+     */
+    VolumeInstrumentation& getInstrumentation() { return instrumentation; }
+#endif
+
 protected:
     int speed;                                  ///< Current speed
     int previousSpeed;                          ///< Previous speed
@@ -95,8 +419,41 @@ protected:
     float targetVolume;                         ///< Target volume
     float currentVolume;                        ///< Current volume
 
-    std::chrono::system_clock::time_point hornDuckStartTime; ///< Horn ducking start time
+    Clock* clock;                               ///< Time source for timed events
+    Clock::time_point frameTime;                ///< Caller-supplied time of the frame being committed
+    bool hasFrameTime;                          ///< True while commit(now) runs: now() returns frameTime
     bool hornDuckActive;                        ///< Horn ducking active flag
+    Clock::time_point hornDuckStartTime;        ///< Horn ducking start time
+
+    std::uint8_t activeModifiers;               ///< VolumeModifier bits applied to the target
+    VolumeEventSink* sink;                      ///< Optional observer (nullptr = silent)
+    const EventRegistry* events;                ///< Optional event-name registry for printAndSmooth(EventId)
+
+    const PolicyEngine* policy;                 ///< Optional policy engine (nullptr = built-in constants)
+    ProfileRef profile;                         ///< Profile in use, kept alive until the next swap is picked up
+    std::uint64_t profileGeneration;            ///< PolicyEngine generation of profile
+    DuckingArbiter* ducking;                    ///< Optional arbiter for external duck sources
+    VolumeSmoother* smoother;                   ///< Optional smoothing curve (nullptr = linear SMOOTH_FACTOR steps)
+    double smootherTime;                        ///< Elapsed time in seconds not yet stepped by the smoother
+    SpeedTrend* speedTrend;                     ///< Optional deceleration estimate (nullptr = previousSpeed difference)
+
+    ControlInputs pending;                      ///< Inputs staged by the setters for the next commit()
+    float cachedBaseVolume;                     ///< Adaptive volume before event modifiers
+    float externalDuckGain;                     ///< DuckingArbiter gain applied at the last commit (1 = none)
+    bool baseVolumeStale;                       ///< Set when speed, cabinNoise or mode change
+
+    float sampleRate;                           ///< Sample rate for advance()
+    double tickDt;                              ///< Elapsed time the cached tick factor was computed for
+    float tickFactor;                           ///< Cached smoothing factor for tickDt
+#ifdef ADAPTIVE_VOLUME_INSTRUMENTATION
+    VolumeInstrumentation instrumentation;      ///< Counters and call trace
+#endif
+
+    /**
+     * @brief Gets the time of the frame being committed.
+     * @return The commit(now) timestamp, or the clock reading outside of it.
+     */
+    Clock::time_point now() const { return hasFrameTime ? frameTime : clock->now(); }
 
     /**
      * @brief Calculates the target volume based on current state.
@@ -105,17 +462,18 @@ protected:
 
     /**
      * @brief Smoothly transitions current volume towards target volume.
+     * @param factor Fraction of the remaining distance to cover in this step.
      */
-    virtual void smoothVolumeTransition();
+    void smoothVolumeTransition(float factor);
 
     /**
-     * @brief Prints event header information.
+     * @brief Reports event header information to the attached sink.
      * @param eventName Name of the event.
      */
-    void printEventHeader(const std::string& eventName);
+    void printEventHeader(std::string_view eventName);
 
     /**
-     * @brief Prints the current volume value.
+     * @brief Reports the current volume value to the attached sink.
      */
     void printCurrentVolume();
 
@@ -131,6 +489,21 @@ protected:
      */
     void handleNavigationDucking(bool newNavSpeaking);
 
+    /**
+     * @brief Computes the speed, noise and mode terms of the built-in policy.
+     * @param speed Vehicle speed.
+     * @param noise Cabin noise level.
+     * @param mode Driving mode.
+     * @return Adaptive volume before event modifiers.
+     */
+    static float adaptiveBaseVolume(int speed, int noise, Mode mode);
+
+    /**
+     * @brief Determines which event modifiers apply in the current state.
+     * @return VolumeModifier bits.
+     */
+    std::uint8_t modifierMask() const;
+
     /**
      * @brief Applies event-based volume modifiers.
      * @param baseVolume Base volume before modifiers.
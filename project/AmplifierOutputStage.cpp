@@ -0,0 +1,71 @@
+/**
+ * @file AmplifierOutputStage.cpp
+ * @brief Implements the coalescing, rate-limited amplifier output stage.
+ */
+
+#include "AmplifierOutputStage.h"
+#include <cmath>
+
+using namespace std::chrono;
+
+/**
+ * @brief Constructor binds the bus.
+ * @param bus Amplifier transport, owned by the caller.
+ * @param config Stage parameters.
+ */
+AmplifierOutputStage::AmplifierOutputStage(AmplifierBus& bus, const AmplifierOutputConfig& config)
+    : bus(&bus), config(config), minInterval(Clock::duration::zero()), synced(false), attempted(false), written(0.0f), lastWrite(),
+      volumeWrites(0), rampWrites(0), coalesced(0), busErrors(0) {
+    if(config.maxWriteRate > 0.0f) minInterval = duration_cast<Clock::duration>(duration<double>(1.0 / config.maxWriteRate));
+}
+
+/**
+ * @brief Computes how long the built-in smoothing takes to settle over a volume distance.
+ * @param from Start volume.
+ * @param to Target volume.
+ * @return Seconds until within SETTLE_THRESHOLD (0 if already there).
+ */
+double AmplifierOutputStage::settleTime(float from, float to) {
+    using AVC = AdaptiveVolumeControl;
+    double distance = std::abs(static_cast<double>(to) - from);
+    if(distance <= AVC::SETTLE_THRESHOLD) return 0.0;
+    // The remaining distance shrinks by (1 - SMOOTH_FACTOR) per SMOOTH_INTERVAL
+    return AVC::SMOOTH_INTERVAL * std::log(AVC::SETTLE_THRESHOLD / distance) / std::log(1.0 - AVC::SMOOTH_FACTOR);
+}
+
+/**
+ * @brief Writes whatever the amplifier needs to follow the controller, within the rate limit.
+ * @param currentVolume Smoothed volume.
+ * @param targetVolume Target volume.
+ * @param now Current time.
+ */
+void AmplifierOutputStage::update(float currentVolume, float targetVolume, Clock::time_point now) {
+    // A fresh amplifier gets the absolute level first; ramps follow from there
+    bool ramp = config.hardwareRamp && synced;
+    float value = ramp ? targetVolume : currentVolume;
+
+    // Sub-threshold changes wait for the controller to settle, then go out exactly
+    bool settled = currentVolume == targetVolume;
+    bool needed = !synced || std::abs(value - written) >= config.threshold || (settled && value != written);
+    if(!needed) {
+        if(value != written) ++coalesced;
+        return;
+    }
+    if(attempted && now - lastWrite < minInterval) {
+        ++coalesced;
+        return;
+    }
+
+    attempted = true;
+    lastWrite = now;
+    double seconds = config.rampTime > 0.0 ? config.rampTime : settleTime(currentVolume, targetVolume);
+    bool ok = ramp ? bus->writeRamp(value, seconds) : bus->writeVolume(value);
+    if(!ok) {
+        ++busErrors;
+        return;
+    }
+    if(ramp) ++rampWrites;
+    else ++volumeWrites;
+    written = value;
+    synced = true;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file AmplifierOutputStage.h
+ * @brief Defines the AmplifierOutputStage turning volume changes into a bounded stream of amplifier bus writes.
+ */
+
+#ifndef AMPLIFIER_OUTPUT_STAGE_H
+#define AMPLIFIER_OUTPUT_STAGE_H
+
+#include "AdaptiveVolumeControl.h"
+#include "Clock.h"
+#include <cstdint>
+
+/**
+ * @class AmplifierBus
+ * @brief Transport to the external amplifier (I2C, A2B, ...), implemented by the platform.
+ */
+class AmplifierBus {
+public:
+    virtual ~AmplifierBus() = default;
+
+    /**
+     * @brief Writes an absolute volume register.
+     * @param volume Volume in controller units (0..MAX_VOLUME).
+     * @return False if the transfer failed (the stage retries it).
+     */
+    virtual bool writeVolume(float volume) = 0;
+
+    /**
+     * @brief Starts a hardware ramp from the amplifier's current level.
+     *
+     * Only called when AmplifierOutputConfig::hardwareRamp is set; the default
+     * reports failure so the stage keeps retrying instead of dropping the ramp.
+     * @param targetVolume Ramp endpoint in controller units.
+     * @param seconds Ramp duration.
+     * @return False if the transfer failed (the stage retries it).
+     */
+    virtual bool writeRamp(float targetVolume, double seconds) { (void)targetVolume; (void)seconds; return false; }
+};
+
+/**
+ * @struct AmplifierOutputConfig
+ * @brief Parameters of the output stage.
+ */
+struct AmplifierOutputConfig {
+    bool hardwareRamp = false;      ///< Send ramp endpoints and durations instead of intermediate volumes
+    float threshold = 1.0f;         ///< Changes smaller than this are coalesced until the volume settles
+    float maxWriteRate = 20.0f;     ///< Bus writes per second at most (0 = unlimited)
+    double rampTime = 0.0;          ///< Fixed hardware ramp duration in seconds (0 = settle time of the built-in smoothing)
+};
+
+/**
+ * @class AmplifierOutputStage
+ * @brief Forwards the controller volume to the amplifier with as few bus writes as possible.
+ *
+ * Call update() after each tick(). Without hardware ramps the current
+ * volume is written once it has moved by threshold since the last write;
+ * with them only the target is sent, as a ramp of the remaining smoothing
+ * time, whenever it moves by threshold. Smaller changes are coalesced,
+ * and the exact value is always written once the controller settles, so
+ * the amplifier ends on the controller's volume. Writes are spaced at
+ * least 1 / maxWriteRate apart; a change arriving earlier waits and only
+ * its latest value is sent. Failed writes are retried on the next update.
+ * Used from the thread driving the controller; no allocation.
+ */
+class AmplifierOutputStage {
+public:
+    /**
+     * @brief Constructor binds the bus.
+     * @param bus Amplifier transport, owned by the caller.
+     * @param config Stage parameters.
+     */
+    explicit AmplifierOutputStage(AmplifierBus& bus, const AmplifierOutputConfig& config = AmplifierOutputConfig{});
+
+    /**
+     * @brief Writes whatever the amplifier needs to follow the controller, within the rate limit.
+     * @param currentVolume Smoothed volume.
+     * @param targetVolume Target volume.
+     * @param now Current time.
+     */
+    void update(float currentVolume, float targetVolume, Clock::time_point now);
+
+    /**
+     * @brief Writes whatever the amplifier needs to follow the controller, within the rate limit.
+     * @param avc Controller to follow.
+     * @param now Current time.
+     */
+    void update(const AdaptiveVolumeControl& avc, Clock::time_point now) {
+        update(avc.getCurrentVolume(), avc.getTargetVolume(), now);
+    }
+
+    /**
+     * @brief Forgets what the amplifier holds, so the next permitted update() writes the absolute volume.
+     *
+     * Call after the amplifier was reset or powered up.
+     */
+    void resync() { synced = false; }
+
+    /**
+     * @brief Computes how long the built-in smoothing takes to settle over a volume distance.
+     * @param from Start volume.
+     * @param to Target volume.
+     * @return Seconds until within SETTLE_THRESHOLD (0 if already there).
+     */
+    static double settleTime(float from, float to);
+
+    std::uint32_t getVolumeWrites() const { return volumeWrites; }   ///< @return writeVolume() transfers that succeeded
+    std::uint32_t getRampWrites() const { return rampWrites; }       ///< @return writeRamp() transfers that succeeded
+    std::uint32_t getCoalesced() const { return coalesced; }         ///< @return Updates that changed the volume without a write
+    std::uint32_t getBusErrors() const { return busErrors; }         ///< @return Failed transfers
+    float getWrittenVolume() const { return written; }               ///< @return Last volume (or ramp endpoint) the amplifier accepted
+
+private:
+    AmplifierBus* bus;                  ///< Amplifier transport
+    AmplifierOutputConfig config;       ///< Stage parameters
+    Clock::duration minInterval;        ///< Minimum spacing of bus writes
+    bool synced;                        ///< False until a first write succeeded (or after resync())
+    bool attempted;                     ///< A write was attempted, so the rate limit applies
+    float written;                      ///< Value last accepted by the amplifier
+    Clock::time_point lastWrite;        ///< Time of the last bus write attempt
+    std::uint32_t volumeWrites;         ///< Successful writeVolume() calls
+    std::uint32_t rampWrites;           ///< Successful writeRamp() calls
+    std::uint32_t coalesced;            ///< Updates that changed the volume without a write
+    std::uint32_t busErrors;            ///< Failed transfers
+};
+
+#endif // AMPLIFIER_OUTPUT_STAGE_H
@@ -0,0 +1,233 @@
+/**
+ * @file AsyncDriver.cpp
+ * @brief Implements the coroutine executor, its timer wheel and the awaitable controller steps.
+ */
+
+#include "AsyncDriver.h"
+
+#if defined(__cpp_impl_coroutine)
+
+#include "VolumeEventSink.h"
+#include <stdexcept>
+#include <thread>
+
+using namespace std::chrono;
+
+/**
+ * @brief Resumes the continuation, or retires a spawned task.
+ * @param handle Finishing task.
+ * @return Coroutine to run next.
+ */
+std::coroutine_handle<> Task::promise_type::FinalAwaiter::await_suspend(
+    std::coroutine_handle<promise_type> handle) noexcept {
+    promise_type& promise = handle.promise();
+    if(promise.continuation) return promise.continuation;
+    if(promise.owner) promise.owner->retire(handle);
+    return std::noop_coroutine();
+}
+
+/**
+ * @brief Constructor for real time: run() sleeps until the next deadline.
+ * @param clock Time source.
+ * @param resolution Timer wheel tick.
+ */
+AsyncExecutor::AsyncExecutor(Clock& clock, Clock::duration resolution)
+    : clock(clock), virtualClock(nullptr), resolution(resolution), epoch(clock.now()), currentTick(0),
+      wheel(), armedTimers(0) {}
+
+/**
+ * @brief Constructor for virtual time: run() advances the clock to the next deadline.
+ * @param clock Simulated clock.
+ * @param resolution Timer wheel tick.
+ */
+AsyncExecutor::AsyncExecutor(ManualClock& clock, Clock::duration resolution)
+    : AsyncExecutor(static_cast<Clock&>(clock), resolution) {
+    virtualClock = &clock;
+}
+
+/**
+ * @brief Destructor destroys unfinished spawned tasks.
+ */
+AsyncExecutor::~AsyncExecutor() {
+    for(std::coroutine_handle<Task::promise_type> handle : spawned) handle.destroy();
+}
+
+/**
+ * @brief Takes ownership of a task and queues its start.
+ * @param task Task to run.
+ */
+void AsyncExecutor::spawn(Task task) {
+    std::coroutine_handle<Task::promise_type> handle = task.handle;
+    task.handle = nullptr;
+    handle.promise().owner = this;
+    handle.promise().slot = spawned.size();
+    spawned.push_back(handle);
+    ready.push_back(handle);
+}
+
+/**
+ * @brief Records the completion of a spawned task and destroys it.
+ * @param handle Finished task.
+ */
+void AsyncExecutor::retire(std::coroutine_handle<Task::promise_type> handle) {
+    Task::promise_type& promise = handle.promise();
+    if(promise.error && !firstError) firstError = promise.error;
+
+    // Swap-remove from the spawned list
+    std::size_t slot = promise.slot;
+    spawned[slot] = spawned.back();
+    spawned[slot].promise().slot = slot;
+    spawned.pop_back();
+    handle.destroy();
+}
+
+/**
+ * @brief Inserts a timer into the wheel (or the ready queue if due).
+ * @param timer Timer living in the suspended coroutine frame.
+ */
+void AsyncExecutor::arm(SleepAwaiter& timer) {
+    // Round up, so a timer never fires before its deadline
+    Clock::duration offset = timer.deadline - epoch;
+    timer.deadlineTick = static_cast<std::uint64_t>((offset + resolution - Clock::duration(1)) / resolution);
+    if(timer.deadlineTick <= currentTick) {
+        ready.push_back(timer.handle);
+        return;
+    }
+
+    Bucket& bucket = wheel[timer.deadlineTick % WHEEL_SLOTS];
+    timer.next = nullptr;
+    if(bucket.tail) bucket.tail->next = &timer;
+    else bucket.head = &timer;
+    bucket.tail = &timer;
+    ++armedTimers;
+}
+
+/**
+ * @brief Moves every timer due at or before a tick to the ready queue.
+ * @param tick Wheel tick reached by the clock.
+ */
+void AsyncExecutor::expire(std::uint64_t tick) {
+    if(tick <= currentTick) return;
+    // Visit each bucket at most once, even after a long jump
+    std::uint64_t steps = tick - currentTick < WHEEL_SLOTS ? tick - currentTick : WHEEL_SLOTS;
+    for(std::uint64_t step = 1; step <= steps && armedTimers; ++step) {
+        Bucket& bucket = wheel[(currentTick + step) % WHEEL_SLOTS];
+        SleepAwaiter* keep = nullptr;
+        SleepAwaiter* keepTail = nullptr;
+        for(SleepAwaiter* timer = bucket.head; timer;) {
+            SleepAwaiter* next = timer->next;
+            if(timer->deadlineTick <= tick) {
+                ready.push_back(timer->handle);
+                --armedTimers;
+            } else {
+                // Due in a later rotation of the wheel
+                timer->next = nullptr;
+                if(keepTail) keepTail->next = timer;
+                else keep = timer;
+                keepTail = timer;
+            }
+            timer = next;
+        }
+        bucket.head = keep;
+        bucket.tail = keepTail;
+    }
+    currentTick = tick;
+}
+
+/**
+ * @brief Finds the earliest armed deadline.
+ * @return Wheel tick of the earliest timer.
+ */
+std::uint64_t AsyncExecutor::nextDeadlineTick() const {
+    // A timer due within one rotation is found in the first non-empty bucket that holds it
+    std::uint64_t rotationEnd = currentTick + WHEEL_SLOTS;
+    for(std::uint64_t tick = currentTick + 1; tick <= rotationEnd; ++tick) {
+        for(const SleepAwaiter* timer = wheel[tick % WHEEL_SLOTS].head; timer; timer = timer->next)
+            if(timer->deadlineTick == tick) return tick;
+    }
+
+    std::uint64_t earliest = ~std::uint64_t(0);
+    for(const Bucket& bucket : wheel)
+        for(const SleepAwaiter* timer = bucket.head; timer; timer = timer->next)
+            if(timer->deadlineTick < earliest) earliest = timer->deadlineTick;
+    return earliest;
+}
+
+/**
+ * @brief Runs until every spawned task has finished.
+ */
+void AsyncExecutor::run() {
+    while(!spawned.empty()) {
+        while(!ready.empty()) {
+            std::coroutine_handle<> handle = ready.front();
+            ready.pop_front();
+            handle.resume();
+            if(firstError) {
+                std::exception_ptr error = firstError;
+                firstError = nullptr;
+                std::rethrow_exception(error);
+            }
+        }
+        if(spawned.empty()) break;
+        if(armedTimers == 0) throw std::logic_error("AsyncExecutor: tasks suspended without a timer");
+
+        Clock::time_point deadline = epoch + resolution * static_cast<Clock::duration::rep>(nextDeadlineTick());
+        if(virtualClock) {
+            if(virtualClock->now() < deadline) virtualClock->set(deadline);
+        } else {
+            std::this_thread::sleep_for(deadline - clock.now());
+        }
+        expire(tickAt(clock.now()));
+    }
+}
+
+/**
+ * @brief Smooths the volume to the target with one tick every step.
+ * @param executor Executor running the calling coroutine.
+ * @param avc Controller on the executor's clock.
+ * @param step Time per smoothing tick.
+ * @return Task completing once the controller has settled.
+ */
+Task smoothToTarget(AsyncExecutor& executor, AdaptiveVolumeControl& avc, Clock::duration step) {
+    double dt = duration<double>(step).count();
+    while(!avc.isSettled() || avc.getCurrentVolume() != avc.getTargetVolume()) {
+        co_await executor.sleepFor(step);
+        avc.tick(dt);
+    }
+}
+
+/**
+ * @brief Waits out a running horn-duck hold and ramps back up.
+ * @param executor Executor running the calling coroutine.
+ * @param avc Controller on the executor's clock.
+ * @param step Poll and smoothing interval (the duck releases within one step after expiry).
+ * @return Task completing once the duck has released and the volume settled.
+ */
+Task awaitDuckHold(AsyncExecutor& executor, AdaptiveVolumeControl& avc, Clock::duration step) {
+    while((avc.getActiveModifiers() & MODIFIER_HORN_DUCK) && !avc.isHornActive()) {
+        co_await executor.sleepFor(step);
+        avc.commit(); // re-evaluate the hold with the staged (unchanged) inputs
+        avc.tick(duration<double>(step).count());
+    }
+    co_await smoothToTarget(executor, avc, step);
+}
+
+/**
+ * @brief Applies one event and smooths to its target, reporting to the controller's sink.
+ * @param executor Executor running the calling coroutine.
+ * @param avc Controller on the executor's clock.
+ * @param inputs Inputs of the event.
+ * @param eventName Name reported to the sink.
+ * @param step Smoothing tick interval.
+ * @return Task completing once the new target is reached.
+ */
+Task runEvent(AsyncExecutor& executor, AdaptiveVolumeControl& avc, ControlInputs inputs,
+              std::string_view eventName, Clock::duration step) {
+    avc.update(inputs);
+    VolumeEventSink* sink = avc.getEventSink();
+    if(sink) sink->onEventStart(eventName, avc);
+    co_await smoothToTarget(executor, avc, step);
+    if(sink) sink->onTargetReached(avc.getCurrentVolume());
+}
+
+#endif // __cpp_impl_coroutine
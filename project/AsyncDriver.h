@@ -0,0 +1,302 @@
+/**
+ * @file AsyncDriver.h
+ * @brief Defines a single-threaded C++20 coroutine executor and awaitable controller steps.
+ *
+ * Each simulated vehicle is a coroutine (Task) that awaits its events,
+ * smoothing ramps and duck holds instead of sleeping on an OS thread, so
+ * hundreds of AdaptiveVolumeControl instances share one thread. Timers live
+ * in a hashed timer wheel. The executor either sleeps until the next
+ * deadline (SteadyClock) or jumps a ManualClock straight to it, which runs
+ * a whole bench script in virtual time.
+ *
+ * Requires C++20 coroutines; the header is empty otherwise.
+ */
+
+#ifndef ASYNC_DRIVER_H
+#define ASYNC_DRIVER_H
+
+#if defined(__cpp_impl_coroutine)
+
+#include "AdaptiveVolumeControl.h"
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <string_view>
+#include <vector>
+
+class AsyncExecutor;
+
+/**
+ * @class Task
+ * @brief Lazily started coroutine returning nothing; co_await it or hand it to AsyncExecutor::spawn().
+ *
+ * Completion resumes the awaiting coroutine directly (symmetric transfer),
+ * so nested awaits do not grow the native stack. An exception propagates
+ * to the awaiting coroutine, or out of AsyncExecutor::run() for a spawned
+ * task.
+ */
+class Task {
+public:
+    /**
+     * @struct promise_type
+     * @brief Coroutine promise holding the continuation and any exception.
+     */
+    struct promise_type {
+        std::coroutine_handle<> continuation;   ///< Coroutine awaiting this task
+        AsyncExecutor* owner = nullptr;         ///< Executor of a spawned task
+        std::exception_ptr error;               ///< Exception thrown by the body
+        std::size_t slot = 0;                   ///< Index in the executor's spawned list
+
+        /**
+         * @struct FinalAwaiter
+         * @brief Resumes the continuation, or retires a spawned task.
+         */
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+            void await_resume() const noexcept {}
+        };
+
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    Task(Task&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    Task& operator=(Task&& other) noexcept {
+        if(this != &other) {
+            if(handle) handle.destroy();
+            handle = other.handle;
+            other.handle = nullptr;
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { if(handle) handle.destroy(); }
+
+    bool await_ready() const noexcept { return false; }
+
+    /**
+     * @brief Starts the task; it resumes the awaiting coroutine when done.
+     * @param awaiting Awaiting coroutine.
+     * @return Handle to run next.
+     */
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    /**
+     * @brief Rethrows an exception thrown by the task body.
+     */
+    void await_resume() {
+        if(handle.promise().error) std::rethrow_exception(handle.promise().error);
+    }
+
+private:
+    friend class AsyncExecutor;
+    std::coroutine_handle<promise_type> handle; ///< Owned coroutine
+
+    explicit Task(std::coroutine_handle<promise_type> h) : handle(h) {}
+};
+
+/**
+ * @class AsyncExecutor
+ * @brief Single-threaded run queue with a hashed timer wheel.
+ *
+ * Deadlines are rounded up to the wheel resolution and hashed into
+ * WHEEL_SLOTS buckets, so arming a timer and expiring a tick are O(1) in
+ * the number of timers. Not thread safe: spawn, await and run from one
+ * thread. Controllers driven by the executor should use the same clock.
+ */
+class AsyncExecutor {
+public:
+    static constexpr std::size_t WHEEL_SLOTS = 256; ///< Timer wheel buckets
+
+    /**
+     * @struct SleepAwaiter
+     * @brief Suspends the awaiting coroutine until a deadline.
+     */
+    struct SleepAwaiter {
+        AsyncExecutor& executor;        ///< Executor owning the wheel
+        Clock::time_point deadline;     ///< Wake-up time
+        std::uint64_t deadlineTick = 0; ///< Wheel tick of the deadline
+        std::coroutine_handle<> handle{}; ///< Suspended coroutine
+        SleepAwaiter* next = nullptr;   ///< Next timer in the same bucket
+
+        bool await_ready() const { return deadline <= executor.clock.now(); }
+        void await_suspend(std::coroutine_handle<> awaiting) { handle = awaiting; executor.arm(*this); }
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @struct YieldAwaiter
+     * @brief Requeues the awaiting coroutine behind the ready ones.
+     */
+    struct YieldAwaiter {
+        AsyncExecutor& executor;        ///< Executor to requeue on
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> awaiting) { executor.ready.push_back(awaiting); }
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Constructor for real time: run() sleeps until the next deadline.
+     * @param clock Time source.
+     * @param resolution Timer wheel tick.
+     */
+    explicit AsyncExecutor(Clock& clock = SteadyClock::instance(),
+                           Clock::duration resolution = std::chrono::milliseconds(1));
+
+    /**
+     * @brief Constructor for virtual time: run() advances the clock to the next deadline.
+     * @param clock Simulated clock.
+     * @param resolution Timer wheel tick.
+     */
+    explicit AsyncExecutor(ManualClock& clock, Clock::duration resolution = std::chrono::milliseconds(1));
+
+    AsyncExecutor(const AsyncExecutor&) = delete;
+    AsyncExecutor& operator=(const AsyncExecutor&) = delete;
+    ~AsyncExecutor();
+
+    /**
+     * @brief Takes ownership of a task and queues its start.
+     * @param task Task to run.
+     */
+    void spawn(Task task);
+
+    /**
+     * @brief Runs until every spawned task has finished.
+     *
+     * Rethrows the first exception that escaped a spawned task (the other
+     * tasks are left suspended and destroyed with the executor).
+     */
+    void run();
+
+    /**
+     * @brief Creates an awaitable that resumes after a delay.
+     * @param delay Time to sleep.
+     * @return Awaitable.
+     */
+    SleepAwaiter sleepFor(Clock::duration delay) { return SleepAwaiter{*this, clock.now() + delay}; }
+
+    /**
+     * @brief Creates an awaitable that resumes at a time point.
+     * @param deadline Wake-up time.
+     * @return Awaitable.
+     */
+    SleepAwaiter sleepUntil(Clock::time_point deadline) { return SleepAwaiter{*this, deadline}; }
+
+    /**
+     * @brief Creates an awaitable that lets the other ready coroutines run first.
+     * @return Awaitable.
+     */
+    YieldAwaiter yield() { return YieldAwaiter{*this}; }
+
+    Clock& getClock() const { return clock; }                   ///< @return Time source
+    std::size_t getActiveTasks() const { return spawned.size(); } ///< @return Spawned tasks not finished yet
+    std::size_t getArmedTimers() const { return armedTimers; }  ///< @return Coroutines waiting on a timer
+
+private:
+    friend struct Task::promise_type::FinalAwaiter;
+
+    /**
+     * @struct Bucket
+     * @brief FIFO list of timers hashed to one wheel slot.
+     */
+    struct Bucket {
+        SleepAwaiter* head = nullptr;   ///< First timer
+        SleepAwaiter* tail = nullptr;   ///< Last timer
+    };
+
+    Clock& clock;                           ///< Time source
+    ManualClock* virtualClock;              ///< Set in virtual-time mode
+    Clock::duration resolution;             ///< Wheel tick length
+    Clock::time_point epoch;                ///< Time of wheel tick 0
+    std::uint64_t currentTick;              ///< Last expired wheel tick
+    Bucket wheel[WHEEL_SLOTS];              ///< Timer buckets
+    std::size_t armedTimers;                ///< Timers in the wheel
+    std::deque<std::coroutine_handle<>> ready; ///< Coroutines to resume
+    std::vector<std::coroutine_handle<Task::promise_type>> spawned; ///< Unfinished spawned tasks (destroyed with the executor)
+    std::exception_ptr firstError;          ///< First exception of a spawned task
+
+    /**
+     * @brief Inserts a timer into the wheel (or the ready queue if due).
+     * @param timer Timer living in the suspended coroutine frame.
+     */
+    void arm(SleepAwaiter& timer);
+
+    /**
+     * @brief Moves every timer due at or before a tick to the ready queue.
+     * @param tick Wheel tick reached by the clock.
+     */
+    void expire(std::uint64_t tick);
+
+    /**
+     * @brief Finds the earliest armed deadline.
+     * @return Wheel tick of the earliest timer.
+     */
+    std::uint64_t nextDeadlineTick() const;
+
+    /**
+     * @brief Records the completion of a spawned task.
+     * @param handle Finished task, destroyed by the executor.
+     */
+    void retire(std::coroutine_handle<Task::promise_type> handle);
+
+    /**
+     * @brief Converts a time point to the wheel tick containing it.
+     * @param time Time point.
+     * @return Tick (rounded down).
+     */
+    std::uint64_t tickAt(Clock::time_point time) const {
+        return time <= epoch ? 0 : static_cast<std::uint64_t>((time - epoch) / resolution);
+    }
+};
+
+/**
+ * @brief Smooths the volume to the target with one tick every step (non-blocking printAndSmooth()).
+ * @param executor Executor running the calling coroutine.
+ * @param avc Controller on the executor's clock.
+ * @param step Time per smoothing tick.
+ * @return Task completing once the controller has settled.
+ */
+Task smoothToTarget(AsyncExecutor& executor, AdaptiveVolumeControl& avc,
+                    Clock::duration step = std::chrono::milliseconds(200));
+
+/**
+ * @brief Waits out a running horn-duck hold and ramps back up.
+ *
+ * Re-commits the unchanged inputs every step while the hold runs, so the
+ * duck releases within one step after the hold expires (the first poll at
+ * or past HORN_DUCK_DURATION), as it would with updates every step.
+ * @param executor Executor running the calling coroutine.
+ * @param avc Controller on the executor's clock.
+ * @param step Poll and smoothing interval (the release granularity).
+ * @return Task completing once the duck has released and the volume settled.
+ */
+Task awaitDuckHold(AsyncExecutor& executor, AdaptiveVolumeControl& avc,
+                   Clock::duration step = std::chrono::milliseconds(200));
+
+/**
+ * @brief Applies one event and smooths to its target, reporting to the controller's sink.
+ * @param executor Executor running the calling coroutine.
+ * @param avc Controller on the executor's clock.
+ * @param inputs Inputs of the event (copied into the coroutine frame).
+ * @param eventName Name reported to the sink; must outlive the task (e.g. from an EventRegistry).
+ * @param step Smoothing tick interval.
+ * @return Task completing once the new target is reached.
+ */
+Task runEvent(AsyncExecutor& executor, AdaptiveVolumeControl& avc, ControlInputs inputs,
+              std::string_view eventName, Clock::duration step = std::chrono::milliseconds(200));
+
+#endif // __cpp_impl_coroutine
+
+#endif // ASYNC_DRIVER_H
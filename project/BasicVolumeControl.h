@@ -0,0 +1,340 @@
+/**
+ * @file BasicVolumeControl.h
+ * @brief Compile-time specialized volume controller (mode, control type and smoothing as template parameters).
+ */
+
+#ifndef BASIC_VOLUME_CONTROL_H
+#define BASIC_VOLUME_CONTROL_H
+
+#include "AdaptiveVolumeControl.h"
+#include "GainRamp.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <utility>
+#include <variant>
+
+/**
+ * @brief Speed, noise and mode terms of the built-in policy for a fixed mode.
+ * @tparam M Driving mode.
+ * @param speed Vehicle speed.
+ * @param noise Cabin noise level.
+ * @return Adaptive volume before event modifiers.
+ */
+template <Mode M>
+inline float adaptiveBaseVolumeFor(int speed, int noise) {
+    using AVC = AdaptiveVolumeControl;
+    float baseVolume = AVC::BASE_VOLUME;
+
+    if(speed > AVC::HIGH_SPEED_THRESHOLD) baseVolume += AVC::HIGH_SPEED_BOOST;
+    else if(speed > AVC::LOW_SPEED_THRESHOLD) baseVolume += AVC::MEDIUM_SPEED_BOOST;
+    else if(speed > 0) baseVolume += AVC::LOW_SPEED_BOOST;
+
+    baseVolume += noise * AVC::NOISE_SLOPE;
+
+    if constexpr(M == Mode::ECO) baseVolume *= AVC::ECO_MULTIPLIER;
+    else if constexpr(M == Mode::SPORTS) baseVolume *= AVC::SPORTS_MULTIPLIER;
+    return baseVolume;
+}
+
+/**
+ * @brief Applies the event multipliers of a VolumeModifier mask (unclamped).
+ *
+ * Horn, navigation, reverse, sudden brake, speed decrease, in that order,
+ * so every caller rounds identically.
+ * @param volume Volume before modifiers.
+ * @param modifiers VolumeModifier bits.
+ * @return Scaled volume.
+ */
+inline float scaleByModifiers(float volume, std::uint8_t modifiers) {
+    using AVC = AdaptiveVolumeControl;
+    if(modifiers & MODIFIER_HORN_DUCK) volume *= AVC::HORN_DUCK_MULTIPLIER;
+    if(modifiers & MODIFIER_NAVIGATION) volume *= AVC::NAV_DUCK_MULTIPLIER;
+    if(modifiers & MODIFIER_REVERSE) volume *= AVC::REVERSE_MULTIPLIER;
+    if(modifiers & MODIFIER_SUDDEN_BRAKE) volume *= AVC::SUDDEN_BRAKE_MULTIPLIER;
+    if(modifiers & MODIFIER_SPEED_DECREASE) volume *= AVC::SPEED_DECREASE_MULTIPLIER;
+    return volume;
+}
+
+/**
+ * @struct LinearSmoothing
+ * @brief Smoothing policy of AdaptiveVolumeControl::tick(): SMOOTH_FACTOR per SMOOTH_INTERVAL, scaled to dt.
+ */
+struct LinearSmoothing {
+    double tickDt = AdaptiveVolumeControl::SMOOTH_INTERVAL;   ///< Elapsed time the cached factor was computed for
+    float tickFactor = AdaptiveVolumeControl::SMOOTH_FACTOR;  ///< Cached smoothing factor for tickDt
+
+    /**
+     * @brief Moves the volume towards the target for dt seconds, snapping once within SETTLE_THRESHOLD.
+     * @param current Current volume.
+     * @param target Target volume.
+     * @param dt Elapsed time in seconds.
+     * @return New current volume.
+     */
+    float step(float current, float target, double dt) {
+        using AVC = AdaptiveVolumeControl;
+        if(std::abs(current - target) <= AVC::SETTLE_THRESHOLD) return target;
+        if(dt != tickDt) {
+            tickDt = dt;
+            tickFactor = 1.0f - static_cast<float>(std::pow(1.0 - AVC::SMOOTH_FACTOR, dt / AVC::SMOOTH_INTERVAL));
+        }
+        current += (target - current) * tickFactor;
+        return std::abs(current - target) <= AVC::SETTLE_THRESHOLD ? target : current;
+    }
+};
+
+/**
+ * @struct InstantSmoothing
+ * @brief Smoothing policy that jumps straight to the target (HIL benches, offline evaluation).
+ */
+struct InstantSmoothing {
+    /**
+     * @brief Returns the target.
+     * @param target Target volume.
+     * @return The target volume.
+     */
+    float step(float, float target, double) { return target; }
+};
+
+/**
+ * @struct VolumeControlState
+ * @brief Controller state shared by every instantiation, so a runtime wrapper can swap them.
+ */
+struct VolumeControlState {
+    int speed = 0;                                          ///< Current speed
+    int previousSpeed = 0;                                  ///< Speed of the previous update
+    int cabinNoise = 30;                                    ///< Current cabin noise
+    int manualVolume = 25;                                  ///< Manual volume (updated in manual instantiations only)
+    bool reverseGear = false;                               ///< Reverse gear status
+    bool hornActive = false;                                ///< Horn active status
+    bool navSpeaking = false;                               ///< Navigation speaking status
+    bool hornDuckActive = false;                            ///< Horn ducking (or its hold) active
+    std::uint8_t activeModifiers = 0;                       ///< VolumeModifier bits applied to the target
+    Clock::time_point hornDuckStartTime{};                  ///< Start of the running horn-duck hold
+    float targetVolume = AdaptiveVolumeControl::DEFAULT_VOLUME;    ///< Target volume
+    float currentVolume = AdaptiveVolumeControl::DEFAULT_VOLUME;   ///< Current volume
+};
+
+/**
+ * @class BasicVolumeControl
+ * @brief Built-in volume policy with the mode, control type and smoothing fixed at compile time.
+ *
+ * update() and tick() compile to straight-line code: no virtual calls and no
+ * mode or control-type branches; the clock is only read while the horn duck
+ * is involved. Targets and volumes are bit-identical to AdaptiveVolumeControl
+ * with the same inputs and no policy engine, arbiter, smoother, speed trend
+ * or sink; those stay with the AdaptiveVolumeControl facade.
+ *
+ * A SmoothingPolicy is any copyable type with
+ * `float step(float current, float target, double dt)`.
+ * @tparam M Driving mode.
+ * @tparam C Volume control type.
+ * @tparam SmoothingPolicy Smoothing applied by tick().
+ */
+template <Mode M, VolumeControlType C, class SmoothingPolicy = LinearSmoothing>
+class BasicVolumeControl {
+public:
+    static constexpr Mode MODE = M;                         ///< Driving mode of this instantiation
+    static constexpr VolumeControlType CONTROL_TYPE = C;    ///< Control type of this instantiation
+
+    /**
+     * @brief Constructor, optionally continuing from another instantiation's state.
+     * @param clock Time source for horn ducking.
+     * @param state Initial state.
+     * @param smoothing Initial smoothing policy state.
+     */
+    explicit BasicVolumeControl(Clock& clock = SteadyClock::instance(), const VolumeControlState& state = VolumeControlState{},
+                                const SmoothingPolicy& smoothing = SmoothingPolicy{})
+        : clock(&clock), s(state), smoothing(smoothing) {}
+
+    /**
+     * @brief Applies one control frame; inputs.mode and inputs.controlType are ignored (fixed by the type).
+     * @param inputs New inputs.
+     */
+    void update(const ControlInputs& inputs) {
+        s.previousSpeed = s.speed;
+        s.speed = inputs.speed;
+        s.cabinNoise = inputs.cabinNoise;
+        s.reverseGear = inputs.reverseGear;
+        s.hornActive = inputs.hornActive;
+        s.navSpeaking = inputs.navSpeaking;
+        if constexpr(C == VolumeControlType::MANUAL) s.manualVolume = inputs.manualVolume;
+
+        // Same hold as AdaptiveVolumeControl::handleHornDucking()
+        if(s.hornActive) {
+            s.hornDuckActive = true;
+            s.hornDuckStartTime = clock->now();
+        } else if(s.hornDuckActive) {
+            std::chrono::duration<double> elapsed = clock->now() - s.hornDuckStartTime;
+            if(elapsed.count() >= AdaptiveVolumeControl::HORN_DUCK_DURATION) s.hornDuckActive = false;
+        }
+
+        if constexpr(C == VolumeControlType::MANUAL) {
+            s.targetVolume = std::clamp<float>(s.manualVolume, AdaptiveVolumeControl::MIN_VOLUME, AdaptiveVolumeControl::MAX_VOLUME);
+            s.activeModifiers = 0;
+        } else {
+            std::uint8_t modifiers = 0;
+            if(s.hornDuckActive) modifiers |= MODIFIER_HORN_DUCK;
+            if(s.navSpeaking) modifiers |= MODIFIER_NAVIGATION;
+            if(s.reverseGear) modifiers |= MODIFIER_REVERSE;
+            else if(s.previousSpeed - s.speed > AdaptiveVolumeControl::SUDDEN_BRAKE_THRESHOLD) modifiers |= MODIFIER_SUDDEN_BRAKE;
+            else if(s.speed < s.previousSpeed) modifiers |= MODIFIER_SPEED_DECREASE;
+            s.activeModifiers = modifiers;
+
+            float volume = scaleByModifiers(adaptiveBaseVolumeFor<M>(s.speed, s.cabinNoise), modifiers);
+            if(volume < AdaptiveVolumeControl::MIN_VOLUME) volume = AdaptiveVolumeControl::MIN_VOLUME;
+            if(volume > AdaptiveVolumeControl::MAX_ADAPTIVE_VOLUME) volume = AdaptiveVolumeControl::MAX_ADAPTIVE_VOLUME;
+            s.targetVolume = volume;
+        }
+    }
+
+    /**
+     * @brief Advances the smoothing by dt seconds.
+     * @param dt Elapsed time in seconds since the previous tick.
+     */
+    void tick(double dt) { s.currentVolume = smoothing.step(s.currentVolume, s.targetVolume, dt); }
+
+    /**
+     * @brief Applies the smoothed volume to an interleaved PCM block (see AdaptiveVolumeControl::processBlock()).
+     * @param samples Interleaved samples, modified in place.
+     * @param n Number of frames (samples per channel).
+     * @param channels Number of interleaved channels.
+     * @param sampleRate Sample rate in Hz.
+     */
+    void processBlock(float* samples, std::size_t n, int channels,
+                      float sampleRate = AdaptiveVolumeControl::DEFAULT_SAMPLE_RATE) {
+        float startGain = s.currentVolume / AdaptiveVolumeControl::MAX_VOLUME;
+        tick(static_cast<double>(n) / sampleRate);
+        applyGainRamp(samples, n, channels, startGain, s.currentVolume / AdaptiveVolumeControl::MAX_VOLUME);
+    }
+
+    /**
+     * @brief Checks whether the current volume has converged to the target.
+     * @return True if within SETTLE_THRESHOLD of the target volume.
+     */
+    bool isSettled() const { return std::abs(s.currentVolume - s.targetVolume) <= AdaptiveVolumeControl::SETTLE_THRESHOLD; }
+
+    float getTargetVolume() const { return s.targetVolume; }                 ///< @return Target volume
+    float getCurrentVolume() const { return s.currentVolume; }               ///< @return Current volume
+    std::uint8_t getActiveModifiers() const { return s.activeModifiers; }    ///< @return VolumeModifier bits applied to the target
+    const VolumeControlState& state() const { return s; }                    ///< @return Full state (to continue in another instantiation)
+    const SmoothingPolicy& getSmoothing() const { return smoothing; }        ///< @return Smoothing policy state
+    Clock& getClock() const { return *clock; }                               ///< @return Time source
+
+private:
+    Clock* clock;                   ///< Time source for horn ducking
+    VolumeControlState s;           ///< Inputs, ducking and volumes
+    SmoothingPolicy smoothing;      ///< Smoothing policy state
+};
+
+/**
+ * @class RuntimeVolumeControl
+ * @brief Holds the BasicVolumeControl instantiation for the current mode and control type.
+ *
+ * update() swaps to another instantiation (carrying the state and the
+ * smoothing over) only when the mode or control type changes; every call
+ * then dispatches once on the variant index into fully inlined code.
+ * @tparam SmoothingPolicy Smoothing applied by tick().
+ */
+template <class SmoothingPolicy = LinearSmoothing>
+class RuntimeVolumeControl {
+public:
+    /// Alternatives indexed by controlType * 3 + mode
+    using Variant = std::variant<BasicVolumeControl<Mode::ECO, VolumeControlType::ADAPTIVE, SmoothingPolicy>,
+                                 BasicVolumeControl<Mode::COMFORT, VolumeControlType::ADAPTIVE, SmoothingPolicy>,
+                                 BasicVolumeControl<Mode::SPORTS, VolumeControlType::ADAPTIVE, SmoothingPolicy>,
+                                 BasicVolumeControl<Mode::ECO, VolumeControlType::MANUAL, SmoothingPolicy>,
+                                 BasicVolumeControl<Mode::COMFORT, VolumeControlType::MANUAL, SmoothingPolicy>,
+                                 BasicVolumeControl<Mode::SPORTS, VolumeControlType::MANUAL, SmoothingPolicy>>;
+
+    /**
+     * @brief Constructor starts in Comfort / adaptive like AdaptiveVolumeControl.
+     * @param clock Time source for horn ducking.
+     * @param smoothing Initial smoothing policy state.
+     */
+    explicit RuntimeVolumeControl(Clock& clock = SteadyClock::instance(), const SmoothingPolicy& smoothing = SmoothingPolicy{})
+        : control(std::in_place_index<indexOf(Mode::COMFORT, VolumeControlType::ADAPTIVE)>, clock, VolumeControlState{},
+                  smoothing) {}
+
+    /**
+     * @brief Applies one control frame, switching instantiation first if the mode or control type changed.
+     *
+     * Like AdaptiveVolumeControl::restoreState(), an out-of-range mode or
+     * control type rejects the whole frame and leaves the state untouched.
+     * @param inputs New inputs.
+     * @return True if applied, false if inputs.mode or inputs.controlType is invalid.
+     */
+    bool update(const ControlInputs& inputs) {
+        if(static_cast<unsigned>(inputs.mode) > static_cast<unsigned>(Mode::SPORTS) ||
+           static_cast<unsigned>(inputs.controlType) > static_cast<unsigned>(VolumeControlType::MANUAL))
+            return false;
+        std::size_t index = indexOf(inputs.mode, inputs.controlType);
+        if(index != control.index()) select(index, std::make_index_sequence<std::variant_size_v<Variant>>{});
+        std::visit([&](auto& active) { active.update(inputs); }, control);
+        return true;
+    }
+
+    /**
+     * @brief Advances the smoothing by dt seconds.
+     * @param dt Elapsed time in seconds since the previous tick.
+     */
+    void tick(double dt) { std::visit([dt](auto& active) { active.tick(dt); }, control); }
+
+    /**
+     * @brief Applies the smoothed volume to an interleaved PCM block.
+     * @param samples Interleaved samples, modified in place.
+     * @param n Number of frames (samples per channel).
+     * @param channels Number of interleaved channels.
+     * @param sampleRate Sample rate in Hz.
+     */
+    void processBlock(float* samples, std::size_t n, int channels,
+                      float sampleRate = AdaptiveVolumeControl::DEFAULT_SAMPLE_RATE) {
+        std::visit([&](auto& active) { active.processBlock(samples, n, channels, sampleRate); }, control);
+    }
+
+    bool isSettled() const { return std::visit([](const auto& active) { return active.isSettled(); }, control); } ///< @return True once converged
+    float getTargetVolume() const { return state().targetVolume; }                   ///< @return Target volume
+    float getCurrentVolume() const { return state().currentVolume; }                 ///< @return Current volume
+    std::uint8_t getActiveModifiers() const { return state().activeModifiers; }      ///< @return VolumeModifier bits applied to the target
+    Mode getMode() const { return static_cast<Mode>(control.index() % 3); }          ///< @return Mode of the active instantiation
+    VolumeControlType getControlType() const { return static_cast<VolumeControlType>(control.index() / 3); } ///< @return Control type of the active instantiation
+
+    /**
+     * @brief Gets the state of the active instantiation.
+     * @return Inputs, ducking and volumes.
+     */
+    const VolumeControlState& state() const {
+        return std::visit([](const auto& active) -> const VolumeControlState& { return active.state(); }, control);
+    }
+
+    const Variant& instantiation() const { return control; }   ///< @return Active instantiation (for std::visit by callers)
+
+private:
+    Variant control;    ///< Active instantiation
+
+    /**
+     * @brief Maps a mode and control type to the variant alternative.
+     */
+    static constexpr std::size_t indexOf(Mode mode, VolumeControlType controlType) {
+        return static_cast<std::size_t>(controlType) * 3 + static_cast<std::size_t>(mode);
+    }
+
+    /**
+     * @brief Replaces the active instantiation by alternative index, keeping clock, state and smoothing.
+     */
+    template <std::size_t... I>
+    void select(std::size_t index, std::index_sequence<I...>) {
+        Clock* clock = nullptr;
+        VolumeControlState state;
+        SmoothingPolicy smoothing;
+        std::visit([&](const auto& active) {
+            clock = &active.getClock();
+            state = active.state();
+            smoothing = active.getSmoothing();
+        }, control);
+        ((index == I ? (void)control.template emplace<I>(*clock, state, smoothing) : void()), ...);
+    }
+};
+
+#endif // BASIC_VOLUME_CONTROL_H
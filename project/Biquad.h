@@ -0,0 +1,40 @@
+/**
+ * @file Biquad.h
+ * @brief Defines the Biquad struct, a second-order IIR filter section.
+ */
+
+#ifndef BIQUAD_H
+#define BIQUAD_H
+
+/**
+ * @struct Biquad
+ * @brief Second-order IIR section in transposed direct form II (a0 normalized to 1).
+ */
+struct Biquad {
+    float b0 = 1.0f; ///< Feed-forward coefficient for x[n]
+    float b1 = 0.0f; ///< Feed-forward coefficient for x[n-1]
+    float b2 = 0.0f; ///< Feed-forward coefficient for x[n-2]
+    float a1 = 0.0f; ///< Feedback coefficient for y[n-1]
+    float a2 = 0.0f; ///< Feedback coefficient for y[n-2]
+    float z1 = 0.0f; ///< First state variable
+    float z2 = 0.0f; ///< Second state variable
+
+    /**
+     * @brief Filters one sample.
+     * @param x Input sample.
+     * @return Output sample.
+     */
+    float process(float x) {
+        float y = b0 * x + z1;
+        z1 = b1 * x - a1 * y + z2;
+        z2 = b2 * x - a2 * y;
+        return y;
+    }
+
+    /**
+     * @brief Clears the filter state.
+     */
+    void reset() { z1 = z2 = 0.0f; }
+};
+
+#endif // BIQUAD_H
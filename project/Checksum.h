@@ -0,0 +1,50 @@
+/**
+ * @file Checksum.h
+ * @brief CRC-32 (IEEE 802.3, reflected) used to validate persisted binary blobs.
+ */
+
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct Crc32Table
+ * @brief Byte-wise lookup table for the reflected 0xEDB88320 polynomial.
+ */
+struct Crc32Table {
+    std::uint32_t entries[256]; ///< CRC of each byte value
+};
+
+/**
+ * @brief Builds the CRC-32 table at compile time.
+ * @return Filled table.
+ */
+constexpr Crc32Table buildCrc32Table() {
+    Crc32Table table{};
+    for(std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for(int bit = 0; bit < 8; ++bit) c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table.entries[i] = c;
+    }
+    return table;
+}
+
+inline constexpr Crc32Table CRC32_TABLE = buildCrc32Table(); ///< Table evaluated at compile time
+
+/**
+ * @brief Computes the CRC-32 of a byte range.
+ * @param data Bytes to checksum.
+ * @param size Number of bytes.
+ * @param crc Result of a previous call when checksumming in pieces (0 to start).
+ * @return CRC-32 (matches zlib's crc32()).
+ */
+inline std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc = 0) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    for(std::size_t i = 0; i < size; ++i) crc = CRC32_TABLE.entries[(crc ^ bytes[i]) & 0xFFu] ^ (crc >> 8);
+    return ~crc;
+}
+
+#endif // CHECKSUM_H
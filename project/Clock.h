@@ -0,0 +1,79 @@
+/**
+ * @file Clock.h
+ * @brief Defines the time sources used by AdaptiveVolumeControl for timed events (horn ducking).
+ */
+
+#ifndef VOLUME_CLOCK_H
+#define VOLUME_CLOCK_H
+
+#include <chrono>
+
+/**
+ * @class Clock
+ * @brief Monotonic time source interface injected into AdaptiveVolumeControl.
+ */
+class Clock {
+public:
+    using duration = std::chrono::nanoseconds;                                        ///< Clock tick type
+    using time_point = std::chrono::time_point<std::chrono::steady_clock, duration>;  ///< Clock time point type
+
+    virtual ~Clock() = default;
+
+    /**
+     * @brief Gets the current time.
+     * @return Current monotonic time point.
+     */
+    virtual time_point now() const = 0;
+};
+
+/**
+ * @class SteadyClock
+ * @brief Default clock backed by std::chrono::steady_clock (immune to wall-clock/NTP jumps).
+ */
+class SteadyClock : public Clock {
+public:
+    time_point now() const override {
+        return std::chrono::time_point_cast<duration>(std::chrono::steady_clock::now());
+    }
+
+    /**
+     * @brief Gets the shared process-wide steady clock instance.
+     * @return Reference to the default clock.
+     */
+    static SteadyClock& instance() {
+        static SteadyClock clock;
+        return clock;
+    }
+};
+
+/**
+ * @class ManualClock
+ * @brief Simulated clock that only moves when told to (log replay, tests).
+ */
+class ManualClock : public Clock {
+public:
+    /**
+     * @brief Constructor starts the simulated time at the given point.
+     * @param start Initial time point.
+     */
+    explicit ManualClock(time_point start = time_point{}) : current(start) {}
+
+    time_point now() const override { return current; }
+
+    /**
+     * @brief Sets the simulated time to an absolute timestamp.
+     * @param timestamp New current time.
+     */
+    void set(time_point timestamp) { current = timestamp; }
+
+    /**
+     * @brief Moves the simulated time forward.
+     * @param step Amount of time to advance.
+     */
+    void advance(duration step) { current += step; }
+
+private:
+    time_point current; ///< Current simulated time
+};
+
+#endif // VOLUME_CLOCK_H
@@ -0,0 +1,96 @@
+/**
+ * @file ConsoleVolumeSink.cpp
+ * @brief Implements the ConsoleVolumeSink class printing colored event output.
+ */
+
+#include "ConsoleVolumeSink.h"
+#include <iostream>
+
+// ANSI color codes for console output
+#define RESET   "\033[0m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define BLUE    "\033[34m"
+#define CYAN    "\033[36m"
+
+/**
+ * @brief Constructor binds the sink to a stream.
+ * @param out Stream to print to.
+ */
+ConsoleVolumeSink::ConsoleVolumeSink(std::ostream& out) : out(out) {}
+
+/**
+ * @brief Constructor binds the sink to std::cout.
+ */
+ConsoleVolumeSink::ConsoleVolumeSink() : out(std::cout) {}
+
+/**
+ * @brief Prints horn press/release messages.
+ * @param pressed True if the horn was pressed.
+ */
+void ConsoleVolumeSink::onHornChanged(bool pressed) {
+    line << YELLOW << (pressed ? "[Horn Pressed]" : "[Horn Released]") << RESET << "\n";
+    line.flushTo(out);
+}
+
+/**
+ * @brief Prints one line per applied event modifier.
+ * @param modifiers VolumeModifier bits that were applied.
+ */
+void ConsoleVolumeSink::onModifiersApplied(std::uint8_t modifiers) {
+    if(modifiers & MODIFIER_HORN_DUCK) line << YELLOW << "[Horn Duck Active]" << RESET << "\n";
+    if(modifiers & MODIFIER_NAVIGATION) line << BLUE << "[Navigation Speaking]" << RESET << "\n";
+    if(modifiers & MODIFIER_REVERSE) line << RED << "[Reverse Gear Active]" << RESET << "\n";
+    if(modifiers & MODIFIER_SUDDEN_BRAKE) line << RED << "[Sudden Brake]" << RESET << "\n";
+    if(modifiers & MODIFIER_SPEED_DECREASE) line << CYAN << "[Speed Decrease]" << RESET << "\n";
+    line.flushTo(out);
+}
+
+/**
+ * @brief Prints event header information.
+ * @param eventName Name of the event.
+ * @param avc Controller state at the start of the event.
+ */
+void ConsoleVolumeSink::onEventStart(std::string_view eventName, const AdaptiveVolumeControl& avc) {
+    Mode mode = avc.getMode();
+
+    line << CYAN << "\n===============================" << RESET << "\n";
+    line << CYAN << " EVENT: " << eventName << RESET << "\n";
+    line << CYAN << "===============================" << RESET << "\n";
+
+    line << "Speed: " << avc.getSpeed() << " km/h | Noise: " << avc.getCabinNoise() << " dB | Mode: "
+         << (mode == Mode::ECO ? "Eco" : mode == Mode::COMFORT ? "Comfort" : "Sports") << "\n";
+
+    line << "Reverse: " << (avc.isReverseGear() ? RED "Yes" RESET : GREEN "No" RESET)
+         << " | Horn: " << (avc.isHornActive() ? YELLOW "Yes" RESET : GREEN "No" RESET)
+         << " | Navigation: " << (avc.isNavSpeaking() ? BLUE "Yes" RESET : GREEN "No" RESET) << "\n";
+
+    bool manual = avc.getControlType() == VolumeControlType::MANUAL;
+    line << "Control: " << (manual ? GREEN "Manual" RESET : CYAN "Adaptive" RESET) << "\n";
+    if(manual) line << GREEN << "Manual Volume: " << avc.getManualVolume() << RESET << "\n";
+
+    line << "Target Volume: " << YELLOW << (int)avc.getTargetVolume() << RESET
+         << " | Current Volume: " << BLUE << (int)avc.getCurrentVolume() << RESET << "\n";
+    line << "-------------------------------\n";
+    line.flushTo(out);
+}
+
+/**
+ * @brief Prints the current volume value.
+ * @param currentVolume Current volume after the step.
+ */
+void ConsoleVolumeSink::onVolumeStep(float currentVolume) {
+    line << GREEN << "[Volume Update] Current: " << (int)currentVolume << RESET << "\n";
+    line.flushTo(out);
+}
+
+/**
+ * @brief Prints the final volume and the closing separator.
+ * @param currentVolume Final volume.
+ */
+void ConsoleVolumeSink::onTargetReached(float currentVolume) {
+    line << GREEN << "[Final Volume Reached Target: " << (int)currentVolume << "]" << RESET << "\n";
+    line << CYAN << "===============================\n\n" << RESET;
+    line.flushTo(out);
+}
@@ -0,0 +1,53 @@
+/**
+ * @file ConsoleVolumeSink.h
+ * @brief Defines the ConsoleVolumeSink class printing colored event output.
+ */
+
+#ifndef CONSOLE_VOLUME_SINK_H
+#define CONSOLE_VOLUME_SINK_H
+
+#include "VolumeEventSink.h"
+#include "FormatBuffer.h"
+#include <iosfwd>
+
+/**
+ * @class ConsoleVolumeSink
+ * @brief Prints AdaptiveVolumeControl events with ANSI colors to an output stream.
+ *
+ * Each callback formats into a buffer owned by the sink and hands it to the
+ * stream with one write(), so printing an event allocates nothing.
+ */
+class ConsoleVolumeSink : public VolumeEventSink {
+public:
+    /**
+     * @brief Constructor binds the sink to a stream.
+     * @param out Stream to print to.
+     */
+    explicit ConsoleVolumeSink(std::ostream& out);
+
+    /**
+     * @brief Constructor binds the sink to std::cout.
+     */
+    ConsoleVolumeSink();
+
+    void onHornChanged(bool pressed) override;
+    void onModifiersApplied(std::uint8_t modifiers) override;
+    void onEventStart(std::string_view eventName, const AdaptiveVolumeControl& avc) override;
+    void onVolumeStep(float currentVolume) override;
+    void onTargetReached(float currentVolume) override;
+
+    /**
+     * @brief Gets the number of callbacks whose output overflowed the line buffer.
+     *
+     * Such output ends with FormatBuffer::TRUNCATION_MARKER, e.g. for a very
+     * long event name from an EventRegistry.
+     * @return Truncated callbacks so far.
+     */
+    std::size_t getTruncatedLines() const { return line.truncations(); }
+
+private:
+    std::ostream& out; ///< Output stream
+    FormatBuffer line; ///< Text of the callback being printed
+};
+
+#endif // CONSOLE_VOLUME_SINK_H
@@ -0,0 +1,139 @@
+/**
+ * @file DuckingArbiter.cpp
+ * @brief Implements the DuckingArbiter class combining prioritized duck requests.
+ */
+
+#include "DuckingArbiter.h"
+#include "AdaptiveVolumeControl.h"
+#include <algorithm>
+
+using namespace std::chrono;
+
+/**
+ * @brief Gets the envelope that reproduces the built-in horn duck.
+ * @return Config with HORN_DUCK_MULTIPLIER depth and HORN_DUCK_DURATION hold.
+ */
+DuckSourceConfig DuckingArbiter::hornSource() {
+    DuckSourceConfig config;
+    config.priority = 100;
+    config.depth = AdaptiveVolumeControl::HORN_DUCK_MULTIPLIER;
+    config.hold = static_cast<float>(AdaptiveVolumeControl::HORN_DUCK_DURATION);
+    return config;
+}
+
+/**
+ * @brief Registers a source.
+ * @param config Envelope and precedence.
+ * @return Source id, or -1 if MAX_SOURCES are registered.
+ */
+int DuckingArbiter::registerSource(const DuckSourceConfig& config) {
+    if(sourceCount == MAX_SOURCES) return -1;
+    sources[sourceCount] = Source{};
+    sources[sourceCount].config = config;
+    return sourceCount++;
+}
+
+/**
+ * @brief Reports whether a source is requesting a duck.
+ * @param id Source id.
+ * @param active True while the source is playing.
+ * @param now Frame time.
+ * @return False if the id is invalid or MAX_ACTIVE sources are already engaged.
+ */
+bool DuckingArbiter::setActive(int id, bool active, Clock::time_point now) {
+    if(id < 0 || id >= sourceCount) return false;
+    Source& source = sources[id];
+
+    if(active) {
+        if(!source.on) {
+            if(!source.queued) {
+                if(activeCount == MAX_ACTIVE) return false;
+                heap[activeCount++] = id;
+                std::push_heap(heap, heap + activeCount, [this](int a, int b) { return lowerPriority(a, b); });
+                source.queued = true;
+            }
+            // Resume the attack from the current level (re-trigger during hold/release)
+            float current = engagement(source, now);
+            source.onset = now - duration_cast<Clock::duration>(duration<double>(current * source.config.attack));
+            source.on = true;
+        }
+        source.lastActive = now;
+    } else if(source.on) {
+        source.releaseEngagement = engagement(source, source.lastActive);
+        source.on = false;
+    }
+    return true;
+}
+
+/**
+ * @brief Computes how far a source is engaged.
+ * @param source Source.
+ * @param now Evaluation time.
+ * @return 0 (no duck) .. 1 (full depth).
+ */
+float DuckingArbiter::engagement(const Source& source, Clock::time_point now) {
+    const DuckSourceConfig& config = source.config;
+    if(source.on) {
+        if(config.attack <= 0.0f) return 1.0f;
+        double attacked = duration<double>(now - source.onset).count() / config.attack;
+        return static_cast<float>(std::min(1.0, std::max(0.0, attacked)));
+    }
+    if(!source.queued) return 0.0f;
+
+    // Same comparison as the built-in horn duck: held while elapsed < hold
+    double elapsed = duration<double>(now - source.lastActive).count();
+    if(elapsed < config.hold) return source.releaseEngagement;
+    if(config.release <= 0.0f) return 0.0f;
+    double released = 1.0 - (elapsed - config.hold) / config.release;
+    return released > 0.0 ? static_cast<float>(source.releaseEngagement * released) : 0.0f;
+}
+
+/**
+ * @brief Heap ordering: lower priority (then higher id) sinks.
+ * @return True if a should be below b.
+ */
+bool DuckingArbiter::lowerPriority(int a, int b) const {
+    std::uint8_t pa = sources[a].config.priority, pb = sources[b].config.priority;
+    return pa != pb ? pa < pb : a > b;
+}
+
+/**
+ * @brief Computes the combined duck gain and drops sources that finished releasing.
+ * @param now Evaluation time.
+ * @return Gain in [0, 1] to apply to the target volume.
+ */
+float DuckingArbiter::evaluate(Clock::time_point now) {
+    if(activeCount == 0) return 1.0f;
+    auto below = [this](int a, int b) { return lowerPriority(a, b); };
+
+    // Walk engaged sources in priority order on a copy of the heap
+    int order[MAX_ACTIVE];
+    int remaining = activeCount;
+    std::copy(heap, heap + activeCount, order);
+
+    int survivors[MAX_ACTIVE];
+    int survivorCount = 0;
+    bool masked = false;
+    float gain = 1.0f;
+    while(remaining > 0) {
+        std::pop_heap(order, order + remaining, below);
+        int id = order[--remaining];
+        Source& source = sources[id];
+        float e = engagement(source, now);
+        if(e <= 0.0f && !source.on) {
+            source.queued = false; // finished releasing
+            continue;
+        }
+        survivors[survivorCount++] = id;
+        if(masked) continue;
+        gain *= e >= 1.0f ? source.config.depth : 1.0f - e * (1.0f - source.config.depth);
+        if(source.config.mix == DuckMix::EXCLUSIVE && e > 0.0f) masked = true;
+    }
+
+    if(survivorCount != activeCount) {
+        std::copy(survivors, survivors + survivorCount, heap);
+        activeCount = survivorCount;
+        std::make_heap(heap, heap + activeCount, below);
+    }
+    return gain;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file DuckingArbiter.h
+ * @brief Defines the DuckingArbiter class combining prioritized duck requests from many audio sources.
+ */
+
+#ifndef DUCKING_ARBITER_H
+#define DUCKING_ARBITER_H
+
+#include "Clock.h"
+#include <cstdint>
+
+/**
+ * @enum DuckMix
+ * @brief How a source combines with the other active sources.
+ */
+enum class DuckMix : std::uint8_t {
+    MULTIPLY,  ///< Gains multiply with the other sources (like the built-in horn/navigation ducks)
+    EXCLUSIVE  ///< While engaged, sources of lower priority are ignored (e.g. a phone call)
+};
+
+/**
+ * @struct DuckSourceConfig
+ * @brief Envelope and precedence of one duck source.
+ */
+struct DuckSourceConfig {
+    std::uint8_t priority = 0;          ///< Higher values take precedence
+    float depth = 0.5f;                 ///< Gain while fully engaged (1 = no duck, 0 = mute)
+    float attack = 0.0f;                ///< Seconds to ramp from no duck to depth
+    float hold = 0.0f;                  ///< Seconds the duck is held after the last active frame
+    float release = 0.0f;               ///< Seconds to ramp back to no duck after the hold
+    DuckMix mix = DuckMix::MULTIPLY;    ///< Combination with other sources
+};
+
+/**
+ * @class DuckingArbiter
+ * @brief Evaluates attack/hold/release duck envelopes of registered sources.
+ *
+ * Generalizes the horn-duck hold: an active source stays engaged for hold
+ * seconds after the last frame it was reported active, then releases. Only
+ * active sources are kept, in a fixed-capacity max-heap by priority, so an
+ * evaluation walks the active sources in priority order and never the full
+ * registry. The arbiter never allocates and is used from one thread (the
+ * one calling AdaptiveVolumeControl::commit()).
+ */
+class DuckingArbiter {
+public:
+    static constexpr int MAX_SOURCES = 32; ///< Registered source limit
+    static constexpr int MAX_ACTIVE = 16;  ///< Simultaneously engaged source limit
+
+    /**
+     * @brief Gets the envelope that reproduces the built-in horn duck.
+     * @return Config with HORN_DUCK_MULTIPLIER depth and HORN_DUCK_DURATION hold.
+     */
+    static DuckSourceConfig hornSource();
+
+    /**
+     * @brief Registers a source.
+     * @param config Envelope and precedence.
+     * @return Source id, or -1 if MAX_SOURCES are registered.
+     */
+    int registerSource(const DuckSourceConfig& config);
+
+    /**
+     * @brief Reports whether a source is requesting a duck (call every frame or on change).
+     * @param id Source id.
+     * @param active True while the source is playing.
+     * @param now Frame time.
+     * @return False if the id is invalid or MAX_ACTIVE sources are already engaged.
+     */
+    bool setActive(int id, bool active, Clock::time_point now);
+
+    /**
+     * @brief Computes the combined duck gain and drops sources that finished releasing.
+     * @param now Evaluation time.
+     * @return Gain in [0, 1] to apply to the target volume.
+     */
+    float evaluate(Clock::time_point now);
+
+    /**
+     * @brief Checks whether no source is engaged.
+     * @return True if evaluate() would return 1 until a source becomes active.
+     */
+    bool isIdle() const { return activeCount == 0; }
+
+    /**
+     * @brief Gets the highest-priority engaged source.
+     * @return Source id, or -1 if idle.
+     */
+    int getDominantSource() const { return activeCount ? heap[0] : -1; }
+
+private:
+    /**
+     * @struct Source
+     * @brief Registered source and its envelope state.
+     */
+    struct Source {
+        DuckSourceConfig config;            ///< Envelope and precedence
+        bool on = false;                    ///< Currently reported active
+        bool queued = false;                ///< Present in the active heap
+        float releaseEngagement = 0.0f;     ///< Engagement at the last active frame
+        Clock::time_point onset{};          ///< Start of the (virtual) attack ramp
+        Clock::time_point lastActive{};     ///< Last frame the source was active
+    };
+
+    Source sources[MAX_SOURCES];    ///< Registry
+    int sourceCount = 0;            ///< Registered sources
+    int heap[MAX_ACTIVE] = {};      ///< Engaged source ids, max-heap by priority
+    int activeCount = 0;            ///< Entries in heap
+
+    /**
+     * @brief Computes how far a source is engaged.
+     * @param source Source.
+     * @param now Evaluation time.
+     * @return 0 (no duck) .. 1 (full depth).
+     */
+    static float engagement(const Source& source, Clock::time_point now);
+
+    /**
+     * @brief Heap ordering: lower priority (then higher id) sinks.
+     * @return True if a should be below b.
+     */
+    bool lowerPriority(int a, int b) const;
+};
+
+#endif // DUCKING_ARBITER_H
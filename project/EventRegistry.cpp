@@ -0,0 +1,35 @@
+/**
+ * @file EventRegistry.cpp
+ * @brief Implements the interned event-name registry.
+ */
+
+#include "EventRegistry.h"
+#include <cstring>
+
+/**
+ * @brief Returns the ID of a name, adding it on first use.
+ * @param name Event name (copied into the arena).
+ * @return ID of the name, or INVALID_EVENT_ID if the registry or its arena is full.
+ */
+EventId EventRegistry::intern(std::string_view name) {
+    EventId existing = find(name);
+    if(existing != INVALID_EVENT_ID) return existing;
+    if(count == MAX_EVENTS || name.size() > ARENA_SIZE - used) return INVALID_EVENT_ID;
+
+    if(!name.empty()) std::memcpy(arena + used, name.data(), name.size());
+    offsets[count] = static_cast<std::uint16_t>(used);
+    lengths[count] = static_cast<std::uint16_t>(name.size());
+    used += name.size();
+    return static_cast<EventId>(count++);
+}
+
+/**
+ * @brief Looks up an already interned name.
+ * @param name Event name.
+ * @return ID of the name, or INVALID_EVENT_ID if it was never interned.
+ */
+EventId EventRegistry::find(std::string_view name) const {
+    for(std::size_t id = 0; id < count; ++id)
+        if(this->name(static_cast<EventId>(id)) == name) return static_cast<EventId>(id);
+    return INVALID_EVENT_ID;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file EventRegistry.h
+ * @brief Defines event IDs and a fixed-capacity registry of interned event names.
+ */
+
+#ifndef EVENT_REGISTRY_H
+#define EVENT_REGISTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+using EventId = std::uint16_t;                  ///< Index of an interned event name
+constexpr EventId INVALID_EVENT_ID = 0xFFFF;    ///< Returned when a name is unknown or the registry is full
+
+/**
+ * @class EventRegistry
+ * @brief Interns event names into a fixed arena at init, then maps IDs to names without allocating.
+ *
+ * intern() runs during start-up (a linear search over at most MAX_EVENTS
+ * names); name() is an O(1) lookup safe to call on the event path. The
+ * registry never touches the heap.
+ */
+class EventRegistry {
+public:
+    static constexpr std::size_t MAX_EVENTS = 64;    ///< Distinct names the registry can hold
+    static constexpr std::size_t ARENA_SIZE = 2048;  ///< Bytes of name storage
+
+    /**
+     * @brief Returns the ID of a name, adding it on first use.
+     * @param name Event name (copied into the arena).
+     * @return ID of the name, or INVALID_EVENT_ID if the registry or its arena is full.
+     */
+    EventId intern(std::string_view name);
+
+    /**
+     * @brief Looks up an already interned name.
+     * @param name Event name.
+     * @return ID of the name, or INVALID_EVENT_ID if it was never interned.
+     */
+    EventId find(std::string_view name) const;
+
+    /**
+     * @brief Returns the name of an ID.
+     * @param id Event ID returned by intern().
+     * @return Name stored in the arena, empty for an unknown ID.
+     */
+    std::string_view name(EventId id) const {
+        return id < count ? std::string_view(arena + offsets[id], lengths[id]) : std::string_view();
+    }
+
+    std::size_t size() const { return count; }      ///< @return Number of interned names
+
+private:
+    char arena[ARENA_SIZE];                ///< Name bytes, appended in intern order
+    std::uint16_t offsets[MAX_EVENTS];     ///< Start of each name in the arena
+    std::uint16_t lengths[MAX_EVENTS];     ///< Length of each name
+    std::size_t count = 0;                 ///< Interned names
+    std::size_t used = 0;                  ///< Arena bytes in use
+};
+
+#endif // EVENT_REGISTRY_H
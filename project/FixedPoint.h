@@ -0,0 +1,124 @@
+/**
+ * @file FixedPoint.h
+ * @brief Saturating Q15 / Q16.16 arithmetic for FPU-less targets.
+ *
+ * Q15 holds fractions in [-1, 1) in an int16; Q16.16 holds values in
+ * [-32768, 32768) in an int32. Products are computed in 64 bits, rounded to
+ * nearest and saturated, so results are identical on every platform.
+ */
+
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <cstdint>
+#include <limits>
+
+using q15_t = std::int16_t;   ///< Q1.15 fraction
+using q16_t = std::int32_t;   ///< Q16.16 value
+
+constexpr int Q15_SHIFT = 15;           ///< Fraction bits of q15_t
+constexpr int Q16_SHIFT = 16;           ///< Fraction bits of q16_t
+constexpr q16_t Q16_ONE = 1 << Q16_SHIFT; ///< 1.0 in Q16.16
+
+/**
+ * @brief Saturates a 64-bit intermediate to int32.
+ * @param value Intermediate.
+ * @return Clamped value.
+ */
+constexpr std::int32_t saturate32(std::int64_t value) {
+    return value > std::numeric_limits<std::int32_t>::max() ? std::numeric_limits<std::int32_t>::max()
+         : value < std::numeric_limits<std::int32_t>::min() ? std::numeric_limits<std::int32_t>::min()
+         : static_cast<std::int32_t>(value);
+}
+
+/**
+ * @brief Saturates a 32-bit intermediate to int16.
+ * @param value Intermediate.
+ * @return Clamped value.
+ */
+constexpr std::int16_t saturate16(std::int32_t value) {
+    return value > std::numeric_limits<std::int16_t>::max() ? std::numeric_limits<std::int16_t>::max()
+         : value < std::numeric_limits<std::int16_t>::min() ? std::numeric_limits<std::int16_t>::min()
+         : static_cast<std::int16_t>(value);
+}
+
+/**
+ * @brief Converts a constant to Q15 (rounded, saturated).
+ * @param value Fraction.
+ * @return Q15 value.
+ */
+constexpr q15_t toQ15(double value) {
+    double scaled = value * (1 << Q15_SHIFT);
+    return saturate16(static_cast<std::int32_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5));
+}
+
+/**
+ * @brief Converts a constant to Q16.16 (rounded, saturated).
+ * @param value Value.
+ * @return Q16.16 value.
+ */
+constexpr q16_t toQ16(double value) {
+    double scaled = value * Q16_ONE;
+    return saturate32(static_cast<std::int64_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5));
+}
+
+/**
+ * @brief Converts a Q16.16 value to float (for reporting and validation only).
+ * @param value Q16.16 value.
+ * @return Float value.
+ */
+constexpr float q16ToFloat(q16_t value) { return static_cast<float>(value) / Q16_ONE; }
+
+/**
+ * @brief Converts an integer to Q16.16 (saturated).
+ *
+ * Scales by multiplication: left-shifting a negative value is undefined before C++20.
+ * @param value Integer.
+ * @return Q16.16 value.
+ */
+constexpr q16_t intToQ16(std::int32_t value) { return saturate32(static_cast<std::int64_t>(value) * Q16_ONE); }
+
+/**
+ * @brief Saturating addition.
+ * @return a + b clamped to the Q16.16 range.
+ */
+constexpr q16_t addSat(q16_t a, q16_t b) { return saturate32(static_cast<std::int64_t>(a) + b); }
+
+/**
+ * @brief Saturating subtraction.
+ * @return a - b clamped to the Q16.16 range.
+ */
+constexpr q16_t subSat(q16_t a, q16_t b) { return saturate32(static_cast<std::int64_t>(a) - b); }
+
+/**
+ * @brief Rounding arithmetic right shift of a 64-bit product.
+ * @param product Product.
+ * @param shift Bits to drop.
+ * @return Rounded to nearest, ties away from zero.
+ */
+constexpr std::int64_t roundShift(std::int64_t product, int shift) {
+    std::int64_t half = std::int64_t{1} << (shift - 1);
+    return product >= 0 ? (product + half) >> shift : -((-product + half) >> shift);
+}
+
+/**
+ * @brief Scales a Q16.16 value by a Q15 fraction.
+ * @return a * b in Q16.16, rounded and saturated.
+ */
+constexpr q16_t mulQ16Q15(q16_t a, q15_t b) { return saturate32(roundShift(static_cast<std::int64_t>(a) * b, Q15_SHIFT)); }
+
+/**
+ * @brief Multiplies two Q16.16 values.
+ * @return a * b in Q16.16, rounded and saturated.
+ */
+constexpr q16_t mulQ16(q16_t a, q16_t b) { return saturate32(roundShift(static_cast<std::int64_t>(a) * b, Q16_SHIFT)); }
+
+/**
+ * @brief Scales a Q15 sample by a Q15 gain.
+ * @return a * b in Q15, rounded and saturated.
+ */
+constexpr q15_t mulQ15(q15_t a, q15_t b) {
+    return saturate16(static_cast<std::int32_t>(roundShift(static_cast<std::int64_t>(a) * b, Q15_SHIFT)));
+}
+
+#endif // FIXED_POINT_H
@@ -0,0 +1,188 @@
+/**
+ * @file FixedPointVolumeControl.cpp
+ * @brief Implements the integer-only FixedPointVolumeControl class.
+ */
+
+#include "FixedPointVolumeControl.h"
+#include <cmath>
+
+using namespace std::chrono;
+
+namespace {
+/// Horn duck hold as a clock duration, so the timer compares integers
+const Clock::duration HORN_DUCK_HOLD = duration_cast<Clock::duration>(
+    duration<double>(AdaptiveVolumeControl::HORN_DUCK_DURATION));
+
+constexpr std::int64_t GAIN_PER_VOLUME = 83886; ///< round(2^24 / 200): Q16.16 volume to Q15 gain, then >> 24
+}
+
+/**
+ * @brief Constructor initializes the controller like AdaptiveVolumeControl.
+ * @param clock Time source for horn ducking.
+ */
+FixedPointVolumeControl::FixedPointVolumeControl(Clock& clock)
+    : speed(0), previousSpeed(0), cabinNoise(30),
+      reverseGear(false), hornActive(false), navSpeaking(false),
+      mode(Mode::COMFORT), controlType(VolumeControlType::ADAPTIVE), manualVolume(25),
+      targetVolume(DEFAULT_VOLUME), currentVolume(DEFAULT_VOLUME), tickFactor(SMOOTH_FACTOR),
+      clock(&clock), hornDuckActive(false), hornDuckStartTime(clock.now()), activeModifiers(0) {}
+
+/**
+ * @brief Updates internal state and recalculates the target volume.
+ * @param newSpeed Current vehicle speed.
+ * @param newNoise Current cabin noise level.
+ * @param newReverseGear Reverse gear status.
+ * @param newHornActive Horn active status.
+ * @param newNavSpeaking Navigation speaking status.
+ * @param newMode Current driving mode.
+ * @param newControlType Volume control type (adaptive/manual).
+ * @param newManualVolume Manual volume value (if applicable).
+ */
+void FixedPointVolumeControl::update(int newSpeed, int newNoise, bool newReverseGear, bool newHornActive,
+                                     bool newNavSpeaking, Mode newMode,
+                                     VolumeControlType newControlType, int newManualVolume) {
+    previousSpeed = speed;
+    speed = newSpeed;
+    cabinNoise = newNoise;
+    reverseGear = newReverseGear;
+    hornActive = newHornActive;
+    navSpeaking = newNavSpeaking;
+    mode = newMode;
+    controlType = newControlType;
+    if(controlType == VolumeControlType::MANUAL) manualVolume = newManualVolume;
+
+    // Same hold as the float controller: measured from the last frame the horn was active
+    if(hornActive || hornDuckActive) {
+        Clock::time_point now = clock->now();
+        if(hornActive) {
+            hornDuckActive = true;
+            hornDuckStartTime = now;
+        } else if(now - hornDuckStartTime >= HORN_DUCK_HOLD) {
+            hornDuckActive = false;
+        }
+    }
+
+    calculateTargetVolume();
+}
+
+/**
+ * @brief Calculates the target volume based on current state.
+ */
+void FixedPointVolumeControl::calculateTargetVolume() {
+    if(controlType == VolumeControlType::MANUAL) {
+        q16_t manual = intToQ16(manualVolume);
+        targetVolume = manual > MAX_VOLUME ? MAX_VOLUME : manual < MIN_VOLUME ? MIN_VOLUME : manual;
+        activeModifiers = 0;
+        return;
+    }
+
+    q16_t baseVolume = BASE_VOLUME;
+
+    if(speed > AVC::HIGH_SPEED_THRESHOLD) baseVolume = addSat(baseVolume, intToQ16(AVC::HIGH_SPEED_BOOST));
+    else if(speed > AVC::LOW_SPEED_THRESHOLD) baseVolume = addSat(baseVolume, intToQ16(AVC::MEDIUM_SPEED_BOOST));
+    else if(speed > 0) baseVolume = addSat(baseVolume, intToQ16(AVC::LOW_SPEED_BOOST));
+
+    baseVolume = addSat(baseVolume, saturate32(static_cast<std::int64_t>(cabinNoise) * NOISE_SLOPE));
+
+    switch(mode) {
+        case Mode::ECO: baseVolume = mulQ16(baseVolume, ECO_MULTIPLIER); break;
+        case Mode::COMFORT: break;
+        case Mode::SPORTS: baseVolume = mulQ16(baseVolume, SPORTS_MULTIPLIER); break;
+    }
+
+    targetVolume = applyVolumeModifiers(baseVolume);
+}
+
+/**
+ * @brief Applies event-based volume modifiers and clamps.
+ * @param baseVolume Base volume before modifiers.
+ * @return Modified volume.
+ */
+q16_t FixedPointVolumeControl::applyVolumeModifiers(q16_t baseVolume) {
+    std::uint8_t modifiers = 0;
+    if(hornDuckActive) modifiers |= MODIFIER_HORN_DUCK;
+    if(navSpeaking) modifiers |= MODIFIER_NAVIGATION;
+    if(reverseGear) modifiers |= MODIFIER_REVERSE;
+    if(!reverseGear) {
+        int speedDiff = previousSpeed - speed;
+        if(speedDiff > AVC::SUDDEN_BRAKE_THRESHOLD) modifiers |= MODIFIER_SUDDEN_BRAKE;
+        else if(speed < previousSpeed) modifiers |= MODIFIER_SPEED_DECREASE;
+    }
+
+    if(modifiers & MODIFIER_HORN_DUCK) baseVolume = mulQ16Q15(baseVolume, HORN_DUCK_MULTIPLIER);
+    if(modifiers & MODIFIER_NAVIGATION) baseVolume = mulQ16Q15(baseVolume, NAV_DUCK_MULTIPLIER);
+    if(modifiers & MODIFIER_REVERSE) baseVolume = mulQ16Q15(baseVolume, REVERSE_MULTIPLIER);
+    if(modifiers & MODIFIER_SUDDEN_BRAKE) baseVolume = mulQ16Q15(baseVolume, SUDDEN_BRAKE_MULTIPLIER);
+    if(modifiers & MODIFIER_SPEED_DECREASE) baseVolume = mulQ16Q15(baseVolume, SPEED_DECREASE_MULTIPLIER);
+    activeModifiers = modifiers;
+
+    if(baseVolume < MIN_VOLUME) baseVolume = MIN_VOLUME;
+    if(baseVolume > MAX_ADAPTIVE_VOLUME) baseVolume = MAX_ADAPTIVE_VOLUME;
+    return baseVolume;
+}
+
+/**
+ * @brief Moves the current volume towards the target.
+ * @param factor Fraction of the remaining distance to cover.
+ */
+void FixedPointVolumeControl::smoothVolumeTransition(q15_t factor) {
+    q16_t diff = subSat(targetVolume, currentVolume);
+    currentVolume = addSat(currentVolume, mulQ16Q15(diff, factor));
+}
+
+/**
+ * @brief Sets the time covered by one tick().
+ * @param dt Seconds per tick.
+ */
+void FixedPointVolumeControl::setTickInterval(double dt) {
+    tickFactor = toQ15(1.0 - std::pow(1.0 - AVC::SMOOTH_FACTOR, dt / AVC::SMOOTH_INTERVAL));
+}
+
+/**
+ * @brief Checks whether the current volume has converged to the target.
+ * @return True if within SETTLE_THRESHOLD of the target volume.
+ */
+bool FixedPointVolumeControl::isSettled() const {
+    q16_t diff = subSat(currentVolume, targetVolume);
+    return (diff < 0 ? -diff : diff) <= SETTLE_THRESHOLD;
+}
+
+/**
+ * @brief Advances the smoothing by one tick interval; snaps once within SETTLE_THRESHOLD.
+ */
+void FixedPointVolumeControl::tick() {
+    if(!isSettled()) smoothVolumeTransition(tickFactor);
+    if(isSettled()) currentVolume = targetVolume;
+}
+
+/**
+ * @brief Converts a volume to a Q15 output gain (volume / MAX_VOLUME).
+ * @param volume Q16.16 volume.
+ * @return Q15 gain.
+ */
+q15_t FixedPointVolumeControl::volumeToGain(q16_t volume) {
+    return saturate16(saturate32(roundShift(static_cast<std::int64_t>(volume) * GAIN_PER_VOLUME, 24)));
+}
+
+/**
+ * @brief Ticks once and applies the volume to an interleaved Q15 block with a per-frame gain ramp.
+ * @param samples Interleaved Q15 samples, modified in place.
+ * @param n Number of frames.
+ * @param channels Number of interleaved channels.
+ */
+void FixedPointVolumeControl::processBlock(q15_t* samples, std::size_t n, int channels) {
+    if(n == 0) return;
+    q15_t startGain = volumeToGain(currentVolume);
+    tick();
+    q15_t endGain = volumeToGain(currentVolume);
+
+    // Gain at frame i is start + (end - start) * (i + 1) / n, accumulated in Q15.16
+    // (scaled by multiplication: the difference is negative while fading out)
+    std::int64_t step = (static_cast<std::int64_t>(endGain) - startGain) * Q16_ONE / static_cast<std::int64_t>(n);
+    std::int64_t gain = static_cast<std::int64_t>(startGain) * Q16_ONE;
+    for(std::size_t i = 0; i < n; ++i) {
+        gain += step;
+        q15_t g = i + 1 == n ? endGain : static_cast<q15_t>(gain >> 16);
+        for(int c = 0; c < channels; ++c, ++samples) *samples = mulQ15(*samples, g);
+    }
+}
@@ -0,0 +1,152 @@
+/**
+ * @file FixedPointVolumeControl.h
+ * @brief Defines the FixedPointVolumeControl class, an integer-only build of the adaptive policy.
+ */
+
+#ifndef FIXED_POINT_VOLUME_CONTROL_H
+#define FIXED_POINT_VOLUME_CONTROL_H
+
+#include "AdaptiveVolumeControl.h"
+#include "FixedPoint.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class FixedPointVolumeControl
+ * @brief AdaptiveVolumeControl policy in saturating Q15 / Q16.16 arithmetic for DSPs without an FPU.
+ *
+ * Volumes are Q16.16, multipliers below one (ducks, smoothing) are Q15 and
+ * the mode multipliers are Q16.16. The control path (update(), tick(),
+ * processBlock()) uses integer operations only and gives the same bits on
+ * every target. Constants are rounded to the nearest Q value, so results
+ * track the float controller to within FLOAT_TOLERANCE rather than
+ * bit-for-bit.
+ */
+class FixedPointVolumeControl {
+public:
+    using AVC = AdaptiveVolumeControl;
+
+    static constexpr q16_t DEFAULT_VOLUME = toQ16(AVC::DEFAULT_VOLUME);           ///< Initial/default volume
+    static constexpr q16_t MAX_VOLUME = toQ16(AVC::MAX_VOLUME);                   ///< Manual volume limit
+    static constexpr q16_t MAX_ADAPTIVE_VOLUME = toQ16(AVC::MAX_ADAPTIVE_VOLUME); ///< Adaptive volume limit
+    static constexpr q16_t MIN_VOLUME = toQ16(AVC::MIN_VOLUME);                   ///< Minimum volume
+    static constexpr q16_t BASE_VOLUME = toQ16(AVC::BASE_VOLUME);                 ///< Adaptive volume before speed/noise terms
+    static constexpr q16_t NOISE_SLOPE = toQ16(AVC::NOISE_SLOPE);                 ///< Volume per unit of cabin noise
+    static constexpr q16_t ECO_MULTIPLIER = toQ16(AVC::ECO_MULTIPLIER);           ///< Eco mode multiplier
+    static constexpr q16_t SPORTS_MULTIPLIER = toQ16(AVC::SPORTS_MULTIPLIER);     ///< Sports mode multiplier
+    static constexpr q15_t HORN_DUCK_MULTIPLIER = toQ15(AVC::HORN_DUCK_MULTIPLIER);           ///< Horn duck
+    static constexpr q15_t NAV_DUCK_MULTIPLIER = toQ15(AVC::NAV_DUCK_MULTIPLIER);             ///< Navigation duck
+    static constexpr q15_t REVERSE_MULTIPLIER = toQ15(AVC::REVERSE_MULTIPLIER);               ///< Reverse gear
+    static constexpr q15_t SUDDEN_BRAKE_MULTIPLIER = toQ15(AVC::SUDDEN_BRAKE_MULTIPLIER);     ///< Sudden brake
+    static constexpr q15_t SPEED_DECREASE_MULTIPLIER = toQ15(AVC::SPEED_DECREASE_MULTIPLIER); ///< Small speed decrease
+    static constexpr q15_t SMOOTH_FACTOR = toQ15(AVC::SMOOTH_FACTOR);             ///< Smoothing step per SMOOTH_INTERVAL
+    static constexpr q16_t SETTLE_THRESHOLD = toQ16(AVC::SETTLE_THRESHOLD);       ///< Distance considered settled
+    static constexpr float FLOAT_TOLERANCE = 0.01f; ///< Maximum deviation from the float controller (volume units)
+
+    /**
+     * @brief Constructor initializes the controller like AdaptiveVolumeControl.
+     * @param clock Time source for horn ducking.
+     */
+    explicit FixedPointVolumeControl(Clock& clock = SteadyClock::instance());
+
+    /**
+     * @brief Updates internal state and recalculates the target volume.
+     * @param newSpeed Current vehicle speed.
+     * @param newNoise Current cabin noise level.
+     * @param newReverseGear Reverse gear status.
+     * @param newHornActive Horn active status.
+     * @param newNavSpeaking Navigation speaking status.
+     * @param newMode Current driving mode.
+     * @param newControlType Volume control type (adaptive/manual).
+     * @param newManualVolume Manual volume value (if applicable).
+     */
+    void update(int newSpeed, int newNoise, bool newReverseGear, bool newHornActive,
+                bool newNavSpeaking, Mode newMode, VolumeControlType newControlType, int newManualVolume);
+
+    /**
+     * @brief Updates internal state from a packed set of inputs.
+     * @param inputs New inputs.
+     */
+    void update(const ControlInputs& inputs) {
+        update(inputs.speed, inputs.cabinNoise, inputs.reverseGear, inputs.hornActive, inputs.navSpeaking,
+               inputs.mode, inputs.controlType, inputs.manualVolume);
+    }
+
+    /**
+     * @brief Sets the time covered by one tick() (setup time; this is the only floating-point call).
+     * @param dt Seconds per tick, e.g. block frames / sample rate.
+     */
+    void setTickInterval(double dt);
+
+    /**
+     * @brief Advances the smoothing by one tick interval; snaps once within SETTLE_THRESHOLD.
+     */
+    void tick();
+
+    /**
+     * @brief Ticks once and applies the volume to an interleaved Q15 block with a per-frame gain ramp.
+     * @param samples Interleaved Q15 samples, modified in place.
+     * @param n Number of frames.
+     * @param channels Number of interleaved channels.
+     */
+    void processBlock(q15_t* samples, std::size_t n, int channels);
+
+    /**
+     * @brief Checks whether the current volume has converged to the target.
+     * @return True if within SETTLE_THRESHOLD of the target volume.
+     */
+    bool isSettled() const;
+
+    q16_t getTargetVolumeQ16() const { return targetVolume; }                    ///< @return Target volume (Q16.16)
+    q16_t getCurrentVolumeQ16() const { return currentVolume; }                  ///< @return Current volume (Q16.16)
+    float getTargetVolume() const { return q16ToFloat(targetVolume); }           ///< @return Target volume
+    float getCurrentVolume() const { return q16ToFloat(currentVolume); }         ///< @return Current volume
+    std::uint8_t getActiveModifiers() const { return activeModifiers; }          ///< @return VolumeModifier bits applied
+
+    /**
+     * @brief Converts a volume to a Q15 output gain (volume / MAX_VOLUME).
+     * @param volume Q16.16 volume.
+     * @return Q15 gain.
+     */
+    static q15_t volumeToGain(q16_t volume);
+
+protected:
+    int speed;                                  ///< Current speed
+    int previousSpeed;                          ///< Previous speed
+    int cabinNoise;                             ///< Current cabin noise
+    bool reverseGear;                           ///< Reverse gear status
+    bool hornActive;                            ///< Horn active status
+    bool navSpeaking;                           ///< Navigation speaking status
+    Mode mode;                                  ///< Current driving mode
+    VolumeControlType controlType;              ///< Volume control type
+    int manualVolume;                           ///< Manual volume value
+
+    q16_t targetVolume;                         ///< Target volume
+    q16_t currentVolume;                        ///< Current volume
+    q15_t tickFactor;                           ///< Smoothing factor per tick
+
+    Clock* clock;                               ///< Time source for horn ducking
+    bool hornDuckActive;                        ///< Horn ducking active flag
+    Clock::time_point hornDuckStartTime;        ///< Last frame the horn was active
+    std::uint8_t activeModifiers;               ///< VolumeModifier bits applied to the target
+
+    /**
+     * @brief Calculates the target volume based on current state.
+     */
+    void calculateTargetVolume();
+
+    /**
+     * @brief Applies event-based volume modifiers and clamps.
+     * @param baseVolume Base volume before modifiers.
+     * @return Modified volume.
+     */
+    q16_t applyVolumeModifiers(q16_t baseVolume);
+
+    /**
+     * @brief Moves the current volume towards the target.
+     * @param factor Fraction of the remaining distance to cover.
+     */
+    void smoothVolumeTransition(q15_t factor);
+};
+
+#endif // FIXED_POINT_VOLUME_CONTROL_H
@@ -0,0 +1,89 @@
+/**
+ * @file FormatBuffer.h
+ * @brief Defines a fixed-capacity text buffer for building log lines without heap allocation.
+ */
+
+#ifndef FORMAT_BUFFER_H
+#define FORMAT_BUFFER_H
+
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string_view>
+
+/**
+ * @class FormatBuffer
+ * @brief Appends text and integers into storage owned by the object, then writes it out in one call.
+ *
+ * Replaces chains of std::ostream operator<< (one virtual call and locale
+ * lookup per piece) with memcpy and std::to_chars. Output that does not fit
+ * is dropped and reported by truncated(); flushTo() then ends the text with
+ * TRUNCATION_MARKER and counts the line in truncations(). Nothing is ever
+ * allocated.
+ */
+class FormatBuffer {
+public:
+    static constexpr std::size_t CAPACITY = 1024; ///< Bytes held between flushes
+    static constexpr std::string_view TRUNCATION_MARKER = "...[truncated]\n"; ///< Replaces the tail of a flushed truncated text
+
+    /**
+     * @brief Appends text.
+     * @param text Characters to copy.
+     * @return This buffer.
+     */
+    FormatBuffer& operator<<(std::string_view text) {
+        std::size_t room = CAPACITY - length;
+        std::size_t n = text.size() <= room ? text.size() : room;
+        if(n < text.size()) overflow = true;
+        if(n) std::memcpy(data + length, text.data(), n);
+        length += n;
+        return *this;
+    }
+
+    /**
+     * @brief Appends text.
+     * @param text Zero-terminated characters to copy.
+     * @return This buffer.
+     */
+    FormatBuffer& operator<<(const char* text) { return *this << std::string_view(text); }
+
+    /**
+     * @brief Appends an integer in decimal.
+     * @param value Value to format.
+     * @return This buffer.
+     */
+    FormatBuffer& operator<<(int value) {
+        char digits[12];
+        std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+        return *this << std::string_view(digits, static_cast<std::size_t>(result.ptr - digits));
+    }
+
+    /**
+     * @brief Writes the buffered text to a stream and empties the buffer.
+     *
+     * A truncated text (always full) ends with TRUNCATION_MARKER instead of its last bytes.
+     * @param out Destination stream.
+     */
+    void flushTo(std::ostream& out) {
+        if(overflow) {
+            std::memcpy(data + CAPACITY - TRUNCATION_MARKER.size(), TRUNCATION_MARKER.data(), TRUNCATION_MARKER.size());
+            ++truncatedFlushes;
+        }
+        out.write(data, static_cast<std::streamsize>(length));
+        clear();
+    }
+
+    void clear() { length = 0; overflow = false; }                      ///< Empties the buffer
+    std::string_view view() const { return std::string_view(data, length); } ///< @return Buffered text
+    bool truncated() const { return overflow; }                         ///< @return True if text was dropped since the last clear
+    std::size_t truncations() const { return truncatedFlushes; }        ///< @return Truncated texts flushed so far (never reset)
+
+private:
+    char data[CAPACITY];      ///< Buffered text
+    std::size_t length = 0;   ///< Bytes in use
+    bool overflow = false;    ///< Set when an append did not fit
+    std::size_t truncatedFlushes = 0; ///< Flushes that wrote a truncated text
+};
+
+#endif // FORMAT_BUFFER_H
@@ -0,0 +1,222 @@
+/**
+ * @file GainRamp.cpp
+ * @brief Implements the vectorized per-sample gain ramp with runtime dispatch.
+ */
+
+#include "GainRamp.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GAIN_RAMP_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define GAIN_RAMP_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+constexpr int MAX_SIMD_CHANNELS = 16; ///< Channel counts above this use the scalar path
+
+using RampFunction = void (*)(float*, std::size_t, int, float, float);
+
+/**
+ * @brief Scales frames [first, frames) of an interleaved buffer along the ramp.
+ * @param samples Interleaved samples.
+ * @param first First frame to process.
+ * @param frames Total number of frames.
+ * @param channels Number of interleaved channels.
+ * @param startGain Gain before frame 0.
+ * @param step Gain increment per frame.
+ */
+void rampFrames(float* samples, std::size_t first, std::size_t frames, int channels,
+                float startGain, float step) {
+    for(std::size_t i = first; i < frames; ++i) {
+        float gain = startGain + step * static_cast<float>(i + 1);
+        float* frame = samples + i * channels;
+        for(int ch = 0; ch < channels; ++ch) frame[ch] *= gain;
+    }
+}
+
+/**
+ * @brief Builds the frame offset pattern of one chunk of `lanes` frames.
+ *
+ * A chunk of `lanes` frames spans exactly `channels` vectors; lane j of vector k
+ * belongs to frame (k * lanes + j) / channels of the chunk. The pattern is the
+ * same for every chunk, so the kernels only add the chunk's first frame index.
+ *
+ * @param offsets Output table of channels * lanes entries (1-based frame offsets).
+ * @param channels Number of interleaved channels.
+ * @param lanes Vector width in floats.
+ */
+void buildOffsets(float* offsets, int channels, int lanes) {
+    for(int k = 0; k < channels * lanes; ++k) offsets[k] = static_cast<float>(k / channels + 1);
+}
+
+#if GAIN_RAMP_X86
+/**
+ * @brief SSE2 kernel (4 lanes).
+ */
+void rampSse2(float* samples, std::size_t frames, int channels, float startGain, float step) {
+    constexpr int W = 4;
+    alignas(32) float offsets[MAX_SIMD_CHANNELS * W];
+    buildOffsets(offsets, channels, W);
+
+    const __m128 vstart = _mm_set1_ps(startGain);
+    const __m128 vstep = _mm_set1_ps(step);
+    std::size_t chunks = frames / W;
+    for(std::size_t c = 0; c < chunks; ++c) {
+        const __m128 vbase = _mm_set1_ps(static_cast<float>(c * W));
+        float* p = samples + c * W * channels;
+        for(int k = 0; k < channels; ++k) {
+            __m128 index = _mm_add_ps(vbase, _mm_load_ps(offsets + k * W));
+            __m128 gain = _mm_add_ps(vstart, _mm_mul_ps(vstep, index));
+            _mm_storeu_ps(p + k * W, _mm_mul_ps(_mm_loadu_ps(p + k * W), gain));
+        }
+    }
+    rampFrames(samples, chunks * W, frames, channels, startGain, step);
+}
+
+#if defined(__GNUC__)
+/**
+ * @brief AVX2 kernel (8 lanes), compiled for AVX2 regardless of the baseline flags.
+ */
+__attribute__((target("avx2")))
+void rampAvx2(float* samples, std::size_t frames, int channels, float startGain, float step) {
+    constexpr int W = 8;
+    alignas(32) float offsets[MAX_SIMD_CHANNELS * W];
+    buildOffsets(offsets, channels, W);
+
+    const __m256 vstart = _mm256_set1_ps(startGain);
+    const __m256 vstep = _mm256_set1_ps(step);
+    std::size_t chunks = frames / W;
+    for(std::size_t c = 0; c < chunks; ++c) {
+        const __m256 vbase = _mm256_set1_ps(static_cast<float>(c * W));
+        float* p = samples + c * W * channels;
+        for(int k = 0; k < channels; ++k) {
+            __m256 index = _mm256_add_ps(vbase, _mm256_load_ps(offsets + k * W));
+            __m256 gain = _mm256_add_ps(vstart, _mm256_mul_ps(vstep, index));
+            _mm256_storeu_ps(p + k * W, _mm256_mul_ps(_mm256_loadu_ps(p + k * W), gain));
+        }
+    }
+    rampFrames(samples, chunks * W, frames, channels, startGain, step);
+}
+#endif
+#endif // GAIN_RAMP_X86
+
+#if GAIN_RAMP_NEON
+/**
+ * @brief NEON kernel (4 lanes). Multiply and add are kept separate to match the scalar rounding.
+ */
+void rampNeon(float* samples, std::size_t frames, int channels, float startGain, float step) {
+    constexpr int W = 4;
+    alignas(16) float offsets[MAX_SIMD_CHANNELS * W];
+    buildOffsets(offsets, channels, W);
+
+    const float32x4_t vstart = vdupq_n_f32(startGain);
+    const float32x4_t vstep = vdupq_n_f32(step);
+    std::size_t chunks = frames / W;
+    for(std::size_t c = 0; c < chunks; ++c) {
+        const float32x4_t vbase = vdupq_n_f32(static_cast<float>(c * W));
+        float* p = samples + c * W * channels;
+        for(int k = 0; k < channels; ++k) {
+            float32x4_t index = vaddq_f32(vbase, vld1q_f32(offsets + k * W));
+            float32x4_t gain = vaddq_f32(vstart, vmulq_f32(vstep, index));
+            vst1q_f32(p + k * W, vmulq_f32(vld1q_f32(p + k * W), gain));
+        }
+    }
+    rampFrames(samples, chunks * W, frames, channels, startGain, step);
+}
+#endif
+
+/**
+ * @brief Scalar kernel used when no vector unit is available.
+ */
+void rampScalar(float* samples, std::size_t frames, int channels, float startGain, float step) {
+    rampFrames(samples, 0, frames, channels, startGain, step);
+}
+
+/**
+ * @brief The selected kernel and its name.
+ */
+struct RampKernel {
+    RampFunction function; ///< Kernel entry point
+    const char* name;      ///< Implementation name
+};
+
+/**
+ * @brief Picks the widest kernel supported by the running CPU.
+ * @return Selected kernel.
+ */
+RampKernel selectKernel() {
+#if GAIN_RAMP_X86
+#if defined(__GNUC__)
+    if(__builtin_cpu_supports("avx2")) return {rampAvx2, "avx2"};
+#endif
+    return {rampSse2, "sse2"};
+#elif GAIN_RAMP_NEON
+    return {rampNeon, "neon"};
+#else
+    return {rampScalar, "scalar"};
+#endif
+}
+
+/**
+ * @brief Gets the kernel resolved on first use.
+ * @return Selected kernel.
+ */
+const RampKernel& kernel() {
+    static const RampKernel selected = selectKernel();
+    return selected;
+}
+
+/**
+ * @brief Scales the last frame by endGain itself, not by the accumulated ramp value.
+ * @param samples Interleaved samples.
+ * @param frames Number of frames (at least 1).
+ * @param channels Number of interleaved channels.
+ * @param endGain Gain of the last frame.
+ */
+void scaleLastFrame(float* samples, std::size_t frames, int channels, float endGain) {
+    float* frame = samples + (frames - 1) * channels;
+    for(int ch = 0; ch < channels; ++ch) frame[ch] *= endGain;
+}
+
+} // namespace
+
+/**
+ * @brief Multiplies interleaved samples by a linear gain ramp using the dispatched kernel.
+ * @param samples Interleaved samples, modified in place.
+ * @param frames Number of frames (samples per channel).
+ * @param channels Number of interleaved channels.
+ * @param startGain Gain in effect before the first frame.
+ * @param endGain Gain reached on the last frame.
+ */
+void applyGainRamp(float* samples, std::size_t frames, int channels, float startGain, float endGain) {
+    if(frames == 0 || channels <= 0) return;
+    float step = (endGain - startGain) / static_cast<float>(frames);
+    if(channels > MAX_SIMD_CHANNELS) rampScalar(samples, frames - 1, channels, startGain, step);
+    else kernel().function(samples, frames - 1, channels, startGain, step);
+    scaleLastFrame(samples, frames, channels, endGain);
+}
+
+/**
+ * @brief Scalar reference implementation of applyGainRamp().
+ * @param samples Interleaved samples, modified in place.
+ * @param frames Number of frames (samples per channel).
+ * @param channels Number of interleaved channels.
+ * @param startGain Gain in effect before the first frame.
+ * @param endGain Gain reached on the last frame.
+ */
+void applyGainRampScalar(float* samples, std::size_t frames, int channels, float startGain, float endGain) {
+    if(frames == 0 || channels <= 0) return;
+    rampScalar(samples, frames - 1, channels, startGain, (endGain - startGain) / static_cast<float>(frames));
+    scaleLastFrame(samples, frames, channels, endGain);
+}
+
+/**
+ * @brief Gets the name of the implementation selected by runtime dispatch.
+ * @return Implementation name.
+ */
+const char* gainRampImplementation() {
+    return kernel().name;
+}
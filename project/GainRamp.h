@@ -0,0 +1,44 @@
+/**
+ * @file GainRamp.h
+ * @brief Declares the per-sample gain ramp applied to interleaved PCM buffers.
+ */
+
+#ifndef GAIN_RAMP_H
+#define GAIN_RAMP_H
+
+#include <cstddef>
+
+/**
+ * @brief Multiplies interleaved samples by a gain ramping linearly between two values.
+ *
+ * Frame i (0-based) of n is scaled by startGain + (endGain - startGain) * (i + 1) / n.
+ * The last frame is scaled by endGain itself rather than the accumulated value, so it
+ * lands exactly on endGain and consecutive blocks join without steps.
+ * The inner loop is vectorized (SSE2/AVX2/NEON) and the best implementation is chosen
+ * at runtime; all implementations produce bit-identical results.
+ *
+ * @param samples Interleaved samples, modified in place.
+ * @param frames Number of frames (samples per channel).
+ * @param channels Number of interleaved channels.
+ * @param startGain Gain in effect before the first frame.
+ * @param endGain Gain reached on the last frame.
+ */
+void applyGainRamp(float* samples, std::size_t frames, int channels, float startGain, float endGain);
+
+/**
+ * @brief Scalar reference implementation of applyGainRamp().
+ * @param samples Interleaved samples, modified in place.
+ * @param frames Number of frames (samples per channel).
+ * @param channels Number of interleaved channels.
+ * @param startGain Gain in effect before the first frame.
+ * @param endGain Gain reached on the last frame.
+ */
+void applyGainRampScalar(float* samples, std::size_t frames, int channels, float startGain, float endGain);
+
+/**
+ * @brief Gets the name of the implementation selected by runtime dispatch.
+ * @return "avx2", "sse2", "neon" or "scalar".
+ */
+const char* gainRampImplementation();
+
+#endif // GAIN_RAMP_H
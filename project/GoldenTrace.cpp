@@ -0,0 +1,188 @@
+/**
+ * @file GoldenTrace.cpp
+ * @brief Implements the golden trace reader, writer and the vectorized comparison.
+ */
+
+#include "GoldenTrace.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GOLDEN_TRACE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr char GOLDEN_TRACE_MAGIC[4] = {'A', 'V', 'G', 'T'}; ///< Golden file signature
+
+constexpr float INVALID_ERROR = std::numeric_limits<float>::infinity(); ///< Error reported for NaN frames
+
+/**
+ * @brief Absolute difference of one frame, infinity if it is NaN.
+ * @return Frame error.
+ */
+inline float frameError(float expected, float actual) {
+    float error = std::fabs(actual - expected);
+    return error != error ? INVALID_ERROR : error;
+}
+
+/**
+ * @brief Finds the first frame whose error equals the maximum.
+ * @return Frame index (0 if every error is zero).
+ */
+std::size_t findMaxIndex(const float* expected, const float* actual, std::size_t count, float maxError) {
+    if(maxError == 0.0f) return 0;
+    for(std::size_t i = 0; i < count; ++i)
+        if(frameError(expected[i], actual[i]) == maxError) return i;
+    return 0;
+}
+
+/**
+ * @brief Number of set bits in a 4-bit movemask.
+ */
+inline int countLanes(int mask) {
+    return (mask & 1) + (mask >> 1 & 1) + (mask >> 2 & 1) + (mask >> 3 & 1);
+}
+
+} // namespace
+
+/**
+ * @brief Maps and validates a golden file.
+ * @param path Golden file to open.
+ * @return True if the file is complete and of a supported version.
+ */
+bool GoldenTraceView::open(const std::string& path) {
+    target = current = nullptr;
+    count = 0;
+    if(!file.open(path) || file.size() < sizeof(GoldenTraceHeader)) return false;
+
+    GoldenTraceHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if(std::memcmp(header.magic, GOLDEN_TRACE_MAGIC, sizeof(header.magic)) != 0 ||
+       header.version != GOLDEN_TRACE_VERSION ||
+       header.frameCount > (file.size() - sizeof(header)) / (2 * sizeof(float))) {
+        file.close();
+        return false;
+    }
+
+    file.adviseSequential();
+    count = static_cast<std::size_t>(header.frameCount);
+    target = reinterpret_cast<const float*>(file.data() + sizeof(header));
+    current = target + count;
+    return true;
+}
+
+/**
+ * @brief Writes a golden file.
+ * @param path File to create (or truncate).
+ * @param targetVolume Target volume per frame.
+ * @param currentVolume Current volume per frame.
+ * @param count Number of frames.
+ * @return True if the whole file was written.
+ */
+bool writeGoldenTrace(const std::string& path, const float* targetVolume, const float* currentVolume,
+                      std::size_t count) {
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if(!out) return false;
+
+    GoldenTraceHeader header{};
+    std::memcpy(header.magic, GOLDEN_TRACE_MAGIC, sizeof(header.magic));
+    header.version = GOLDEN_TRACE_VERSION;
+    header.frameCount = count;
+    bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+              std::fwrite(targetVolume, sizeof(float), count, out) == count &&
+              std::fwrite(currentVolume, sizeof(float), count, out) == count;
+    return std::fclose(out) == 0 && ok;
+}
+
+/**
+ * @brief Compares a trace against its golden column, four frames at a time.
+ * @param expected Golden values.
+ * @param actual Values produced by the build under test.
+ * @param count Number of frames.
+ * @param tolerance Largest difference accepted per frame.
+ * @return Error summary.
+ */
+TraceDiff diffTraces(const float* expected, const float* actual, std::size_t count, float tolerance) {
+#if GOLDEN_TRACE_SSE2
+    TraceDiff diff;
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 invalidError = _mm_set1_ps(INVALID_ERROR);
+    const __m128 limit = _mm_set1_ps(tolerance);
+    __m128 maxError = _mm_setzero_ps();
+    __m128d sumLow = _mm_setzero_pd(), sumHigh = _mm_setzero_pd();
+
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        __m128 error = _mm_andnot_ps(signMask, _mm_sub_ps(_mm_loadu_ps(actual + i), _mm_loadu_ps(expected + i)));
+        __m128 invalid = _mm_cmpunord_ps(error, error);
+        __m128 finite = _mm_andnot_ps(invalid, error);
+        error = _mm_or_ps(_mm_and_ps(invalid, invalidError), finite);
+
+        maxError = _mm_max_ps(maxError, error);
+        diff.exceeding += countLanes(_mm_movemask_ps(_mm_cmpgt_ps(error, limit)));
+        diff.invalid += countLanes(_mm_movemask_ps(invalid));
+        sumLow = _mm_add_pd(sumLow, _mm_cvtps_pd(finite));
+        sumHigh = _mm_add_pd(sumHigh, _mm_cvtps_pd(_mm_movehl_ps(finite, finite)));
+    }
+
+    alignas(16) float lanes[4];
+    alignas(16) double sums[2];
+    _mm_store_ps(lanes, maxError);
+    _mm_store_pd(sums, _mm_add_pd(sumLow, sumHigh));
+    for(float lane : lanes) if(lane > diff.maxError) diff.maxError = lane;
+    double sum = sums[0] + sums[1];
+
+    for(; i < count; ++i) {
+        float error = std::fabs(actual[i] - expected[i]);
+        if(error != error) {
+            error = INVALID_ERROR;
+            ++diff.invalid;
+        } else {
+            sum += error;
+        }
+        if(error > tolerance) ++diff.exceeding;
+        if(error > diff.maxError) diff.maxError = error;
+    }
+
+    diff.maxIndex = findMaxIndex(expected, actual, count, diff.maxError);
+    std::size_t valid = count - diff.invalid;
+    diff.meanError = valid ? sum / static_cast<double>(valid) : 0.0;
+    return diff;
+#else
+    return diffTracesScalar(expected, actual, count, tolerance);
+#endif
+}
+
+/**
+ * @brief Scalar reference implementation of diffTraces().
+ * @param expected Golden values.
+ * @param actual Values produced by the build under test.
+ * @param count Number of frames.
+ * @param tolerance Largest difference accepted per frame.
+ * @return Error summary.
+ */
+TraceDiff diffTracesScalar(const float* expected, const float* actual, std::size_t count, float tolerance) {
+    TraceDiff diff;
+    double sum = 0.0;
+    for(std::size_t i = 0; i < count; ++i) {
+        float error = std::fabs(actual[i] - expected[i]);
+        if(error != error) {
+            error = INVALID_ERROR;
+            ++diff.invalid;
+        } else {
+            sum += error;
+        }
+        if(error > tolerance) ++diff.exceeding;
+        if(error > diff.maxError) {
+            diff.maxError = error;
+            diff.maxIndex = i;
+        }
+    }
+    std::size_t valid = count - diff.invalid;
+    diff.meanError = valid ? sum / static_cast<double>(valid) : 0.0;
+    return diff;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file GoldenTrace.h
+ * @brief Defines the golden volume-trace format and the vectorized trace comparison.
+ */
+
+#ifndef GOLDEN_TRACE_H
+#define GOLDEN_TRACE_H
+
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @struct GoldenTraceHeader
+ * @brief Fixed header of a golden file, followed by frameCount target volumes, then frameCount current volumes.
+ *
+ * The two planar float columns are compared in place from the mapping.
+ */
+struct GoldenTraceHeader {
+    char magic[4];              ///< "AVGT"
+    std::uint32_t version;      ///< Format version (GOLDEN_TRACE_VERSION)
+    std::uint64_t frameCount;   ///< Entries in each column
+};
+
+static_assert(sizeof(GoldenTraceHeader) == 16, "golden header layout is fixed");
+
+constexpr std::uint32_t GOLDEN_TRACE_VERSION = 1; ///< Current golden format version
+
+/**
+ * @class GoldenTraceView
+ * @brief Zero-copy view of a golden file mapped into memory.
+ */
+class GoldenTraceView {
+public:
+    /**
+     * @brief Maps and validates a golden file.
+     * @param path Golden file to open.
+     * @return True if the file is complete and of a supported version.
+     */
+    bool open(const std::string& path);
+
+    const float* targetVolume() const { return target; }    ///< @return Target volume column
+    const float* currentVolume() const { return current; }  ///< @return Current volume column
+    std::size_t size() const { return count; }              ///< @return Frames in the trace
+
+private:
+    MappedFile file;                 ///< Mapped golden file
+    const float* target = nullptr;   ///< Target column inside the mapping
+    const float* current = nullptr;  ///< Current column inside the mapping
+    std::size_t count = 0;           ///< Frames in the trace
+};
+
+/**
+ * @brief Writes a golden file.
+ * @param path File to create (or truncate).
+ * @param targetVolume Target volume per frame.
+ * @param currentVolume Current volume per frame.
+ * @param count Number of frames.
+ * @return True if the whole file was written.
+ */
+bool writeGoldenTrace(const std::string& path, const float* targetVolume, const float* currentVolume,
+                      std::size_t count);
+
+/**
+ * @struct TraceDiff
+ * @brief Error summary of one trace against its golden column.
+ */
+struct TraceDiff {
+    float maxError = 0.0f;      ///< Largest absolute difference (infinity if either side is NaN)
+    double meanError = 0.0;     ///< Mean absolute difference over finite frames
+    std::size_t maxIndex = 0;   ///< First frame with maxError
+    std::size_t exceeding = 0;  ///< Frames whose difference is above the tolerance (NaN frames included)
+    std::size_t invalid = 0;    ///< Frames where either side is NaN
+};
+
+/**
+ * @brief Compares a trace against its golden column, four frames at a time.
+ *
+ * Uses SSE2 on x86 and the scalar loop elsewhere. maxError, maxIndex and
+ * exceeding equal those of diffTracesScalar(); meanError is accumulated in
+ * double precision in a different order and agrees to rounding.
+ * @param expected Golden values.
+ * @param actual Values produced by the build under test.
+ * @param count Number of frames.
+ * @param tolerance Largest difference accepted per frame.
+ * @return Error summary.
+ */
+TraceDiff diffTraces(const float* expected, const float* actual, std::size_t count, float tolerance);
+
+/**
+ * @brief Scalar reference implementation of diffTraces().
+ * @param expected Golden values.
+ * @param actual Values produced by the build under test.
+ * @param count Number of frames.
+ * @param tolerance Largest difference accepted per frame.
+ * @return Error summary.
+ */
+TraceDiff diffTracesScalar(const float* expected, const float* actual, std::size_t count, float tolerance);
+
+#endif // GOLDEN_TRACE_H
@@ -0,0 +1,240 @@
+/**
+ * @file InputMailbox.h
+ * @brief Defines the InputMailbox class for wait-free publication of controller inputs across threads.
+ */
+
+#ifndef INPUT_MAILBOX_H
+#define INPUT_MAILBOX_H
+
+#include "AdaptiveVolumeControl.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class InputMailbox
+ * @brief Latest-value mailbox between sensor threads and the audio thread.
+ *
+ * Each producer owns one slot on its own cache line: the CAN reader (speed,
+ * reverse gear, horn), the microphone analyzer (cabin noise), the nav engine
+ * and the HMI (mode, control type and manual volume). A slot has its own
+ * sequence counter, so producers never write a shared line and never wait
+ * on anyone. Every slot has exactly one writer thread.
+ *
+ * A slot is a seqlock: the writer makes the sequence odd, stores the fields
+ * and makes it even again. The consumer reads each slot until it sees the
+ * same even sequence before and after the fields, so the fields of one slot
+ * always come from the same publication. It retries only while that slot's
+ * producer is in the middle of its few stores; it never takes a lock.
+ */
+class InputMailbox {
+public:
+    /**
+     * @brief Constructor starts with the inputs of a freshly constructed controller.
+     * @param initial Initial inputs.
+     */
+    explicit InputMailbox(const ControlInputs& initial = ControlInputs{}) {
+        vehicle.speed.store(initial.speed, std::memory_order_relaxed);
+        vehicle.reverseGear.store(initial.reverseGear, std::memory_order_relaxed);
+        vehicle.hornActive.store(initial.hornActive, std::memory_order_relaxed);
+        microphone.cabinNoise.store(initial.cabinNoise, std::memory_order_relaxed);
+        nav.navSpeaking.store(initial.navSpeaking, std::memory_order_relaxed);
+        hmi.mode.store(static_cast<std::uint8_t>(initial.mode), std::memory_order_relaxed);
+        hmi.controlType.store(static_cast<std::uint8_t>(initial.controlType), std::memory_order_relaxed);
+        hmi.manualVolume.store(initial.manualVolume, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Publishes one CAN frame (speed, reverse gear and horn) as one unit.
+     * @param speed Vehicle speed.
+     * @param reverseGear Reverse gear status.
+     * @param hornActive Horn active status.
+     */
+    void publishVehicle(int speed, bool reverseGear, bool hornActive) {
+        std::uint64_t sequence = beginWrite(vehicle.sequence);
+        vehicle.speed.store(speed, std::memory_order_relaxed);
+        vehicle.reverseGear.store(reverseGear, std::memory_order_relaxed);
+        vehicle.hornActive.store(hornActive, std::memory_order_relaxed);
+        endWrite(vehicle.sequence, sequence);
+    }
+
+    // Single CAN signals; call from the CAN thread, the only writer of that slot
+    void publishSpeed(int value) { publishVehicle(value, vehicle.reverseGear.load(std::memory_order_relaxed), vehicle.hornActive.load(std::memory_order_relaxed)); } ///< @param value Vehicle speed
+    void publishReverseGear(bool value) { publishVehicle(vehicle.speed.load(std::memory_order_relaxed), value, vehicle.hornActive.load(std::memory_order_relaxed)); } ///< @param value Reverse gear status
+    void publishHorn(bool value) { publishVehicle(vehicle.speed.load(std::memory_order_relaxed), vehicle.reverseGear.load(std::memory_order_relaxed), value); } ///< @param value Horn active status
+
+    /**
+     * @brief Publishes the cabin noise level (microphone analyzer).
+     * @param value Cabin noise level.
+     */
+    void publishCabinNoise(int value) {
+        std::uint64_t sequence = beginWrite(microphone.sequence);
+        microphone.cabinNoise.store(value, std::memory_order_relaxed);
+        endWrite(microphone.sequence, sequence);
+    }
+
+    /**
+     * @brief Publishes the navigation prompt status (nav engine).
+     * @param value Navigation speaking status.
+     */
+    void publishNavSpeaking(bool value) {
+        std::uint64_t sequence = beginWrite(nav.sequence);
+        nav.navSpeaking.store(value, std::memory_order_relaxed);
+        endWrite(nav.sequence, sequence);
+    }
+
+    /**
+     * @brief Publishes the user settings (HMI) as one unit.
+     * @param mode Driving mode.
+     * @param controlType Volume control type.
+     * @param manualVolume Manual volume value.
+     */
+    void publishSettings(Mode mode, VolumeControlType controlType, int manualVolume) {
+        std::uint64_t sequence = beginWrite(hmi.sequence);
+        hmi.mode.store(static_cast<std::uint8_t>(mode), std::memory_order_relaxed);
+        hmi.controlType.store(static_cast<std::uint8_t>(controlType), std::memory_order_relaxed);
+        hmi.manualVolume.store(manualVolume, std::memory_order_relaxed);
+        endWrite(hmi.sequence, sequence);
+    }
+
+    /**
+     * @brief Reads the latest publication of every producer.
+     *
+     * Each slot is read consistently; different slots may come from
+     * publications made at slightly different times.
+     * @return Snapshot to pass to AdaptiveVolumeControl::update().
+     */
+    ControlInputs snapshot() const {
+        ControlInputs inputs;
+        std::uint64_t sequence;
+        do {
+            sequence = beginRead(vehicle.sequence);
+            inputs.speed = vehicle.speed.load(std::memory_order_relaxed);
+            inputs.reverseGear = vehicle.reverseGear.load(std::memory_order_relaxed);
+            inputs.hornActive = vehicle.hornActive.load(std::memory_order_relaxed);
+        } while(!endRead(vehicle.sequence, sequence));
+        do {
+            sequence = beginRead(microphone.sequence);
+            inputs.cabinNoise = microphone.cabinNoise.load(std::memory_order_relaxed);
+        } while(!endRead(microphone.sequence, sequence));
+        do {
+            sequence = beginRead(nav.sequence);
+            inputs.navSpeaking = nav.navSpeaking.load(std::memory_order_relaxed);
+        } while(!endRead(nav.sequence, sequence));
+        do {
+            sequence = beginRead(hmi.sequence);
+            inputs.mode = static_cast<Mode>(hmi.mode.load(std::memory_order_relaxed));
+            inputs.controlType = static_cast<VolumeControlType>(hmi.controlType.load(std::memory_order_relaxed));
+            inputs.manualVolume = hmi.manualVolume.load(std::memory_order_relaxed);
+        } while(!endRead(hmi.sequence, sequence));
+        return inputs;
+    }
+
+    /**
+     * @brief Gets the number of publications, summed over the producers' own counters.
+     *
+     * Lets the consumer skip work when nothing was published since its last
+     * snapshot: compare against the value read before taking that snapshot.
+     * @return Number of publications so far (wraps around).
+     */
+    std::uint32_t getVersion() const {
+        return static_cast<std::uint32_t>((vehicle.sequence.load(std::memory_order_acquire) >> 1) +
+                                          (microphone.sequence.load(std::memory_order_acquire) >> 1) +
+                                          (nav.sequence.load(std::memory_order_acquire) >> 1) +
+                                          (hmi.sequence.load(std::memory_order_acquire) >> 1));
+    }
+
+private:
+    /**
+     * @struct VehicleSlot
+     * @brief Signals of the CAN reader.
+     */
+    struct alignas(64) VehicleSlot {
+        std::atomic<std::uint64_t> sequence{0};     ///< Seqlock sequence (odd while writing)
+        std::atomic<std::int32_t> speed{0};         ///< Vehicle speed
+        std::atomic<bool> reverseGear{false};       ///< Reverse gear status
+        std::atomic<bool> hornActive{false};        ///< Horn active status
+    };
+
+    /**
+     * @struct NoiseSlot
+     * @brief Signal of the microphone analyzer.
+     */
+    struct alignas(64) NoiseSlot {
+        std::atomic<std::uint64_t> sequence{0};     ///< Seqlock sequence (odd while writing)
+        std::atomic<std::int32_t> cabinNoise{0};    ///< Cabin noise level
+    };
+
+    /**
+     * @struct NavSlot
+     * @brief Signal of the nav engine.
+     */
+    struct alignas(64) NavSlot {
+        std::atomic<std::uint64_t> sequence{0};     ///< Seqlock sequence (odd while writing)
+        std::atomic<bool> navSpeaking{false};       ///< Navigation speaking status
+    };
+
+    /**
+     * @struct SettingsSlot
+     * @brief User settings of the HMI.
+     */
+    struct alignas(64) SettingsSlot {
+        std::atomic<std::uint64_t> sequence{0};     ///< Seqlock sequence (odd while writing)
+        std::atomic<std::uint8_t> mode{0};          ///< Driving mode
+        std::atomic<std::uint8_t> controlType{0};   ///< Volume control type
+        std::atomic<std::int32_t> manualVolume{0};  ///< Manual volume value
+    };
+
+    /**
+     * @brief Marks a slot as being written (its single writer only).
+     * @param sequence Slot sequence.
+     * @return Sequence before the write.
+     */
+    static std::uint64_t beginWrite(std::atomic<std::uint64_t>& sequence) {
+        std::uint64_t value = sequence.load(std::memory_order_relaxed);
+        sequence.store(value + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release); // odd sequence before any field
+        return value;
+    }
+
+    /**
+     * @brief Publishes a written slot.
+     * @param sequence Slot sequence.
+     * @param value Value returned by beginWrite().
+     */
+    static void endWrite(std::atomic<std::uint64_t>& sequence, std::uint64_t value) {
+        sequence.store(value + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Waits until a slot is not being written.
+     * @param sequence Slot sequence.
+     * @return Even sequence the fields are read under.
+     */
+    static std::uint64_t beginRead(const std::atomic<std::uint64_t>& sequence) {
+        std::uint64_t value;
+        while((value = sequence.load(std::memory_order_acquire)) & 1) {}
+        return value;
+    }
+
+    /**
+     * @brief Checks that no write overlapped the field reads.
+     * @param sequence Slot sequence.
+     * @param value Value returned by beginRead().
+     * @return True when the fields read form one publication.
+     */
+    static bool endRead(const std::atomic<std::uint64_t>& sequence, std::uint64_t value) {
+        std::atomic_thread_fence(std::memory_order_acquire); // fields before the second sequence load
+        return sequence.load(std::memory_order_relaxed) == value;
+    }
+
+    VehicleSlot vehicle;                        ///< CAN reader's slot
+    NoiseSlot microphone;                       ///< Microphone analyzer's slot
+    NavSlot nav;                                ///< Nav engine's slot
+    SettingsSlot hmi;                           ///< HMI's slot
+
+    static_assert(std::atomic<std::int32_t>::is_always_lock_free, "mailbox requires lock-free 32-bit atomics");
+    static_assert(std::atomic<bool>::is_always_lock_free, "mailbox requires lock-free bool atomics");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "mailbox requires lock-free 64-bit atomics");
+};
+
+#endif // INPUT_MAILBOX_H
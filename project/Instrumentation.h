@@ -0,0 +1,208 @@
+/**
+ * @file Instrumentation.h
+ * @brief Low-overhead counters, cycle timing and a lock-free trace ring for AdaptiveVolumeControl.
+ *
+ * The types are always available; AdaptiveVolumeControl only carries and
+ * feeds them when built with -DADAPTIVE_VOLUME_INSTRUMENTATION. Without the
+ * flag the AVC_INSTR_* hooks expand to nothing.
+ */
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief Reads a cheap, monotonic per-core cycle counter.
+ *
+ * TSC on x86, the virtual counter on AArch64, steady-clock nanoseconds elsewhere.
+ * @return Counter value (units are platform dependent; compare deltas only).
+ */
+inline std::uint64_t readCycleCounter() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    std::uint64_t value;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * @struct VolumeCounters
+ * @brief Event counters written by the control thread, readable from any thread.
+ *
+ * There is a single writer, so increments are a relaxed load and store
+ * rather than a locked read-modify-write.
+ */
+struct VolumeCounters {
+    std::atomic<std::uint64_t> updates{0};             ///< update() calls
+    std::atomic<std::uint64_t> hornDuckActivations{0}; ///< Transitions into horn ducking
+    std::atomic<std::uint64_t> suddenBrakes{0};        ///< Targets computed with the sudden brake modifier
+    std::atomic<std::uint64_t> clampMax{0};            ///< Adaptive targets clamped to MAX_ADAPTIVE_VOLUME
+    std::atomic<std::uint64_t> clampMin{0};            ///< Adaptive targets clamped to MIN_VOLUME
+
+    /**
+     * @brief Increments a counter from the single writer thread.
+     * @param counter Counter to increment.
+     */
+    static void bump(std::atomic<std::uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @enum TraceKind
+ * @brief Controller call a TraceRecord was taken for.
+ */
+enum class TraceKind : std::uint8_t {
+    UPDATE, ///< update()
+    TICK    ///< tick() (also reached through advance() and processBlock())
+};
+
+/**
+ * @struct TraceRecord
+ * @brief One timed controller call with the resulting state.
+ */
+struct TraceRecord {
+    std::uint64_t cycles;        ///< Duration in readCycleCounter() units
+    float targetVolume;          ///< Target volume after the call
+    float currentVolume;         ///< Current volume after the call
+    std::uint8_t modifiers;      ///< VolumeModifier bits (why the volume ducked)
+    TraceKind kind;              ///< Which call was timed
+};
+
+/**
+ * @class TraceRing
+ * @brief Single-producer, single-consumer lock-free ring of trace records.
+ *
+ * The control thread pushes and never blocks: when the diagnostics thread
+ * falls behind, new records are dropped and counted.
+ * @tparam Capacity Number of slots (power of two).
+ */
+template<std::size_t Capacity>
+class TraceRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    /**
+     * @brief Appends a record (producer side).
+     * @param record Record to store.
+     * @return False if the ring was full and the record was dropped.
+     */
+    bool push(const TraceRecord& record) {
+        std::uint64_t h = head.load(std::memory_order_relaxed);
+        if(h - tail.load(std::memory_order_acquire) == Capacity) {
+            VolumeCounters::bump(dropped);
+            return false;
+        }
+        slots[h & (Capacity - 1)] = record;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest record (consumer side).
+     * @param record Receives the record.
+     * @return False if the ring was empty.
+     */
+    bool pop(TraceRecord& record) {
+        std::uint64_t t = tail.load(std::memory_order_relaxed);
+        if(t == head.load(std::memory_order_acquire)) return false;
+        record = slots[t & (Capacity - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Gets the number of records dropped because the ring was full.
+     * @return Dropped record count.
+     */
+    std::uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<std::uint64_t> head{0};    ///< Next slot to write (producer owned)
+    alignas(64) std::atomic<std::uint64_t> tail{0};    ///< Next slot to read (consumer owned)
+    alignas(64) std::atomic<std::uint64_t> dropped{0}; ///< Records lost to a full ring
+    TraceRecord slots[Capacity];                       ///< Record storage
+};
+
+/**
+ * @struct VolumeInstrumentation
+ * @brief Counters and call trace carried by an instrumented controller.
+ *
+ * Copying a controller gives the copy its own, empty instrumentation, so
+ * instrumented builds keep the controller copyable.
+ */
+struct VolumeInstrumentation {
+    static constexpr std::size_t TRACE_CAPACITY = 1024; ///< Trace records buffered between drains
+
+    VolumeInstrumentation() = default;
+    VolumeInstrumentation(const VolumeInstrumentation&) {}
+    VolumeInstrumentation& operator=(const VolumeInstrumentation&) { return *this; }
+
+    VolumeCounters counters;          ///< Event counters
+    TraceRing<TRACE_CAPACITY> trace;  ///< Timed calls, drained by a diagnostics thread
+};
+
+/**
+ * @class TraceScope
+ * @brief Times a controller call and pushes its record when the scope ends.
+ * @tparam Controller Type providing getTargetVolume(), getCurrentVolume() and getActiveModifiers().
+ */
+template<typename Controller>
+class TraceScope {
+public:
+    /**
+     * @brief Constructor starts the timing.
+     * @param controller Controller being timed.
+     * @param ring Ring receiving the record.
+     * @param kind Call being timed.
+     */
+    TraceScope(const Controller& controller, TraceRing<VolumeInstrumentation::TRACE_CAPACITY>& ring, TraceKind kind)
+        : controller(controller), ring(ring), kind(kind), start(readCycleCounter()) {}
+
+    /**
+     * @brief Destructor pushes the record.
+     */
+    ~TraceScope() {
+        std::uint64_t cycles = readCycleCounter() - start;
+        ring.push(TraceRecord{cycles, controller.getTargetVolume(), controller.getCurrentVolume(),
+                              controller.getActiveModifiers(), kind});
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const Controller& controller;                               ///< Controller being timed
+    TraceRing<VolumeInstrumentation::TRACE_CAPACITY>& ring;     ///< Destination ring
+    TraceKind kind;                                             ///< Call being timed
+    std::uint64_t start;                                        ///< Counter value at entry
+};
+
+#ifdef ADAPTIVE_VOLUME_INSTRUMENTATION
+/// Increments the named VolumeCounters field of the controller's instrumentation
+#define AVC_INSTR_COUNT(field) VolumeCounters::bump(instrumentation.counters.field)
+/// Times the rest of the enclosing scope and records it as the given TraceKind
+#define AVC_INSTR_TRACE(kind) TraceScope<AdaptiveVolumeControl> avcTraceScope_(*this, instrumentation.trace, TraceKind::kind)
+#else
+#define AVC_INSTR_COUNT(field) ((void)0)
+#define AVC_INSTR_TRACE(kind) ((void)0)
+#endif
+
+#endif // INSTRUMENTATION_H
@@ -0,0 +1,124 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Implements the MappedFile class providing a read-only memory map of a file.
+ */
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Destructor unmaps the file.
+ */
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+/**
+ * @brief Maps a file, replacing any previous mapping.
+ * @param path File to map.
+ * @return True on success.
+ */
+bool MappedFile::open(const std::string& path) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if(file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if(!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    base = static_cast<const unsigned char*>(view);
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+    return true;
+}
+
+/**
+ * @brief Unmaps the file.
+ */
+void MappedFile::close() {
+    if(base) UnmapViewOfFile(base);
+    if(mappingHandle) CloseHandle(mappingHandle);
+    if(fileHandle) CloseHandle(fileHandle);
+    base = nullptr;
+    length = 0;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+}
+
+/**
+ * @brief Sequential access is requested when the file is opened on Windows.
+ */
+void MappedFile::adviseSequential() {}
+
+#else
+
+/**
+ * @brief Maps a file, replacing any previous mapping.
+ * @param path File to map.
+ * @return True on success.
+ */
+bool MappedFile::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file referenced
+    if(view == MAP_FAILED) return false;
+
+    base = static_cast<const unsigned char*>(view);
+    length = static_cast<std::size_t>(info.st_size);
+    return true;
+}
+
+/**
+ * @brief Unmaps the file.
+ */
+void MappedFile::close() {
+    if(base) munmap(const_cast<unsigned char*>(base), length);
+    base = nullptr;
+    length = 0;
+}
+
+/**
+ * @brief Hints the OS that the mapping will be read front to back.
+ */
+void MappedFile::adviseSequential() {
+    if(base) madvise(const_cast<unsigned char*>(base), length, MADV_SEQUENTIAL);
+}
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * @file MappedFile.h
+ * @brief Defines the MappedFile class providing a read-only memory map of a file.
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file (POSIX mmap or Win32 file mapping).
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Maps a file, replacing any previous mapping.
+     * @param path File to map.
+     * @return True on success.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Unmaps the file.
+     */
+    void close();
+
+    /**
+     * @brief Hints the OS that the mapping will be read front to back.
+     */
+    void adviseSequential();
+
+    bool isOpen() const { return base != nullptr; }           ///< @return True if a file is mapped
+    const unsigned char* data() const { return base; }        ///< @return Start of the mapping
+    std::size_t size() const { return length; }               ///< @return Mapping length in bytes
+
+private:
+    const unsigned char* base = nullptr; ///< Start of the mapping
+    std::size_t length = 0;              ///< Mapping length in bytes
+#ifdef _WIN32
+    void* fileHandle = nullptr;          ///< Win32 file handle
+    void* mappingHandle = nullptr;       ///< Win32 file mapping handle
+#endif
+};
+
+#endif // MAPPED_FILE_H
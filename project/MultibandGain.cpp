@@ -0,0 +1,327 @@
+/**
+ * @file MultibandGain.cpp
+ * @brief Implements the multiband adaptive gain stage and its vectorized crossover bank.
+ */
+
+#include "MultibandGain.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MULTIBAND_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+using AVC = AdaptiveVolumeControl;
+using Bank = MultibandGain::Bank;
+using BankState = MultibandGain::BankState;
+constexpr int LANES = MultibandGain::LANES;
+constexpr int MAX_SECTIONS = MultibandGain::MAX_SECTIONS;
+constexpr int ANALYSIS_SECTIONS = 4;    ///< Linkwitz-Riley high-pass then low-pass
+constexpr int AUDIO_SECTIONS = 1;       ///< Butterworth low-pass
+
+constexpr double PI = 3.14159265358979323846;
+constexpr double BUTTERWORTH_Q = 0.70710678118654752;   ///< Q of a Butterworth biquad (and of each Linkwitz-Riley half)
+constexpr float INITIAL_NOISE_DB = 30.0f;               ///< Band level before the first window (controller default)
+
+/**
+ * @brief Runs one sample through the first Sections biquads of every lane.
+ * @param bank Coefficients.
+ * @param state Filter state, updated.
+ * @param x Input sample.
+ * @param out Receives the LANES lane outputs.
+ */
+template <int Sections>
+inline void filterSample(const Bank& bank, BankState& state, float x, float* out) {
+    float in[LANES];
+    for(int lane = 0; lane < LANES; ++lane) in[lane] = x;
+    for(int s = 0; s < Sections; ++s) {
+        for(int lane = 0; lane < LANES; ++lane) {
+            float y = bank.b0[s][lane] * in[lane] + state.z1[s][lane];
+            state.z1[s][lane] = bank.b1[s][lane] * in[lane] - bank.a1[s][lane] * y + state.z2[s][lane];
+            state.z2[s][lane] = bank.b2[s][lane] * in[lane] - bank.a2[s][lane] * y;
+            in[lane] = y;
+        }
+    }
+    for(int lane = 0; lane < LANES; ++lane) out[lane] = in[lane];
+}
+
+/**
+ * @brief Writes an RBJ Butterworth biquad (bilinear, prewarped) into one section of a lane.
+ * @param bank Bank to write.
+ * @param section Section index.
+ * @param lane Lane index.
+ * @param hz Corner frequency.
+ * @param fs Sample rate.
+ * @param highpass True for a high-pass, false for a low-pass.
+ */
+void setButterworth(Bank& bank, int section, int lane, double hz, double fs, bool highpass) {
+    double w0 = 2.0 * PI * hz / fs, cosW = std::cos(w0), alpha = std::sin(w0) / (2.0 * BUTTERWORTH_Q);
+    double a0 = 1.0 + alpha;
+    double edge = highpass ? (1.0 + cosW) / 2.0 : (1.0 - cosW) / 2.0;
+    bank.b0[section][lane] = static_cast<float>(edge / a0);
+    bank.b1[section][lane] = static_cast<float>((highpass ? -2.0 : 2.0) * edge / a0);
+    bank.b2[section][lane] = bank.b0[section][lane];
+    bank.a1[section][lane] = static_cast<float>(-2.0 * cosW / a0);
+    bank.a2[section][lane] = static_cast<float>((1.0 - alpha) / a0);
+}
+
+/**
+ * @brief Makes one section of a lane pass its input through unchanged.
+ */
+void setPassThrough(Bank& bank, int section, int lane) {
+    bank.b0[section][lane] = 1.0f;
+    bank.b1[section][lane] = 0.0f;
+    bank.b2[section][lane] = 0.0f;
+    bank.a1[section][lane] = 0.0f;
+    bank.a2[section][lane] = 0.0f;
+}
+
+#if !MULTIBAND_SSE2
+/**
+ * @brief Filters one channel and mixes the low-passes with ramped weights (scalar lanes).
+ *
+ * Frame i (0-based) uses weights start + step * (i + 1), like applyGainRamp().
+ * @param bank Coefficients.
+ * @param state Channel filter state, updated.
+ * @param samples First sample of the channel.
+ * @param frames Number of frames.
+ * @param stride Distance between the channel's samples (channel count).
+ * @param weightStart Low-pass weights before the block.
+ * @param weightStep Low-pass weight increment per frame.
+ * @param topStart Band gain of the top band before the block.
+ * @param topStep Top band gain increment per frame.
+ */
+void mixScalar(const Bank& bank, BankState& state, float* samples, std::size_t frames, int stride,
+               const float* weightStart, const float* weightStep, float topStart, float topStep) {
+    float lowpass[LANES];
+    for(std::size_t i = 0; i < frames; ++i) {
+        float x = samples[i * stride];
+        filterSample<AUDIO_SECTIONS>(bank, state, x, lowpass);
+        float t = static_cast<float>(i + 1);
+        float y = (topStart + topStep * t) * x;
+        for(int lane = 0; lane < LANES; ++lane) y += (weightStart[lane] + weightStep[lane] * t) * lowpass[lane];
+        samples[i * stride] = y;
+    }
+}
+#endif
+
+#if MULTIBAND_SSE2
+/**
+ * @brief SSE2 version of mixScalar(): eight lanes in two registers, state kept in registers.
+ */
+void mixSse2(const Bank& bank, BankState& state, float* samples, std::size_t frames, int stride,
+             const float* weightStart, const float* weightStep, float topStart, float topStep) {
+    constexpr int SECTIONS = AUDIO_SECTIONS;
+    __m128 b0[SECTIONS][2], b1[SECTIONS][2], b2[SECTIONS][2], a1[SECTIONS][2], a2[SECTIONS][2];
+    __m128 z1[SECTIONS][2], z2[SECTIONS][2];
+    for(int s = 0; s < SECTIONS; ++s) {
+        for(int h = 0; h < 2; ++h) {
+            b0[s][h] = _mm_load_ps(bank.b0[s] + 4 * h);
+            b1[s][h] = _mm_load_ps(bank.b1[s] + 4 * h);
+            b2[s][h] = _mm_load_ps(bank.b2[s] + 4 * h);
+            a1[s][h] = _mm_load_ps(bank.a1[s] + 4 * h);
+            a2[s][h] = _mm_load_ps(bank.a2[s] + 4 * h);
+            z1[s][h] = _mm_load_ps(state.z1[s] + 4 * h);
+            z2[s][h] = _mm_load_ps(state.z2[s] + 4 * h);
+        }
+    }
+    const __m128 w0 = _mm_loadu_ps(weightStart), w1 = _mm_loadu_ps(weightStart + 4);
+    const __m128 dw0 = _mm_loadu_ps(weightStep), dw1 = _mm_loadu_ps(weightStep + 4);
+
+    for(std::size_t i = 0; i < frames; ++i) {
+        float x = samples[i * stride];
+        __m128 in[2] = {_mm_set1_ps(x), _mm_set1_ps(x)};
+        for(int s = 0; s < SECTIONS; ++s) {
+            for(int h = 0; h < 2; ++h) {
+                __m128 y = _mm_add_ps(_mm_mul_ps(b0[s][h], in[h]), z1[s][h]);
+                z1[s][h] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1[s][h], in[h]), _mm_mul_ps(a1[s][h], y)), z2[s][h]);
+                z2[s][h] = _mm_sub_ps(_mm_mul_ps(b2[s][h], in[h]), _mm_mul_ps(a2[s][h], y));
+                in[h] = y;
+            }
+        }
+
+        float t = static_cast<float>(i + 1);
+        __m128 vt = _mm_set1_ps(t);
+        __m128 mix = _mm_add_ps(_mm_mul_ps(_mm_add_ps(w0, _mm_mul_ps(dw0, vt)), in[0]),
+                                _mm_mul_ps(_mm_add_ps(w1, _mm_mul_ps(dw1, vt)), in[1]));
+        mix = _mm_add_ps(mix, _mm_movehl_ps(mix, mix));
+        mix = _mm_add_ss(mix, _mm_shuffle_ps(mix, mix, 1));
+        samples[i * stride] = (topStart + topStep * t) * x + _mm_cvtss_f32(mix);
+    }
+
+    for(int s = 0; s < SECTIONS; ++s) {
+        for(int h = 0; h < 2; ++h) {
+            _mm_store_ps(state.z1[s] + 4 * h, z1[s][h]);
+            _mm_store_ps(state.z2[s] + 4 * h, z2[s][h]);
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Clears a bank state.
+ */
+void clearState(BankState& state) {
+    std::fill(&state.z1[0][0], &state.z1[0][0] + MAX_SECTIONS * LANES, 0.0f);
+    std::fill(&state.z2[0][0], &state.z2[0][0] + MAX_SECTIONS * LANES, 0.0f);
+}
+
+} // namespace
+
+/**
+ * @brief Constructor designs the crossovers (the band count is clamped to MIN_BANDS..MAX_BANDS).
+ * @param config Stage parameters.
+ */
+MultibandGain::MultibandGain(const MultibandConfig& config)
+    : config(config), bands(std::max(MIN_BANDS, std::min(config.bands, MAX_BANDS))),
+      averagingCoefficient(1.0f), levelOffsetDb(0.0f), tickDt(0.0), tickFactor(0.0f) {
+    if(this->config.windowSize == 0) this->config.windowSize = 1;
+    designCrossovers();
+
+    double windowSeconds = static_cast<double>(this->config.windowSize) / this->config.sampleRate;
+    if(this->config.averagingTime > 0.0f)
+        averagingCoefficient = static_cast<float>(1.0 - std::exp(-windowSeconds / this->config.averagingTime));
+    levelOffsetDb = static_cast<float>(10.0 * std::log10(static_cast<double>(bands)));
+    reset();
+}
+
+/**
+ * @brief Places the crossovers log-spaced between the configured limits and designs both banks.
+ *
+ * Analysis lane k is the Linkwitz-Riley band-pass of band k: two Butterworth
+ * high-passes at crossover k - 1 and two low-passes at crossover k (missing
+ * edges pass through). Audio lane k is one Butterworth low-pass at
+ * crossover k. Unused lanes pass through.
+ */
+void MultibandGain::designCrossovers() {
+    double fs = config.sampleRate;
+    double low = std::max(1.0, static_cast<double>(config.lowestCrossover));
+    double high = std::min(std::max(low, static_cast<double>(config.highestCrossover)), 0.45 * fs);
+    int count = bands - 1;
+    for(int index = 0; index < count; ++index)
+        crossovers[index] = static_cast<float>(low * std::pow(high / low, static_cast<double>(index) / (count - 1)));
+
+    for(int lane = 0; lane < LANES; ++lane) {
+        for(int s = 0; s < MAX_SECTIONS; ++s) {
+            setPassThrough(analysisBank, s, lane);
+            setPassThrough(audioBank, s, lane);
+        }
+        if(lane < bands) {
+            for(int s = 0; s < 2; ++s) {
+                if(lane > 0) setButterworth(analysisBank, s, lane, crossovers[lane - 1], fs, true);
+                if(lane < count) setButterworth(analysisBank, 2 + s, lane, crossovers[lane], fs, false);
+            }
+        }
+        if(lane < count) setButterworth(audioBank, 0, lane, crossovers[lane], fs, false);
+    }
+}
+
+/**
+ * @brief Consumes a block of mono microphone samples and updates the band noise levels.
+ * @param samples Mono PCM samples (full scale = 1.0).
+ * @param n Number of samples.
+ */
+void MultibandGain::analyze(const float* samples, std::size_t n) {
+    float band[LANES];
+    for(std::size_t i = 0; i < n; ++i) {
+        filterSample<ANALYSIS_SECTIONS>(analysisBank, micState, samples[i], band);
+        for(int lane = 0; lane < bands; ++lane) bandEnergy[lane] += static_cast<double>(band[lane]) * band[lane];
+
+        if(++windowFill == config.windowSize) finishWindow();
+    }
+}
+
+/**
+ * @brief Closes the current microphone window and updates the exponentially averaged band levels.
+ */
+void MultibandGain::finishWindow() {
+    for(int band = 0; band < bands; ++band) {
+        double meanSquare = bandEnergy[band] / static_cast<double>(windowFill);
+        float db = static_cast<float>(10.0 * std::log10(std::max(meanSquare, 1e-20))) + config.fullScaleDb +
+                   levelOffsetDb;
+        bandNoiseDb[band] = windows == 0 ? db : bandNoiseDb[band] + averagingCoefficient * (db - bandNoiseDb[band]);
+        bandEnergy[band] = 0.0;
+    }
+    ++windows;
+    windowFill = 0;
+}
+
+/**
+ * @brief Gets a band level rounded as a cabin noise value.
+ * @param band Band index.
+ * @return Noise level for AdaptiveVolumeControl::targetVolumeAtNoise().
+ */
+int MultibandGain::getBandNoiseLevel(int band) const {
+    return static_cast<int>(std::lround(bandNoiseDb[band]));
+}
+
+/**
+ * @brief Recomputes the per-band targets from the controller state.
+ * @param avc Controller providing speed, mode, modifiers and control type.
+ */
+void MultibandGain::updateTargets(const AdaptiveVolumeControl& avc) {
+    for(int band = 0; band < bands; ++band)
+        bandTarget[band] = hasNoiseEstimate() ? avc.targetVolumeAtNoise(getBandNoiseLevel(band)) : avc.getTargetVolume();
+}
+
+/**
+ * @brief Smooths the band volumes over the block and applies them to interleaved PCM.
+ * @param samples Interleaved samples, modified in place.
+ * @param frames Number of frames (samples per channel).
+ * @param channels Number of interleaved channels.
+ */
+void MultibandGain::processBlock(float* samples, std::size_t frames, int channels) {
+    if(frames == 0 || channels <= 0 || channels > MAX_CHANNELS) return;
+
+    // Same time-scaled smoothing as AdaptiveVolumeControl::tick()
+    double dt = static_cast<double>(frames) / config.sampleRate;
+    if(dt != tickDt) {
+        tickDt = dt;
+        tickFactor = 1.0f - static_cast<float>(std::pow(1.0 - AVC::SMOOTH_FACTOR, dt / AVC::SMOOTH_INTERVAL));
+    }
+    float startGain[MAX_BANDS], endGain[MAX_BANDS];
+    for(int band = 0; band < bands; ++band) {
+        startGain[band] = bandVolume[band] / AVC::MAX_VOLUME;
+        float& volume = bandVolume[band];
+        if(std::abs(bandTarget[band] - volume) > AVC::SETTLE_THRESHOLD) volume += (bandTarget[band] - volume) * tickFactor;
+        if(std::abs(bandTarget[band] - volume) <= AVC::SETTLE_THRESHOLD) volume = bandTarget[band];
+        endGain[band] = volume / AVC::MAX_VOLUME;
+    }
+
+    // Output = top gain * x + sum of (g[k] - g[k + 1]) * lowpass[k]
+    float weightStart[LANES] = {}, weightStep[LANES] = {};
+    float inverseFrames = 1.0f / static_cast<float>(frames);
+    for(int lane = 0; lane < bands - 1; ++lane) {
+        weightStart[lane] = startGain[lane] - startGain[lane + 1];
+        weightStep[lane] = (endGain[lane] - endGain[lane + 1] - weightStart[lane]) * inverseFrames;
+    }
+    float topStart = startGain[bands - 1];
+    float topStep = (endGain[bands - 1] - topStart) * inverseFrames;
+
+    for(int ch = 0; ch < channels; ++ch) {
+#if MULTIBAND_SSE2
+        mixSse2(audioBank, audioState[ch], samples + ch, frames, channels, weightStart, weightStep, topStart, topStep);
+#else
+        mixScalar(audioBank, audioState[ch], samples + ch, frames, channels, weightStart, weightStep, topStart, topStep);
+#endif
+    }
+}
+
+/**
+ * @brief Clears filter states, band levels and volumes.
+ */
+void MultibandGain::reset() {
+    clearState(micState);
+    for(BankState& state : audioState) clearState(state);
+    for(int band = 0; band < MAX_BANDS; ++band) {
+        bandEnergy[band] = 0.0;
+        bandNoiseDb[band] = INITIAL_NOISE_DB;
+        bandTarget[band] = AVC::DEFAULT_VOLUME;
+        bandVolume[band] = AVC::DEFAULT_VOLUME;
+    }
+    windowFill = 0;
+    windows = 0;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file MultibandGain.h
+ * @brief Defines the MultibandGain stage applying per-band adaptive volumes through a crossover filter bank.
+ */
+
+#ifndef MULTIBAND_GAIN_H
+#define MULTIBAND_GAIN_H
+
+#include "AdaptiveVolumeControl.h"
+#include <cstddef>
+
+/**
+ * @struct MultibandConfig
+ * @brief Parameters of the multiband stage.
+ */
+struct MultibandConfig {
+    float sampleRate = 48000.0f;        ///< Audio and microphone sample rate in Hz
+    int bands = 4;                      ///< Number of bands (MIN_BANDS..MAX_BANDS)
+    float lowestCrossover = 150.0f;     ///< First crossover frequency in Hz
+    float highestCrossover = 5000.0f;   ///< Last crossover frequency in Hz (crossovers are log-spaced in between)
+    std::size_t windowSize = 1024;      ///< Microphone samples per band RMS window
+    float averagingTime = 0.5f;         ///< Time constant (seconds) of the band level average
+    float fullScaleDb = 120.0f;         ///< Level in dB of a full-scale (RMS 1.0) microphone signal
+};
+
+/**
+ * @class MultibandGain
+ * @brief Frequency-dependent adaptive volume: per-band targets from band-split cabin noise.
+ *
+ * The microphone is split into bands by 4th-order Linkwitz-Riley band-passes
+ * (high-pass at the lower crossover, low-pass at the upper one) and each
+ * band gets its own noise level. Every band then runs the controller's
+ * policy (speed, mode, event and external duck modifiers) with its band
+ * noise, so quiet bands are not turned up with the road rumble.
+ *
+ * The audio bank is complementary: band 0 is the lowest low-pass, band k
+ * the difference of adjacent low-passes, the top band the input minus the
+ * highest low-pass. The bands always sum back to the input, so equal band
+ * gains reproduce the broadband gain exactly. Its low-passes are 2nd-order
+ * Butterworth, so the gain steps between bands are smooth shelves without
+ * notches at the crossovers. The output is the band-gain-weighted sum of
+ * the low-pass outputs, with all crossovers of a sample side by side in
+ * SIMD lanes (SSE2, scalar elsewhere). No allocation; not thread safe.
+ */
+class MultibandGain {
+public:
+    static constexpr int MIN_BANDS = 3;         ///< Fewest supported bands
+    static constexpr int MAX_BANDS = 8;         ///< Most supported bands
+    static constexpr int LANES = MAX_BANDS;     ///< Filter lanes (one per band or crossover, padded)
+    static constexpr int MAX_SECTIONS = 4;      ///< Biquads per lane (analysis band-pass: two high-pass, two low-pass)
+    static constexpr int MAX_CHANNELS = 8;      ///< Interleaved channels processBlock() accepts
+
+    /**
+     * @brief Constructor designs the crossovers (the band count is clamped to MIN_BANDS..MAX_BANDS).
+     * @param config Stage parameters.
+     */
+    explicit MultibandGain(const MultibandConfig& config = MultibandConfig{});
+
+    /**
+     * @brief Consumes a block of mono microphone samples and updates the band noise levels.
+     * @param samples Mono PCM samples (full scale = 1.0).
+     * @param n Number of samples.
+     */
+    void analyze(const float* samples, std::size_t n);
+
+    /**
+     * @brief Recomputes the per-band targets from the controller state; call after each update().
+     *
+     * Before the first completed microphone window every band uses the
+     * controller's broadband cabin noise, so the targets equal its target.
+     * @param avc Controller providing speed, mode, modifiers and control type.
+     */
+    void updateTargets(const AdaptiveVolumeControl& avc);
+
+    /**
+     * @brief Smooths the band volumes over the block and applies them to interleaved PCM.
+     *
+     * Band volumes approach their targets like AdaptiveVolumeControl::tick()
+     * over the block duration; the band gains ramp linearly across the block.
+     * Blocks with more than MAX_CHANNELS channels are left untouched.
+     * @param samples Interleaved samples, modified in place.
+     * @param frames Number of frames (samples per channel).
+     * @param channels Number of interleaved channels.
+     */
+    void processBlock(float* samples, std::size_t frames, int channels);
+
+    /**
+     * @brief Clears filter states, band levels and volumes.
+     */
+    void reset();
+
+    int getBands() const { return bands; }                                       ///< @return Number of bands
+    float getCrossover(int index) const { return crossovers[index]; }            ///< @return Crossover frequency in Hz (index < bands - 1)
+    float getBandNoiseDb(int band) const { return bandNoiseDb[band]; }           ///< @return Averaged band level (broadband-equivalent dB)
+    int getBandNoiseLevel(int band) const;                                       ///< @return Band level rounded as a cabin noise value
+    float getBandTarget(int band) const { return bandTarget[band]; }             ///< @return Target volume of a band
+    float getBandVolume(int band) const { return bandVolume[band]; }             ///< @return Smoothed volume of a band
+    bool hasNoiseEstimate() const { return windows > 0; }                        ///< @return True once a microphone window has completed
+
+    /**
+     * @struct Bank
+     * @brief Cascaded biquads per lane, coefficients laid out lane by lane for SIMD.
+     */
+    struct Bank {
+        alignas(16) float b0[MAX_SECTIONS][LANES]; ///< Feed-forward x[n]
+        alignas(16) float b1[MAX_SECTIONS][LANES]; ///< Feed-forward x[n-1]
+        alignas(16) float b2[MAX_SECTIONS][LANES]; ///< Feed-forward x[n-2]
+        alignas(16) float a1[MAX_SECTIONS][LANES]; ///< Feedback y[n-1]
+        alignas(16) float a2[MAX_SECTIONS][LANES]; ///< Feedback y[n-2]
+    };
+
+    /**
+     * @struct BankState
+     * @brief Transposed direct form II state of one signal through a bank.
+     */
+    struct BankState {
+        alignas(16) float z1[MAX_SECTIONS][LANES]; ///< First state variable
+        alignas(16) float z2[MAX_SECTIONS][LANES]; ///< Second state variable
+    };
+
+private:
+    MultibandConfig config;                 ///< Stage parameters
+    int bands;                              ///< Number of bands
+    float crossovers[MAX_BANDS - 1];        ///< Crossover frequencies in Hz
+    Bank analysisBank;                      ///< Linkwitz-Riley band-pass per band (MAX_SECTIONS sections)
+    Bank audioBank;                         ///< Butterworth low-pass per crossover (section 0 only)
+    BankState micState;                     ///< Analysis filter state
+    BankState audioState[MAX_CHANNELS];     ///< Playback filter state per channel
+
+    double bandEnergy[MAX_BANDS];           ///< Energy accumulated per band in the current window
+    std::size_t windowFill;                 ///< Microphone samples in the current window
+    float averagingCoefficient;             ///< Band level average weight per window
+    float levelOffsetDb;                    ///< Added to band levels so evenly spread noise reads as the broadband level
+    float bandNoiseDb[MAX_BANDS];           ///< Averaged band levels
+    unsigned long windows;                  ///< Completed microphone windows
+
+    float bandTarget[MAX_BANDS];            ///< Target volume per band
+    float bandVolume[MAX_BANDS];            ///< Smoothed volume per band
+    double tickDt;                          ///< Block duration the cached factor was computed for
+    float tickFactor;                       ///< Smoothing factor per block of tickDt
+
+    /**
+     * @brief Places the crossovers and designs the analysis and audio banks.
+     */
+    void designCrossovers();
+
+    /**
+     * @brief Closes the current microphone window and updates the band levels.
+     */
+    void finishWindow();
+};
+
+#endif // MULTIBAND_GAIN_H
@@ -0,0 +1,198 @@
+/**
+ * @file NoiseEstimator.cpp
+ * @brief Implements the NoiseEstimator class deriving the cabin noise level from microphone PCM.
+ */
+
+#include "NoiseEstimator.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NOISE_ESTIMATOR_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define NOISE_ESTIMATOR_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr float INITIAL_NOISE_DB = 30.0f;     ///< Reported before the first window (controller default)
+constexpr std::size_t SCRATCH_SAMPLES = 256;  ///< Weighted samples buffered on the stack per step
+
+// IEC 61672 A-weighting pole frequencies in Hz
+constexpr double A_POLE_1 = 20.598997;
+constexpr double A_POLE_2 = 107.65265;
+constexpr double A_POLE_3 = 737.86223;
+constexpr double A_POLE_4 = 12194.217;
+
+/**
+ * @brief Bilinear transform of an analog section N(s) / ((s + p1)(s + p2)).
+ * @param section Output biquad.
+ * @param highPass True for N(s) = s^2, false for N(s) = 1.
+ * @param p1 First pole (rad/s, prewarped).
+ * @param p2 Second pole (rad/s, prewarped).
+ * @param k Bilinear constant 2 * sampleRate.
+ */
+void bilinearSection(Biquad& section, bool highPass, double p1, double p2, double k) {
+    double sum = p1 + p2, product = p1 * p2;
+    double a0 = k * k + sum * k + product;
+    double a1 = 2.0 * product - 2.0 * k * k;
+    double a2 = k * k - sum * k + product;
+    double b0 = highPass ? k * k : 1.0;
+    double b1 = highPass ? -2.0 * k * k : 2.0;
+    double b2 = highPass ? k * k : 1.0;
+    section.b0 = static_cast<float>(b0 / a0);
+    section.b1 = static_cast<float>(b1 / a0);
+    section.b2 = static_cast<float>(b2 / a0);
+    section.a1 = static_cast<float>(a1 / a0);
+    section.a2 = static_cast<float>(a2 / a0);
+}
+
+/**
+ * @brief Evaluates the complex response of a biquad.
+ * @param s Section.
+ * @param omega Normalized angular frequency (rad/sample).
+ * @return H(e^{j omega}).
+ */
+std::complex<double> response(const Biquad& s, double omega) {
+    std::complex<double> z1 = std::polar(1.0, -omega), z2 = z1 * z1;
+    return (double(s.b0) + double(s.b1) * z1 + double(s.b2) * z2) / (1.0 + double(s.a1) * z1 + double(s.a2) * z2);
+}
+
+/**
+ * @brief Sums the squares of n samples (vectorized where available).
+ */
+float squaredSum(const float* x, std::size_t n) {
+    std::size_t i = 0;
+    float total = 0.0f;
+#if NOISE_ESTIMATOR_SSE2
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    for(; i + 8 <= n; i += 8) {
+        __m128 a = _mm_loadu_ps(x + i), b = _mm_loadu_ps(x + i + 4);
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(a, a));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(b, b));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, _mm_add_ps(acc0, acc1));
+    total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif NOISE_ESTIMATOR_NEON
+    float32x4_t acc0 = vdupq_n_f32(0.0f), acc1 = vdupq_n_f32(0.0f);
+    for(; i + 8 <= n; i += 8) {
+        float32x4_t a = vld1q_f32(x + i), b = vld1q_f32(x + i + 4);
+        acc0 = vmlaq_f32(acc0, a, a);
+        acc1 = vmlaq_f32(acc1, b, b);
+    }
+    float32x4_t acc = vaddq_f32(acc0, acc1);
+    total = (vgetq_lane_f32(acc, 0) + vgetq_lane_f32(acc, 1)) + (vgetq_lane_f32(acc, 2) + vgetq_lane_f32(acc, 3));
+#endif
+    for(; i < n; ++i) total += x[i] * x[i];
+    return total;
+}
+
+} // namespace
+
+/**
+ * @brief Constructor designs the filters for the given configuration.
+ * @param config Stage parameters.
+ */
+NoiseEstimator::NoiseEstimator(const NoiseEstimatorConfig& config)
+    : config(config), averagingCoefficient(1.0f), sumOfSquares(0.0), windowFill(0),
+      averagedDb(INITIAL_NOISE_DB), windows(0) {
+    if(this->config.windowSize == 0) this->config.windowSize = 1;
+    designAWeighting();
+
+    double windowSeconds = static_cast<double>(this->config.windowSize) / this->config.sampleRate;
+    if(this->config.averagingTime > 0.0f)
+        averagingCoefficient = static_cast<float>(1.0 - std::exp(-windowSeconds / this->config.averagingTime));
+}
+
+/**
+ * @brief Designs the A-weighting cascade for the configured sample rate, normalized to 0 dB at 1 kHz.
+ */
+void NoiseEstimator::designAWeighting() {
+    double fs = config.sampleRate, k = 2.0 * fs;
+    auto prewarp = [&](double hz) { return k * std::tan(PI * hz / fs); };
+
+    bilinearSection(weighting[0], true, prewarp(A_POLE_1), prewarp(A_POLE_1), k);
+    bilinearSection(weighting[1], true, prewarp(A_POLE_2), prewarp(A_POLE_3), k);
+    bilinearSection(weighting[2], false, prewarp(A_POLE_4), prewarp(A_POLE_4), k);
+
+    double omega = 2.0 * PI * 1000.0 / fs;
+    std::complex<double> h = response(weighting[0], omega) * response(weighting[1], omega) *
+                             response(weighting[2], omega);
+    float scale = static_cast<float>(1.0 / std::abs(h));
+    weighting[2].b0 *= scale;
+    weighting[2].b1 *= scale;
+    weighting[2].b2 *= scale;
+}
+
+/**
+ * @brief Consumes a block of mono microphone samples.
+ * @param samples Mono PCM samples (full scale = 1.0).
+ * @param n Number of samples.
+ */
+void NoiseEstimator::process(const float* samples, std::size_t n) {
+    float scratch[SCRATCH_SAMPLES];
+    while(n > 0) {
+        std::size_t take = std::min(n, config.windowSize - windowFill);
+        const float* block = samples;
+        if(config.aWeighting) {
+            take = std::min(take, SCRATCH_SAMPLES);
+            for(std::size_t i = 0; i < take; ++i) {
+                float x = samples[i];
+                for(Biquad& section : weighting) x = section.process(x);
+                scratch[i] = x;
+            }
+            block = scratch;
+        }
+
+        accumulate(block, take);
+        samples += take;
+        n -= take;
+        if(windowFill == config.windowSize) finishWindow();
+    }
+}
+
+/**
+ * @brief Adds the energy of samples to the current window.
+ * @param samples Samples (already weighted).
+ * @param n Number of samples, not crossing the window end.
+ */
+void NoiseEstimator::accumulate(const float* samples, std::size_t n) {
+    sumOfSquares += squaredSum(samples, n);
+    windowFill += n;
+}
+
+/**
+ * @brief Closes the current window and updates the exponentially averaged level.
+ */
+void NoiseEstimator::finishWindow() {
+    double meanSquare = sumOfSquares / static_cast<double>(windowFill);
+    float db = static_cast<float>(10.0 * std::log10(std::max(meanSquare, 1e-20))) + config.fullScaleDb;
+    averagedDb = windows == 0 ? db : averagedDb + averagingCoefficient * (db - averagedDb);
+    ++windows;
+    sumOfSquares = 0.0;
+    windowFill = 0;
+}
+
+/**
+ * @brief Clears filter state and the averaged level.
+ */
+void NoiseEstimator::reset() {
+    for(Biquad& section : weighting) section.reset();
+    sumOfSquares = 0.0;
+    windowFill = 0;
+    averagedDb = INITIAL_NOISE_DB;
+    windows = 0;
+}
+
+/**
+ * @brief Gets the averaged noise level rounded for AdaptiveVolumeControl::update().
+ * @return Cabin noise level.
+ */
+int NoiseEstimator::getNoiseLevel() const {
+    return static_cast<int>(std::lround(averagedDb));
+}
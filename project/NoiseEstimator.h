@@ -0,0 +1,99 @@
+/**
+ * @file NoiseEstimator.h
+ * @brief Defines the NoiseEstimator class deriving the cabin noise level from microphone PCM.
+ */
+
+#ifndef NOISE_ESTIMATOR_H
+#define NOISE_ESTIMATOR_H
+
+#include "Biquad.h"
+#include <cstddef>
+
+/**
+ * @struct NoiseEstimatorConfig
+ * @brief Parameters of the noise estimation stage.
+ */
+struct NoiseEstimatorConfig {
+    float sampleRate = 48000.0f;    ///< Microphone sample rate in Hz
+    bool aWeighting = true;         ///< Apply the IEC 61672 A-weighting curve before measuring
+    std::size_t windowSize = 1024;  ///< Samples per RMS window (decimation factor of the output)
+    float averagingTime = 0.5f;     ///< Time constant (seconds) of the exponential average
+    float fullScaleDb = 120.0f;     ///< Level in dB of a full-scale (RMS 1.0) signal (microphone calibration)
+};
+
+/**
+ * @class NoiseEstimator
+ * @brief Incremental cabin-noise meter producing the value AdaptiveVolumeControl expects as cabinNoise.
+ *
+ * Mic frames of any size are pushed through process(); each completed RMS
+ * window updates an exponentially averaged dB level. The stage keeps all
+ * state inline and never allocates.
+ */
+class NoiseEstimator {
+public:
+    static constexpr int A_WEIGHTING_SECTIONS = 3; ///< Biquads in the A-weighting cascade
+
+    /**
+     * @brief Constructor designs the filters for the given configuration.
+     * @param config Stage parameters.
+     */
+    explicit NoiseEstimator(const NoiseEstimatorConfig& config = NoiseEstimatorConfig{});
+
+    /**
+     * @brief Consumes a block of mono microphone samples.
+     * @param samples Mono PCM samples (full scale = 1.0).
+     * @param n Number of samples.
+     */
+    void process(const float* samples, std::size_t n);
+
+    /**
+     * @brief Clears filter state and the averaged level.
+     */
+    void reset();
+
+    /**
+     * @brief Gets the averaged noise level.
+     * @return Level in dB (fullScaleDb calibration).
+     */
+    float getNoiseDb() const { return averagedDb; }
+
+    /**
+     * @brief Gets the averaged noise level rounded for AdaptiveVolumeControl::update().
+     * @return Cabin noise level.
+     */
+    int getNoiseLevel() const;
+
+    /**
+     * @brief Checks whether at least one RMS window has completed.
+     * @return True once getNoiseDb() reflects measured input.
+     */
+    bool hasEstimate() const { return windows > 0; }
+
+private:
+    NoiseEstimatorConfig config;                    ///< Stage parameters
+    Biquad weighting[A_WEIGHTING_SECTIONS];         ///< A-weighting cascade
+    float averagingCoefficient;                     ///< Exponential average weight per window
+    double sumOfSquares;                            ///< Energy accumulated in the current window
+    std::size_t windowFill;                         ///< Samples accumulated in the current window
+    float averagedDb;                               ///< Exponentially averaged level
+    unsigned long windows;                          ///< Completed windows
+
+    /**
+     * @brief Designs the A-weighting cascade for the configured sample rate.
+     */
+    void designAWeighting();
+
+    /**
+     * @brief Adds the energy of samples to the current window.
+     * @param samples Samples (already weighted).
+     * @param n Number of samples, not crossing the window end.
+     */
+    void accumulate(const float* samples, std::size_t n);
+
+    /**
+     * @brief Closes the current window and updates the averaged level.
+     */
+    void finishWindow();
+};
+
+#endif // NOISE_ESTIMATOR_H
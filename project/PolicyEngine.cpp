@@ -0,0 +1,90 @@
+/**
+ * @file PolicyEngine.cpp
+ * @brief Implements loading and hot-swapping of volume policy profiles.
+ */
+
+#include "PolicyEngine.h"
+
+/**
+ * @brief Constructor installs the built-in policy (VolumeProfileSpec defaults).
+ */
+PolicyEngine::PolicyEngine() : active(nullptr), published(0), acquiring(0) {
+    install(compileVolumeProfile(VolumeProfileSpec{}));
+}
+
+/**
+ * @brief Destructor drops the engine's references (profiles still acquired live on with their holders).
+ */
+PolicyEngine::~PolicyEngine() {
+    for(Profile* profile : retired) release(profile);
+    release(active.load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief Maps a profile file and makes it current.
+ * @param path Profile written by writeVolumeProfile().
+ * @return False if the file is missing or invalid (the current profile stays active).
+ */
+bool PolicyEngine::load(const std::string& path) {
+    std::unique_ptr<Profile> profile(new Profile);
+    if(!profile->file.open(path)) return false;
+    profile->data = validateVolumeProfile(profile->file.data(), profile->file.size());
+    if(!profile->data) return false;
+    publish(profile.release());
+    return true;
+}
+
+/**
+ * @brief Makes a copy of a compiled profile current.
+ * @param data Compiled profile.
+ */
+void PolicyEngine::install(const VolumeProfileData& data) {
+    std::unique_ptr<Profile> profile(new Profile);
+    profile->copy.reset(new VolumeProfileData(data));
+    profile->data = profile->copy.get();
+    publish(profile.release());
+}
+
+/**
+ * @brief Publishes a profile and retires the previous one.
+ * @param profile New current profile.
+ */
+void PolicyEngine::publish(Profile* profile) {
+    std::lock_guard<std::mutex> lock(retiredMutex);
+    profile->generation = published.load(std::memory_order_relaxed) + 1;
+    Profile* previous = active.load(std::memory_order_relaxed);
+    if(previous) retired.push_back(previous);
+    active.store(profile, std::memory_order_seq_cst);
+    published.store(profile->generation, std::memory_order_release);
+}
+
+/**
+ * @brief Drops the engine's reference to a profile, freeing it if it was the last.
+ * @param profile Profile owned by the engine.
+ */
+void PolicyEngine::release(Profile* profile) {
+    if(profile && profile->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete profile;
+}
+
+/**
+ * @brief Releases profiles replaced since the last call.
+ * @return Number of profiles released.
+ */
+std::size_t PolicyEngine::collectRetired() {
+    std::lock_guard<std::mutex> lock(retiredMutex);
+    // An acquire() in flight may have loaded a retired pointer without counting it yet
+    if(acquiring.load(std::memory_order_seq_cst) != 0) return 0;
+
+    // Only the engine's reference left: no controller can reach it any more
+    std::size_t kept = 0, released = 0;
+    for(Profile* profile : retired) {
+        if(profile->refs.load(std::memory_order_acquire) > 1) {
+            retired[kept++] = profile;
+        } else {
+            delete profile;
+            ++released;
+        }
+    }
+    retired.resize(kept);
+    return released;
+}
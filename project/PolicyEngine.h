@@ -0,0 +1,130 @@
+/**
+ * @file PolicyEngine.h
+ * @brief Defines the PolicyEngine class holding the active, hot-swappable volume profile.
+ */
+
+#ifndef POLICY_ENGINE_H
+#define POLICY_ENGINE_H
+
+#include "MappedFile.h"
+#include "ProfileRef.h"
+#include "VolumeProfile.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class PolicyEngine
+ * @brief Serves the current VolumeProfileData and swaps in new profiles atomically.
+ *
+ * Any thread may load() or install() a profile; the new profile is published
+ * with one atomic pointer store and a new generation number. Controllers
+ * compare generation() (one acquire load) and only take a reference with
+ * acquire() when it changed, so a profile allocated at a freed address is
+ * never mistaken for the one in use.
+ *
+ * acquire() never locks: it announces itself in an acquiring counter, loads
+ * the current pointer and counts its reference before leaving. The previous
+ * profile is retired rather than freed; collectRetired() frees a retired
+ * profile only while no acquire() is in flight and the engine holds its last
+ * reference, so no profile is ever freed inside update()/commit(). The
+ * mutex only orders publishers and the collector.
+ */
+class PolicyEngine {
+public:
+    /**
+     * @brief Constructor installs the built-in policy (VolumeProfileSpec defaults).
+     */
+    PolicyEngine();
+    ~PolicyEngine();
+
+    PolicyEngine(const PolicyEngine&) = delete;
+    PolicyEngine& operator=(const PolicyEngine&) = delete;
+
+    /**
+     * @brief Maps a profile file and makes it current.
+     * @param path Profile written by writeVolumeProfile().
+     * @return False if the file is missing or invalid (the current profile stays active).
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Makes a copy of a compiled profile current.
+     * @param data Compiled profile.
+     */
+    void install(const VolumeProfileData& data);
+
+    /**
+     * @brief Gets the current profile.
+     * @return Profile, valid until collectRetired() runs after it was replaced (hold acquire() to keep it).
+     */
+    const VolumeProfileData& current() const { return *active.load(std::memory_order_acquire)->data; }
+
+    /**
+     * @brief Gets the generation of the current profile.
+     * @return Number increased by every publish (never reused).
+     */
+    std::uint64_t generation() const { return published.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Takes a reference to the current profile.
+     *
+     * Lock-free: three atomic operations, no allocation and no system call.
+     * Call when generation() changed. The profile stays valid while the
+     * reference is held.
+     * @param generation Receives the generation of the returned profile.
+     * @return Current profile.
+     */
+    ProfileRef acquire(std::uint64_t& generation) const {
+        // Sequentially consistent with publish()/collectRetired(): either the
+        // collector sees this acquire in flight, or the load sees the new profile
+        acquiring.fetch_add(1, std::memory_order_seq_cst);
+        Profile* profile = active.load(std::memory_order_seq_cst);
+        profile->refs.fetch_add(1, std::memory_order_relaxed);
+        acquiring.fetch_sub(1, std::memory_order_release);
+        generation = profile->generation;
+        return ProfileRef(profile);
+    }
+
+    /**
+     * @brief Releases profiles replaced since the last call.
+     *
+     * Call from the thread that evaluates the policy, outside update()/commit().
+     * Profiles still referenced through acquire() stay retired until a later
+     * call, and so does everything while an acquire() is in flight.
+     * @return Number of profiles released.
+     */
+    std::size_t collectRetired();
+
+private:
+    /**
+     * @struct Profile
+     * @brief A profile and the storage backing it (a mapping or an owned copy).
+     */
+    struct Profile : CountedProfile {
+        MappedFile file;                            ///< Mapping for loaded profiles
+        std::unique_ptr<VolumeProfileData> copy;    ///< Storage for installed profiles
+    };
+
+    std::atomic<Profile*> active;               ///< Current profile (the engine holds one reference)
+    std::atomic<std::uint64_t> published;       ///< Generation of the current profile
+    mutable std::atomic<std::uint32_t> acquiring; ///< acquire() calls between loading active and counting their reference
+    std::mutex retiredMutex;                    ///< Orders publishers and the collector (never taken by acquire())
+    std::vector<Profile*> retired;              ///< Replaced profiles awaiting collectRetired(), one engine reference each
+
+    /**
+     * @brief Drops the engine's reference to a profile, freeing it if it was the last.
+     * @param profile Profile owned by the engine.
+     */
+    static void release(Profile* profile);
+
+    /**
+     * @brief Publishes a profile and retires the previous one.
+     * @param profile New current profile.
+     */
+    void publish(Profile* profile);
+};
+
+#endif // POLICY_ENGINE_H
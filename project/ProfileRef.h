@@ -0,0 +1,73 @@
+/**
+ * @file ProfileRef.h
+ * @brief Defines the counted reference a controller holds on a PolicyEngine profile.
+ */
+
+#ifndef PROFILE_REF_H
+#define PROFILE_REF_H
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+struct VolumeProfileData;
+
+/**
+ * @struct CountedProfile
+ * @brief Reference-counted part of a published profile (the engine's storage derives from it).
+ */
+struct CountedProfile {
+    std::atomic<std::uint32_t> refs{1};        ///< Holders, including the engine until it releases the profile
+    const VolumeProfileData* data = nullptr;    ///< Payload
+    std::uint64_t generation = 0;               ///< Publish number
+
+    virtual ~CountedProfile() = default;
+};
+
+/**
+ * @class ProfileRef
+ * @brief Keeps one profile alive without locks: copying and dropping are single atomic operations.
+ *
+ * The engine holds the last reference of every profile it still owns and
+ * frees it in PolicyEngine::collectRetired(), so a controller dropping its
+ * reference never frees memory. Only a reference outliving its engine frees
+ * the profile when dropped.
+ */
+class ProfileRef {
+public:
+    ProfileRef() = default;
+
+    /**
+     * @brief Adopts a reference already counted in profile->refs.
+     * @param profile Profile, or nullptr.
+     */
+    explicit ProfileRef(CountedProfile* profile) : profile(profile) {}
+
+    ProfileRef(const ProfileRef& other) : profile(other.profile) {
+        if(profile) profile->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    ProfileRef(ProfileRef&& other) noexcept : profile(std::exchange(other.profile, nullptr)) {}
+    ProfileRef& operator=(ProfileRef other) noexcept {
+        std::swap(profile, other.profile);
+        return *this;
+    }
+    ~ProfileRef() { reset(); }
+
+    /**
+     * @brief Drops the reference.
+     */
+    void reset() {
+        if(profile && profile->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete profile;
+        profile = nullptr;
+    }
+
+    explicit operator bool() const { return profile != nullptr; }                  ///< @return True if a profile is held
+    const VolumeProfileData& operator*() const { return *profile->data; }          ///< @return Held profile
+    const VolumeProfileData* operator->() const { return profile->data; }          ///< @return Held profile
+    std::uint64_t generation() const { return profile ? profile->generation : 0; } ///< @return Publish number of the held profile
+
+private:
+    CountedProfile* profile = nullptr;          ///< Held profile (nullptr = none)
+};
+
+#endif // PROFILE_REF_H
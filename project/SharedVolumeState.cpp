@@ -0,0 +1,278 @@
+/**
+ * @file SharedVolumeState.cpp
+ * @brief Implements the shared-memory volume state publisher and reader.
+ */
+
+#include "SharedVolumeState.h"
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+/**
+ * @brief Reinterprets a float as its bit pattern.
+ * @param value Float.
+ * @return Bits.
+ */
+std::uint32_t floatBits(float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/**
+ * @brief Reinterprets a bit pattern as a float.
+ * @param bits Bits.
+ * @return Float.
+ */
+float bitsFloat(std::uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Marks a freshly mapped segment as valid for readers.
+ * @param layout Segment mapped read-write.
+ */
+void initializeLayout(SharedVolumeLayout* layout) {
+    // A previous publisher may have died mid-write; make the sequence even again
+    std::uint32_t sequence = layout->sequence.load(std::memory_order_relaxed);
+    if(sequence & 1u) layout->sequence.store(sequence + 1, std::memory_order_release);
+    layout->version.store(SHARED_VOLUME_VERSION, std::memory_order_relaxed);
+    layout->magic.store(SHARED_VOLUME_MAGIC, std::memory_order_release);
+}
+
+/**
+ * @brief Checks the header of a mapped segment.
+ * @param layout Mapped segment.
+ * @return True if it was initialized by a compatible publisher.
+ */
+bool layoutValid(const SharedVolumeLayout* layout) {
+    return layout->magic.load(std::memory_order_acquire) == SHARED_VOLUME_MAGIC &&
+           layout->version.load(std::memory_order_relaxed) == SHARED_VOLUME_VERSION;
+}
+}
+
+/**
+ * @brief Destructor unmaps and removes the segment.
+ */
+SharedVolumePublisher::~SharedVolumePublisher() {
+    close();
+}
+
+/**
+ * @brief Destructor unmaps the segment.
+ */
+SharedVolumeReader::~SharedVolumeReader() {
+    close();
+}
+
+/**
+ * @brief Publishes a set of values under the seqlock.
+ * @param currentVolume Smoothed volume.
+ * @param targetVolume Target volume.
+ * @param activeModifiers VolumeModifier bits.
+ */
+void SharedVolumePublisher::publish(float currentVolume, float targetVolume, std::uint8_t activeModifiers) {
+    if(!layout) return;
+    std::uint32_t sequence = layout->sequence.load(std::memory_order_relaxed);
+    layout->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release); // odd sequence is visible before the payload
+
+    layout->currentVolume.store(floatBits(currentVolume), std::memory_order_relaxed);
+    layout->targetVolume.store(floatBits(targetVolume), std::memory_order_relaxed);
+    layout->activeModifiers.store(activeModifiers, std::memory_order_relaxed);
+
+    layout->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Takes a consistent snapshot of the published values.
+ * @param sample Receives the values.
+ * @return False if no consistent snapshot was obtained within MAX_RETRIES.
+ */
+bool SharedVolumeReader::read(SharedVolumeSample& sample) const {
+    if(!layout) return false;
+    for(int attempt = 0; attempt < MAX_RETRIES; ++attempt) {
+        std::uint32_t before = layout->sequence.load(std::memory_order_acquire);
+        if(before & 1u) continue; // write in progress
+
+        std::uint32_t current = layout->currentVolume.load(std::memory_order_relaxed);
+        std::uint32_t target = layout->targetVolume.load(std::memory_order_relaxed);
+        std::uint32_t modifiers = layout->activeModifiers.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire); // payload loads complete before the re-check
+        if(layout->sequence.load(std::memory_order_relaxed) != before) continue;
+
+        sample.currentVolume = bitsFloat(current);
+        sample.targetVolume = bitsFloat(target);
+        sample.activeModifiers = static_cast<std::uint8_t>(modifiers);
+        sample.sequence = before;
+        return true;
+    }
+    return false;
+}
+
+#ifdef _WIN32
+
+namespace {
+/**
+ * @brief Maps a POSIX-style segment name to a session-local Win32 object name.
+ * @param name Segment name, e.g. "/avc_volume".
+ * @return Win32 name, e.g. "Local\\avc_volume".
+ */
+std::string win32Name(const std::string& name) {
+    return "Local\\" + (name.empty() || name[0] != '/' ? name : name.substr(1));
+}
+}
+
+/**
+ * @brief Creates (or takes over) the segment and maps it read-write.
+ * @param name Segment name.
+ * @return True on success.
+ */
+bool SharedVolumePublisher::open(const std::string& name) {
+    close();
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
+                                        sizeof(SharedVolumeLayout), win32Name(name).c_str());
+    if(!mapping) return false;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(SharedVolumeLayout));
+    if(!view) {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    mappingHandle = mapping;
+    layout = static_cast<SharedVolumeLayout*>(view);
+    segmentName = name;
+    initializeLayout(layout);
+    return true;
+}
+
+/**
+ * @brief Unmaps the segment (Windows removes it with the last handle).
+ */
+void SharedVolumePublisher::close() {
+    if(layout) UnmapViewOfFile(layout);
+    if(mappingHandle) CloseHandle(mappingHandle);
+    layout = nullptr;
+    mappingHandle = nullptr;
+    segmentName.clear();
+}
+
+/**
+ * @brief Maps an existing segment read-only.
+ * @param name Segment name.
+ * @return False if the segment does not exist or has a different layout.
+ */
+bool SharedVolumeReader::open(const std::string& name) {
+    close();
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, win32Name(name).c_str());
+    if(!mapping) return false;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sizeof(SharedVolumeLayout));
+    if(!view || !layoutValid(static_cast<const SharedVolumeLayout*>(view))) {
+        if(view) UnmapViewOfFile(view);
+        CloseHandle(mapping);
+        return false;
+    }
+
+    mappingHandle = mapping;
+    layout = static_cast<const SharedVolumeLayout*>(view);
+    return true;
+}
+
+/**
+ * @brief Unmaps the segment.
+ */
+void SharedVolumeReader::close() {
+    if(layout) UnmapViewOfFile(layout);
+    if(mappingHandle) CloseHandle(mappingHandle);
+    layout = nullptr;
+    mappingHandle = nullptr;
+}
+
+#else
+
+/**
+ * @brief Creates (or takes over) the segment and maps it read-write.
+ * @param name Segment name.
+ * @return True on success.
+ */
+bool SharedVolumePublisher::open(const std::string& name) {
+    close();
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+    if(fd < 0) return false;
+    if(ftruncate(fd, sizeof(SharedVolumeLayout)) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, sizeof(SharedVolumeLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps the segment referenced
+    if(view == MAP_FAILED) return false;
+
+    layout = static_cast<SharedVolumeLayout*>(view);
+    segmentName = name;
+    initializeLayout(layout);
+    return true;
+}
+
+/**
+ * @brief Unmaps and removes the segment name (mapped readers keep their view).
+ */
+void SharedVolumePublisher::close() {
+    if(layout) {
+        munmap(layout, sizeof(SharedVolumeLayout));
+        shm_unlink(segmentName.c_str());
+    }
+    layout = nullptr;
+    segmentName.clear();
+}
+
+/**
+ * @brief Maps an existing segment read-only.
+ * @param name Segment name.
+ * @return False if the segment does not exist or has a different layout.
+ */
+bool SharedVolumeReader::open(const std::string& name) {
+    close();
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if(fd < 0) return false;
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(SharedVolumeLayout)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, sizeof(SharedVolumeLayout), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(view == MAP_FAILED) return false;
+    if(!layoutValid(static_cast<const SharedVolumeLayout*>(view))) {
+        munmap(view, sizeof(SharedVolumeLayout));
+        return false;
+    }
+
+    layout = static_cast<const SharedVolumeLayout*>(view);
+    return true;
+}
+
+/**
+ * @brief Unmaps the segment.
+ */
+void SharedVolumeReader::close() {
+    if(layout) munmap(const_cast<SharedVolumeLayout*>(layout), sizeof(SharedVolumeLayout));
+    layout = nullptr;
+}
+
+#endif
@@ -0,0 +1,146 @@
+/**
+ * @file SharedVolumeState.h
+ * @brief Defines the shared-memory publisher and reader of the controller volume state.
+ */
+
+#ifndef SHARED_VOLUME_STATE_H
+#define SHARED_VOLUME_STATE_H
+
+#include "AdaptiveVolumeControl.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+constexpr std::uint32_t SHARED_VOLUME_MAGIC = 0x53565641u; ///< "AVVS" read as a little-endian word
+constexpr std::uint32_t SHARED_VOLUME_VERSION = 1;         ///< Current segment layout version
+
+/**
+ * @struct SharedVolumeLayout
+ * @brief Segment contents: a seqlock sequence and the published values.
+ *
+ * Every field is a lock-free atomic, so concurrent access from several
+ * processes is well defined; the payload uses relaxed accesses ordered by
+ * fences around the sequence number.
+ */
+struct SharedVolumeLayout {
+    std::atomic<std::uint32_t> magic;              ///< SHARED_VOLUME_MAGIC once the segment is initialized
+    std::atomic<std::uint32_t> version;            ///< SHARED_VOLUME_VERSION
+    alignas(64) std::atomic<std::uint32_t> sequence; ///< Odd while a write is in progress
+    std::atomic<std::uint32_t> currentVolume;      ///< Bits of getCurrentVolume()
+    std::atomic<std::uint32_t> targetVolume;       ///< Bits of getTargetVolume()
+    std::atomic<std::uint32_t> activeModifiers;    ///< VolumeModifier bits (horn, navigation, reverse, brake, external ducks)
+};
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "shared atomics must not rely on process-local locks");
+
+/**
+ * @struct SharedVolumeSample
+ * @brief One consistent read of the segment.
+ */
+struct SharedVolumeSample {
+    float currentVolume = 0.0f;         ///< Smoothed volume
+    float targetVolume = 0.0f;          ///< Target volume
+    std::uint8_t activeModifiers = 0;   ///< VolumeModifier bits
+    std::uint32_t sequence = 0;         ///< Seqlock sequence, grows by 2 per publication (compare to detect new data)
+};
+
+/**
+ * @class SharedVolumePublisher
+ * @brief Writes the volume state into a named shared-memory segment (POSIX shm / Win32 named mapping).
+ *
+ * Single writer: the thread that owns the AdaptiveVolumeControl calls
+ * publish(), typically after each tick. A publication is a handful of
+ * stores into the mapping; no syscall, no serialization.
+ */
+class SharedVolumePublisher {
+public:
+    SharedVolumePublisher() = default;
+    ~SharedVolumePublisher();
+
+    SharedVolumePublisher(const SharedVolumePublisher&) = delete;
+    SharedVolumePublisher& operator=(const SharedVolumePublisher&) = delete;
+
+    /**
+     * @brief Creates (or takes over) the segment and maps it read-write.
+     * @param name Segment name, e.g. "/avc_volume".
+     * @return True on success.
+     */
+    bool open(const std::string& name);
+
+    /**
+     * @brief Unmaps and removes the segment name (mapped readers keep their view).
+     */
+    void close();
+
+    bool isOpen() const { return layout != nullptr; }   ///< @return True if the segment is mapped
+
+    /**
+     * @brief Publishes a set of values under the seqlock.
+     * @param currentVolume Smoothed volume.
+     * @param targetVolume Target volume.
+     * @param activeModifiers VolumeModifier bits.
+     */
+    void publish(float currentVolume, float targetVolume, std::uint8_t activeModifiers);
+
+    /**
+     * @brief Publishes the state of a controller.
+     * @param avc Controller owned by the calling thread.
+     */
+    void publish(const AdaptiveVolumeControl& avc) {
+        publish(avc.getCurrentVolume(), avc.getTargetVolume(), avc.getActiveModifiers());
+    }
+
+private:
+    SharedVolumeLayout* layout = nullptr;  ///< Mapped segment
+    std::string segmentName;               ///< Name to remove on close()
+#ifdef _WIN32
+    void* mappingHandle = nullptr;         ///< Win32 file mapping handle
+#endif
+};
+
+/**
+ * @class SharedVolumeReader
+ * @brief Polls a segment written by SharedVolumePublisher from any process.
+ *
+ * A read is a few loads from the mapping and is retried only if it
+ * overlapped a publication, so readers never block the publisher.
+ */
+class SharedVolumeReader {
+public:
+    static constexpr int MAX_RETRIES = 64; ///< Attempts before read() gives up during a storm of publications
+
+    SharedVolumeReader() = default;
+    ~SharedVolumeReader();
+
+    SharedVolumeReader(const SharedVolumeReader&) = delete;
+    SharedVolumeReader& operator=(const SharedVolumeReader&) = delete;
+
+    /**
+     * @brief Maps an existing segment read-only.
+     * @param name Segment name passed to SharedVolumePublisher::open().
+     * @return False if the segment does not exist or has a different layout.
+     */
+    bool open(const std::string& name);
+
+    /**
+     * @brief Unmaps the segment.
+     */
+    void close();
+
+    bool isOpen() const { return layout != nullptr; }   ///< @return True if a segment is mapped
+
+    /**
+     * @brief Takes a consistent snapshot of the published values.
+     * @param sample Receives the values.
+     * @return False if no consistent snapshot was obtained within MAX_RETRIES.
+     */
+    bool read(SharedVolumeSample& sample) const;
+
+private:
+    const SharedVolumeLayout* layout = nullptr; ///< Mapped segment
+#ifdef _WIN32
+    void* mappingHandle = nullptr;              ///< Win32 file mapping handle
+#endif
+};
+
+#endif // SHARED_VOLUME_STATE_H
@@ -0,0 +1,131 @@
+/**
+ * @file SpeedTrend.cpp
+ * @brief Implements the SpeedTrend class.
+ */
+
+#include "SpeedTrend.h"
+
+using namespace std::chrono;
+
+/**
+ * @brief Constructor.
+ * @param window Seconds of history used for the slope.
+ * @param minSpan Shortest history (seconds) that yields a non-zero estimate.
+ */
+SpeedTrend::SpeedTrend(double window, double minSpan)
+    : ring(), head(0), count(0), window(window), slotWidth(window / CAPACITY), minSpan(minSpan), origin(), hasOrigin(false),
+      sumT(0.0), sumV(0.0), sumTV(0.0), sumTT(0.0) {}
+
+/**
+ * @brief Forgets the history.
+ */
+void SpeedTrend::reset() {
+    head = 0;
+    count = 0;
+    hasOrigin = false;
+    sumT = sumV = sumTV = sumTT = 0.0;
+}
+
+/**
+ * @brief Adds a slot's mean to the running sums.
+ * @param s Slot.
+ * @param sign +1 to add, -1 to remove.
+ */
+void SpeedTrend::accumulate(const Sample& s, double sign) {
+    sumT += sign * s.t;
+    sumV += sign * s.v;
+    sumTV += sign * s.t * s.v;
+    sumTT += sign * s.t * s.t;
+}
+
+/**
+ * @brief Removes the oldest slot from the sums.
+ */
+void SpeedTrend::dropOldest() {
+    accumulate(oldest(), -1.0);
+    head = (head + 1) % CAPACITY;
+    --count;
+}
+
+/**
+ * @brief Adds a speed sample and drops slots older than the window.
+ * @param time Sample time (monotonic).
+ * @param speedKmh Vehicle speed in km/h.
+ */
+void SpeedTrend::addSample(Clock::time_point time, float speedKmh) {
+    if(!hasOrigin) {
+        origin = time;
+        hasOrigin = true;
+    }
+    double t = duration<double>(time - origin).count();
+
+    // Move the origin to the oldest sample and recompute the sums (amortized O(1))
+    if(t > REBASE_INTERVAL) {
+        Clock::time_point newOrigin = count ? origin + duration_cast<Clock::duration>(duration<double>(oldest().t)) : time;
+        double shift = duration<double>(newOrigin - origin).count();
+        origin = newOrigin;
+        t -= shift;
+        sumT = sumV = sumTV = sumTT = 0.0;
+        for(int i = 0; i < count; ++i) {
+            Sample& s = ring[(head + i) % CAPACITY];
+            s.t -= shift;
+            s.first -= shift;
+            accumulate(s, 1.0);
+        }
+    }
+
+    if(count && t - newest().first < slotWidth) {
+        // Same slot: replace its mean in the sums
+        Sample& s = ring[(head + count - 1) % CAPACITY];
+        accumulate(s, -1.0);
+        ++s.n;
+        s.t += (t - s.t) / s.n;
+        s.v += (speedKmh - s.v) / s.n;
+        accumulate(s, 1.0);
+    } else {
+        if(count == CAPACITY) dropOldest();
+        Sample& s = ring[(head + count) % CAPACITY];
+        s.t = t;
+        s.v = speedKmh;
+        s.first = t;
+        s.n = 1;
+        ++count;
+        accumulate(s, 1.0);
+    }
+
+    // Keep two slots so updates slower than the window still yield a slope
+    while(count > 2 && t - oldest().t > window) dropOldest();
+}
+
+/**
+ * @brief Computes the least-squares slope.
+ * @return km/h per second, 0 until minSpan of history exists.
+ */
+double SpeedTrend::slope() const {
+    if(count < 2 || newest().t - oldest().t < minSpan) return 0.0;
+    double n = count;
+    double denominator = n * sumTT - sumT * sumT;
+    return denominator > 0.0 ? (n * sumTV - sumT * sumV) / denominator : 0.0;
+}
+
+/**
+ * @brief Gets the fitted acceleration.
+ * @return m/s^2 (negative while slowing down).
+ */
+float SpeedTrend::acceleration() const {
+    return static_cast<float>(slope() / KMH_PER_MPS);
+}
+
+/**
+ * @brief Extrapolates the fitted line.
+ * @param horizon Seconds after the newest sample.
+ * @return Predicted speed in km/h.
+ */
+float SpeedTrend::predictSpeed(double horizon) const {
+    if(count == 0) return 0.0f;
+    double a = slope();
+    if(a == 0.0) return static_cast<float>(newest().v);
+    // Fitted line passes through the mean sample
+    double meanT = sumT / count, meanV = sumV / count;
+    return static_cast<float>(meanV + a * (newest().t + horizon - meanT));
+}
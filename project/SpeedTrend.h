@@ -0,0 +1,114 @@
+/**
+ * @file SpeedTrend.h
+ * @brief Defines the SpeedTrend class estimating vehicle acceleration from a sliding speed history.
+ */
+
+#ifndef SPEED_TREND_H
+#define SPEED_TREND_H
+
+#include "Clock.h"
+
+/**
+ * @class SpeedTrend
+ * @brief Least-squares speed slope over a fixed time window, O(1) per sample.
+ *
+ * Samples are averaged into time slots of window / CAPACITY seconds, so the
+ * ring covers the whole window at any update rate; running sums of t, v,
+ * t*v and t*t over the slot means are updated as slots enter and leave the
+ * window, so the slope never needs a pass over the history. When updates
+ * are further apart than the window the two newest slots are kept, so a
+ * 1 Hz feed still yields a slope. Times are kept relative to an origin that
+ * is moved forward (with one recomputation of the sums) every
+ * REBASE_INTERVAL, which bounds the rounding error of the running sums on
+ * long drives. Unlike a difference of two consecutive speeds the estimate
+ * does not depend on the update rate. Speed quantization is not averaged
+ * out: one step of q km/h inside the window can tilt the fit by up to
+ * 1.5 * q / window km/h per second (0.83 m/s^2 for whole km/h and the
+ * default 0.5 s window), so use a window of 2 s or more when a gentle coast
+ * must stay below AdaptiveVolumeControl::SPEED_DECREASE_DECELERATION.
+ */
+class SpeedTrend {
+public:
+    static constexpr int CAPACITY = 128;              ///< Time slots per window (oldest dropped first)
+    static constexpr double REBASE_INTERVAL = 60.0;   ///< Seconds between time-origin moves
+    static constexpr double KMH_PER_MPS = 3.6;        ///< km/h per m/s
+
+    /**
+     * @brief Constructor.
+     * @param window Seconds of history used for the slope.
+     * @param minSpan Shortest history (seconds) that yields a non-zero estimate.
+     */
+    explicit SpeedTrend(double window = 0.5, double minSpan = 0.05);
+
+    /**
+     * @brief Adds a speed sample and drops slots older than the window.
+     * @param time Sample time (monotonic).
+     * @param speedKmh Vehicle speed in km/h.
+     */
+    void addSample(Clock::time_point time, float speedKmh);
+
+    /**
+     * @brief Gets the fitted acceleration.
+     * @return m/s^2 (negative while slowing down), 0 until minSpan of history exists.
+     */
+    float acceleration() const;
+
+    /**
+     * @brief Extrapolates the fitted line.
+     * @param horizon Seconds after the newest sample.
+     * @return Predicted speed in km/h (the newest sample until minSpan of history exists).
+     */
+    float predictSpeed(double horizon) const;
+
+    /**
+     * @brief Forgets the history (e.g. after the speed signal was lost).
+     */
+    void reset();
+
+    int size() const { return count; }  ///< @return Time slots in the window
+
+private:
+    /**
+     * @struct Sample
+     * @brief Mean of the speed readings in one time slot.
+     */
+    struct Sample {
+        double t;       ///< Mean seconds since origin
+        double v;       ///< Mean km/h
+        double first;   ///< Seconds since origin of the slot's first reading
+        int n;          ///< Readings averaged
+    };
+
+    Sample ring[CAPACITY];              ///< Slot history
+    int head;                           ///< Index of the oldest slot
+    int count;                          ///< Slots in the ring
+    double window;                      ///< History length in seconds
+    double slotWidth;                   ///< Seconds of readings averaged into one slot
+    double minSpan;                     ///< Required history span in seconds
+    Clock::time_point origin;           ///< Time of t = 0
+    bool hasOrigin;                     ///< False until the first sample
+    double sumT, sumV, sumTV, sumTT;    ///< Running sums over the ring
+
+    const Sample& oldest() const { return ring[head]; }                          ///< @return Oldest slot
+    const Sample& newest() const { return ring[(head + count - 1) % CAPACITY]; } ///< @return Newest slot
+
+    /**
+     * @brief Removes the oldest slot from the sums.
+     */
+    void dropOldest();
+
+    /**
+     * @brief Adds a slot's mean to the running sums.
+     * @param s Slot.
+     * @param sign +1 to add, -1 to remove.
+     */
+    void accumulate(const Sample& s, double sign);
+
+    /**
+     * @brief Computes the least-squares slope.
+     * @return km/h per second, 0 until minSpan of history exists.
+     */
+    double slope() const;
+};
+
+#endif // SPEED_TREND_H
@@ -0,0 +1,89 @@
+/**
+ * @file TelemetryLog.cpp
+ * @brief Implements the memory-mapped reader and the writer of telemetry captures.
+ */
+
+#include "TelemetryLog.h"
+#include <cstring>
+
+namespace {
+constexpr char TELEMETRY_LOG_MAGIC[4] = {'A', 'V', 'L', 'G'}; ///< Capture file signature
+}
+
+/**
+ * @brief Maps and validates a capture file.
+ * @param path Capture to open.
+ * @return True if the file is a complete capture of a supported version.
+ */
+bool TelemetryLogView::open(const std::string& path) {
+    records = nullptr;
+    count = 0;
+    if(!file.open(path) || file.size() < sizeof(TelemetryLogHeader)) return false;
+
+    TelemetryLogHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if(std::memcmp(header.magic, TELEMETRY_LOG_MAGIC, sizeof(header.magic)) != 0 ||
+       header.version != TELEMETRY_LOG_VERSION ||
+       header.frameCount > (file.size() - sizeof(header)) / sizeof(TelemetryRecord)) {
+        file.close();
+        return false;
+    }
+
+    file.adviseSequential();
+    records = reinterpret_cast<const TelemetryRecord*>(file.data() + sizeof(header));
+    count = static_cast<std::size_t>(header.frameCount);
+    return true;
+}
+
+/**
+ * @brief Destructor finalizes an open capture.
+ */
+TelemetryLogWriter::~TelemetryLogWriter() {
+    close();
+}
+
+/**
+ * @brief Creates (or truncates) a capture file and writes a provisional header.
+ * @param path Capture to write.
+ * @return True on success.
+ */
+bool TelemetryLogWriter::open(const std::string& path) {
+    close();
+    out = std::fopen(path.c_str(), "wb");
+    if(!out) return false;
+
+    TelemetryLogHeader header{};
+    std::memcpy(header.magic, TELEMETRY_LOG_MAGIC, sizeof(header.magic));
+    header.version = TELEMETRY_LOG_VERSION;
+    written = 0;
+    failed = std::fwrite(&header, sizeof(header), 1, out) != 1;
+    return !failed;
+}
+
+/**
+ * @brief Appends one record (reserved bytes are written as zero).
+ * @param record Frame to write.
+ */
+void TelemetryLogWriter::write(const TelemetryRecord& record) {
+    if(!out) return;
+    TelemetryRecord clean = record;
+    std::memset(clean.reserved, 0, sizeof(clean.reserved));
+    if(std::fwrite(&clean, sizeof(clean), 1, out) == 1) ++written;
+    else failed = true;
+}
+
+/**
+ * @brief Finalizes the header with the record count and closes the file.
+ * @return True if every record was written.
+ */
+bool TelemetryLogWriter::close() {
+    if(!out) return !failed;
+    TelemetryLogHeader header{};
+    std::memcpy(header.magic, TELEMETRY_LOG_MAGIC, sizeof(header.magic));
+    header.version = TELEMETRY_LOG_VERSION;
+    header.frameCount = written;
+    if(std::fseek(out, 0, SEEK_SET) != 0 || std::fwrite(&header, sizeof(header), 1, out) != 1) failed = true;
+    if(std::fclose(out) != 0) failed = true;
+    out = nullptr;
+    return !failed;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file TelemetryLog.h
+ * @brief Defines the binary telemetry capture format and its memory-mapped reader and writer.
+ */
+
+#ifndef TELEMETRY_LOG_H
+#define TELEMETRY_LOG_H
+
+#include "AdaptiveVolumeControl.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+/**
+ * @struct TelemetryLogHeader
+ * @brief Fixed header at the start of every capture file.
+ */
+struct TelemetryLogHeader {
+    char magic[4];              ///< "AVLG"
+    std::uint32_t version;      ///< Format version (TELEMETRY_LOG_VERSION)
+    std::uint64_t frameCount;   ///< Number of records following the header
+};
+
+/**
+ * @struct TelemetryRecord
+ * @brief One timestamped frame carrying the inputs of AdaptiveVolumeControl::update().
+ */
+struct TelemetryRecord {
+    std::int64_t timestampNs;   ///< Monotonic frame time in nanoseconds
+    std::int32_t speed;         ///< Vehicle speed
+    std::int32_t noise;         ///< Cabin noise level
+    std::int32_t manualVolume;  ///< Manual volume value
+    std::uint8_t reverseGear;   ///< Reverse gear status (0/1)
+    std::uint8_t hornActive;    ///< Horn active status (0/1)
+    std::uint8_t navSpeaking;   ///< Navigation speaking status (0/1)
+    std::uint8_t mode;          ///< Mode enumerator value
+    std::uint8_t controlType;   ///< VolumeControlType enumerator value
+    std::uint8_t reserved[7];   ///< Padding, written as zero
+};
+
+static_assert(sizeof(TelemetryLogHeader) == 16, "capture header layout is fixed");
+static_assert(sizeof(TelemetryRecord) == 32, "capture record layout is fixed");
+
+constexpr std::uint32_t TELEMETRY_LOG_VERSION = 1; ///< Current capture format version
+
+/**
+ * @brief Feeds one record into a controller.
+ * @param avc Controller to update.
+ * @param record Frame to apply.
+ */
+inline void applyRecord(AdaptiveVolumeControl& avc, const TelemetryRecord& record) {
+    avc.update(record.speed, record.noise, record.reverseGear != 0, record.hornActive != 0,
+               record.navSpeaking != 0, static_cast<Mode>(record.mode),
+               static_cast<VolumeControlType>(record.controlType), record.manualVolume);
+}
+
+/**
+ * @class TelemetryLogView
+ * @brief Zero-copy view of a capture file mapped into memory.
+ */
+class TelemetryLogView {
+public:
+    /**
+     * @brief Maps and validates a capture file.
+     * @param path Capture to open.
+     * @return True if the file is a complete capture of a supported version.
+     */
+    bool open(const std::string& path);
+
+    const TelemetryRecord* begin() const { return records; }           ///< @return First record
+    const TelemetryRecord* end() const { return records + count; }     ///< @return One past the last record
+    std::size_t size() const { return count; }                         ///< @return Number of records
+
+private:
+    MappedFile file;                          ///< Mapped capture
+    const TelemetryRecord* records = nullptr; ///< Records inside the mapping
+    std::size_t count = 0;                    ///< Number of records
+};
+
+/**
+ * @class TelemetryLogWriter
+ * @brief Writes a capture file record by record.
+ */
+class TelemetryLogWriter {
+public:
+    TelemetryLogWriter() = default;
+    ~TelemetryLogWriter();
+
+    TelemetryLogWriter(const TelemetryLogWriter&) = delete;
+    TelemetryLogWriter& operator=(const TelemetryLogWriter&) = delete;
+
+    /**
+     * @brief Creates (or truncates) a capture file.
+     * @param path Capture to write.
+     * @return True on success.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Appends one record.
+     * @param record Frame to write.
+     */
+    void write(const TelemetryRecord& record);
+
+    /**
+     * @brief Finalizes the header and closes the file.
+     * @return True if every record was written.
+     */
+    bool close();
+
+private:
+    std::FILE* out = nullptr;      ///< Output file
+    std::uint64_t written = 0;     ///< Records written so far
+    bool failed = false;           ///< Set on any write error
+};
+
+#endif // TELEMETRY_LOG_H
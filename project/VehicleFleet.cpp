@@ -0,0 +1,341 @@
+/**
+ * @file VehicleFleet.cpp
+ * @brief Implements the sharded, NUMA-local fleet state and its parallel frame update.
+ */
+
+#include "VehicleFleet.h"
+#include "BasicVolumeControl.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+
+using AVC = AdaptiveVolumeControl;
+
+constexpr std::int64_t HORN_DUCK_DURATION_NS =
+    static_cast<std::int64_t>(AVC::HORN_DUCK_DURATION * 1e9); ///< Horn hold in nanoseconds
+constexpr int MODE_SHIFT = 4;           ///< Position of the mode in the inputs column
+constexpr int MAX_NODES = 64;           ///< NUMA nodes probed in sysfs
+
+static_assert(VehicleFleet::BYTES_PER_VEHICLE <= 32, "per-vehicle state must stay compact");
+
+/**
+ * @struct CpuSlot
+ * @brief CPU a worker may be pinned to.
+ */
+struct CpuSlot {
+    int cpu;    ///< CPU number
+    int node;   ///< NUMA node of the CPU
+};
+
+#ifdef __linux__
+/**
+ * @brief Marks the CPUs of a sysfs cpulist ("0-3,8-11") with their node.
+ * @param path cpulist file.
+ * @param node Node the list belongs to.
+ * @param nodeOf Node per CPU, updated.
+ */
+void readNodeCpus(const char* path, int node, std::vector<int>& nodeOf) {
+    std::FILE* file = std::fopen(path, "r");
+    if(!file) return;
+    int first, last;
+    while(std::fscanf(file, "%d", &first) == 1) {
+        last = first;
+        int separator = std::fgetc(file);
+        if(separator == '-') {
+            if(std::fscanf(file, "%d", &last) != 1) break;
+            separator = std::fgetc(file);
+        }
+        for(int cpu = first; cpu <= last && cpu < static_cast<int>(nodeOf.size()); ++cpu) nodeOf[cpu] = node;
+        if(separator != ',') break;
+    }
+    std::fclose(file);
+}
+#endif
+
+/**
+ * @brief Lists the CPUs this process may run on, grouped by NUMA node.
+ *
+ * Without sysfs every CPU counts as node 0; outside Linux the list is
+ * 0..hardware_concurrency-1 and workers are not pinned.
+ * @return CPUs sorted by (node, cpu).
+ */
+std::vector<CpuSlot> cpusInNodeOrder() {
+    std::vector<CpuSlot> cpus;
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if(sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        std::vector<int> nodeOf(CPU_SETSIZE, 0);
+        char path[64];
+        for(int node = 0; node < MAX_NODES; ++node) {
+            std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+            readNodeCpus(path, node, nodeOf);
+        }
+        for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            if(CPU_ISSET(cpu, &allowed)) cpus.push_back({cpu, nodeOf[cpu]});
+        std::sort(cpus.begin(), cpus.end(), [](const CpuSlot& a, const CpuSlot& b) {
+            return a.node != b.node ? a.node < b.node : a.cpu < b.cpu;
+        });
+    }
+#endif
+    if(cpus.empty()) {
+        unsigned count = std::max(1u, std::thread::hardware_concurrency());
+        for(unsigned cpu = 0; cpu < count; ++cpu) cpus.push_back({static_cast<int>(cpu), 0});
+    }
+    return cpus;
+}
+
+/**
+ * @brief Pins the calling thread to one CPU.
+ * @param cpu CPU number.
+ * @return False if pinning is unsupported or was refused.
+ */
+bool pinCurrentThread(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+/**
+ * @brief Computes the built-in base volume for a runtime mode.
+ * @param speed Vehicle speed.
+ * @param noise Cabin noise level.
+ * @param mode Driving mode.
+ * @return Adaptive volume before event modifiers.
+ */
+inline float baseVolume(int speed, int noise, Mode mode) {
+    switch(mode) {
+        case Mode::ECO: return adaptiveBaseVolumeFor<Mode::ECO>(speed, noise);
+        case Mode::SPORTS: return adaptiveBaseVolumeFor<Mode::SPORTS>(speed, noise);
+        default: return adaptiveBaseVolumeFor<Mode::COMFORT>(speed, noise);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Constructor allocates the shards on their workers and waits until they are initialized.
+ * @param config Fleet parameters.
+ */
+VehicleFleet::VehicleFleet(const FleetConfig& config)
+    : vehicles(config.vehicles), blockVehicles(std::max<std::uint32_t>(1, config.blockVehicles)),
+      tickDt(AVC::SMOOTH_INTERVAL), tickFactor(AVC::SMOOTH_FACTOR) {
+    std::vector<CpuSlot> cpus = cpusInNodeOrder();
+    unsigned workers = config.threads ? config.threads : static_cast<unsigned>(cpus.size());
+
+    // Shards on block boundaries, split exactly like WorkStealingPool::parallelFor() splits the blocks
+    std::uint32_t blocks = static_cast<std::uint32_t>((std::uint64_t(vehicles) + blockVehicles - 1) / blockVehicles);
+    shards.resize(workers);
+    blockShard.resize(blocks);
+    for(unsigned id = 0; id < workers; ++id) {
+        std::uint32_t begin = static_cast<std::uint32_t>(std::uint64_t(blocks) * id / workers);
+        std::uint32_t end = static_cast<std::uint32_t>(std::uint64_t(blocks) * (id + 1) / workers);
+        Shard& shard = shards[id];
+        shard.first = static_cast<std::uint32_t>(std::min<std::uint64_t>(std::uint64_t(begin) * blockVehicles, vehicles));
+        shard.count = static_cast<std::uint32_t>(std::min<std::uint64_t>(std::uint64_t(end) * blockVehicles, vehicles)) - shard.first;
+        shard.node = cpus[id % cpus.size()].node;
+        for(std::uint32_t block = begin; block < end; ++block) blockShard[block] = id;
+    }
+
+    // Each worker pins itself and first-touches its own shard before taking jobs
+    std::mutex mutex;
+    std::condition_variable ready;
+    unsigned initialized = 0;
+    bool pin = config.pinThreads;
+    pool.reset(new WorkStealingPool(workers, [&, pin](unsigned id) {
+        Shard& shard = shards[id];
+        int cpu = cpus[id % cpus.size()].cpu;
+        if(pin && pinCurrentThread(cpu)) shard.cpu = cpu;
+        initializeShard(shard);
+        std::lock_guard<std::mutex> lock(mutex);
+        if(++initialized == shards.size()) ready.notify_one();
+    }));
+    std::unique_lock<std::mutex> lock(mutex);
+    ready.wait(lock, [&] { return initialized == shards.size(); });
+}
+
+/**
+ * @brief Destructor stops the workers.
+ */
+VehicleFleet::~VehicleFleet() = default;
+
+/**
+ * @brief Allocates and first-touches a shard on the calling (pinned) worker.
+ * @param shard Shard to initialize.
+ */
+void VehicleFleet::initializeShard(Shard& shard) {
+    std::uint32_t n = shard.count;
+    shard.speed.reset(new std::int16_t[n]);
+    shard.appliedSpeed.reset(new std::int16_t[n]);
+    shard.cabinNoise.reset(new std::uint8_t[n]);
+    shard.manualVolume.reset(new std::uint8_t[n]);
+    shard.inputs.reset(new std::uint8_t[n]);
+    shard.hornDuck.reset(new std::uint8_t[n]);
+    shard.hornDuckStartNs.reset(new std::int64_t[n]);
+    shard.targetVolume.reset(new float[n]);
+    shard.currentVolume.reset(new float[n]);
+
+    // Defaults of a new AdaptiveVolumeControl; the first write places each page on this worker's node
+    ControlInputs defaults;
+    std::uint8_t inputs = static_cast<std::uint8_t>(static_cast<int>(defaults.mode) << MODE_SHIFT);
+    for(std::uint32_t i = 0; i < n; ++i) {
+        shard.speed[i] = static_cast<std::int16_t>(defaults.speed);
+        shard.appliedSpeed[i] = static_cast<std::int16_t>(defaults.speed);
+        shard.cabinNoise[i] = static_cast<std::uint8_t>(defaults.cabinNoise);
+        shard.manualVolume[i] = static_cast<std::uint8_t>(defaults.manualVolume);
+        shard.inputs[i] = inputs;
+        shard.hornDuck[i] = 0;
+        shard.hornDuckStartNs[i] = 0;
+        shard.targetVolume[i] = AVC::DEFAULT_VOLUME;
+        shard.currentVolume[i] = AVC::DEFAULT_VOLUME;
+    }
+}
+
+/**
+ * @brief Stages the inputs of a batch for the next advance().
+ * @param records Telemetry records.
+ * @param count Number of records.
+ * @return Records accepted (unknown vehicles and invalid modes are skipped).
+ */
+std::size_t VehicleFleet::ingest(const FleetTelemetry* records, std::size_t count) {
+    std::size_t accepted = 0;
+    for(std::size_t r = 0; r < count; ++r) {
+        const FleetTelemetry& record = records[r];
+        if(record.vehicle >= vehicles || record.mode > static_cast<std::uint8_t>(Mode::SPORTS)) continue;
+        Shard& shard = shards[blockShard[record.vehicle / blockVehicles]];
+        std::uint32_t i = record.vehicle - shard.first;
+        std::uint8_t flags = record.flags & (FLEET_REVERSE | FLEET_HORN | FLEET_NAVIGATION | FLEET_MANUAL);
+        shard.speed[i] = record.speed;
+        shard.cabinNoise[i] = record.cabinNoise;
+        shard.inputs[i] = static_cast<std::uint8_t>(flags | record.mode << MODE_SHIFT);
+        if(flags & FLEET_MANUAL) shard.manualVolume[i] = record.manualVolume;
+        ++accepted;
+    }
+    return accepted;
+}
+
+/**
+ * @brief Runs one control frame for every vehicle in parallel.
+ * @param timestampNs Frame time in monotonic nanoseconds (must not go backwards).
+ * @param dt Elapsed time in seconds for the smoothing step.
+ */
+void VehicleFleet::advance(std::int64_t timestampNs, double dt) {
+    // Same factor as tick(dt), computed once per frame for the whole fleet
+    if(dt != tickDt) {
+        tickDt = dt;
+        tickFactor = 1.0f - static_cast<float>(std::pow(1.0 - AVC::SMOOTH_FACTOR, dt / AVC::SMOOTH_INTERVAL));
+    }
+    float factor = tickFactor;
+    pool->parallelFor(static_cast<std::uint32_t>(blockShard.size()), 1, [&](unsigned, std::uint32_t block) {
+        Shard& shard = shards[blockShard[block]];
+        std::uint32_t begin = block * blockVehicles - shard.first;
+        std::uint32_t end = std::min(begin + blockVehicles, shard.count);
+        advanceRange(shard, begin, end, timestampNs, factor);
+    });
+}
+
+/**
+ * @brief Runs one frame for vehicles [begin, end) of a shard.
+ * @param shard Shard.
+ * @param begin First local index.
+ * @param end One past the last local index.
+ * @param timestampNs Frame time.
+ * @param factor Smoothing factor of the frame.
+ */
+void VehicleFleet::advanceRange(Shard& shard, std::uint32_t begin, std::uint32_t end, std::int64_t timestampNs, float factor) {
+    for(std::uint32_t i = begin; i < end; ++i) {
+        std::uint8_t inputs = shard.inputs[i];
+        int speed = shard.speed[i];
+        int previousSpeed = shard.appliedSpeed[i];
+        shard.appliedSpeed[i] = static_cast<std::int16_t>(speed);
+
+        // Same hold as AdaptiveVolumeControl::handleHornDucking()
+        bool hornDuck = shard.hornDuck[i];
+        if(inputs & FLEET_HORN) {
+            hornDuck = true;
+            shard.hornDuckStartNs[i] = timestampNs;
+        } else if(hornDuck && timestampNs - shard.hornDuckStartNs[i] >= HORN_DUCK_DURATION_NS) {
+            hornDuck = false;
+        }
+        shard.hornDuck[i] = hornDuck;
+
+        float target;
+        if(inputs & FLEET_MANUAL) {
+            target = std::min<float>(shard.manualVolume[i], AVC::MAX_VOLUME);
+        } else {
+            bool reverse = inputs & FLEET_REVERSE;
+            std::uint8_t modifiers = 0;
+            if(hornDuck) modifiers |= MODIFIER_HORN_DUCK;
+            if(inputs & FLEET_NAVIGATION) modifiers |= MODIFIER_NAVIGATION;
+            if(reverse) modifiers |= MODIFIER_REVERSE;
+            else if(previousSpeed - speed > AVC::SUDDEN_BRAKE_THRESHOLD) modifiers |= MODIFIER_SUDDEN_BRAKE;
+            else if(speed < previousSpeed) modifiers |= MODIFIER_SPEED_DECREASE;
+
+            Mode mode = static_cast<Mode>(inputs >> MODE_SHIFT);
+            target = scaleByModifiers(baseVolume(speed, shard.cabinNoise[i], mode), modifiers);
+            if(target < AVC::MIN_VOLUME) target = AVC::MIN_VOLUME;
+            if(target > AVC::MAX_ADAPTIVE_VOLUME) target = AVC::MAX_ADAPTIVE_VOLUME;
+        }
+        shard.targetVolume[i] = target;
+
+        // LinearSmoothing::step() with the frame's factor
+        float current = shard.currentVolume[i];
+        if(std::abs(current - target) > AVC::SETTLE_THRESHOLD) {
+            current += (target - current) * factor;
+            if(std::abs(current - target) <= AVC::SETTLE_THRESHOLD) current = target;
+        } else {
+            current = target;
+        }
+        shard.currentVolume[i] = current;
+    }
+}
+
+/**
+ * @brief Gathers the current volume of each record's vehicle, e.g. for a batch reply.
+ * @param records Telemetry records.
+ * @param count Number of records.
+ * @param volumes Output, count entries (NaN for unknown vehicles).
+ */
+void VehicleFleet::trace(const FleetTelemetry* records, std::size_t count, float* volumes) const {
+    for(std::size_t r = 0; r < count; ++r) {
+        std::uint32_t vehicle = records[r].vehicle;
+        volumes[r] = vehicle < vehicles ? getCurrentVolume(vehicle) : std::numeric_limits<float>::quiet_NaN();
+    }
+}
+
+/**
+ * @brief Gets the current volume of one vehicle.
+ * @param vehicle Vehicle index (< getVehicles()).
+ * @return Smoothed volume after the last advance().
+ */
+float VehicleFleet::getCurrentVolume(std::uint32_t vehicle) const {
+    const Shard& shard = shardOf(vehicle);
+    return shard.currentVolume[vehicle - shard.first];
+}
+
+/**
+ * @brief Gets the target volume of one vehicle.
+ * @param vehicle Vehicle index (< getVehicles()).
+ * @return Target volume of the last advance().
+ */
+float VehicleFleet::getTargetVolume(std::uint32_t vehicle) const {
+    const Shard& shard = shardOf(vehicle);
+    return shard.targetVolume[vehicle - shard.first];
+}
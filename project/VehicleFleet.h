@@ -0,0 +1,230 @@
+/**
+ * @file VehicleFleet.h
+ * @brief Defines the VehicleFleet holding compact controller state for millions of vehicles in NUMA-local shards.
+ */
+
+#ifndef VEHICLE_FLEET_H
+#define VEHICLE_FLEET_H
+
+#include "AdaptiveVolumeControl.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class WorkStealingPool;
+
+/**
+ * @enum FleetInputFlag
+ * @brief Boolean inputs of a FleetTelemetry record (bit flags).
+ */
+enum FleetInputFlag : std::uint8_t {
+    FLEET_REVERSE    = 1u << 0, ///< Reverse gear engaged
+    FLEET_HORN       = 1u << 1, ///< Horn active
+    FLEET_NAVIGATION = 1u << 2, ///< Navigation prompt speaking
+    FLEET_MANUAL     = 1u << 3  ///< Manual volume control (manualVolume applies)
+};
+
+/**
+ * @struct FleetTelemetry
+ * @brief One vehicle's inputs in a telemetry batch; also the wire record (12 bytes, little-endian).
+ */
+struct FleetTelemetry {
+    std::uint32_t vehicle;          ///< Vehicle index in [0, vehicles)
+    std::int16_t speed;             ///< Vehicle speed
+    std::uint8_t cabinNoise;        ///< Cabin noise level
+    std::uint8_t manualVolume;      ///< Manual volume (applied with FLEET_MANUAL only)
+    std::uint8_t flags;             ///< FleetInputFlag bits
+    std::uint8_t mode;              ///< Driving mode (Mode value, 0..2)
+    std::uint16_t reserved;         ///< Zero
+};
+
+static_assert(sizeof(FleetTelemetry) == 12, "FleetTelemetry is a wire record");
+
+constexpr std::uint32_t FLEET_BATCH_MAGIC = 0x31544C46; ///< "FLT1": telemetry batch, followed by FleetTelemetry records
+constexpr std::uint32_t FLEET_TRACE_MAGIC = 0x31525446; ///< "FTR1": reply, followed by one float volume per record
+
+/**
+ * @struct FleetFrameHeader
+ * @brief Header of a telemetry batch and of its volume-trace reply (16 bytes, little-endian).
+ */
+struct FleetFrameHeader {
+    std::uint32_t magic;            ///< FLEET_BATCH_MAGIC or FLEET_TRACE_MAGIC
+    std::uint32_t count;            ///< Records (or volumes) following the header
+    std::int64_t timestampNs;       ///< Frame time in monotonic nanoseconds
+};
+
+static_assert(sizeof(FleetFrameHeader) == 16, "FleetFrameHeader is a wire header");
+
+/**
+ * @brief Unpacks a telemetry record into controller inputs.
+ * @param record Wire record.
+ * @return Inputs as passed to AdaptiveVolumeControl::update().
+ */
+inline ControlInputs fleetInputs(const FleetTelemetry& record) {
+    ControlInputs inputs;
+    inputs.speed = record.speed;
+    inputs.cabinNoise = record.cabinNoise;
+    inputs.manualVolume = record.manualVolume;
+    inputs.mode = static_cast<Mode>(record.mode);
+    inputs.controlType = record.flags & FLEET_MANUAL ? VolumeControlType::MANUAL : VolumeControlType::ADAPTIVE;
+    inputs.reverseGear = record.flags & FLEET_REVERSE;
+    inputs.hornActive = record.flags & FLEET_HORN;
+    inputs.navSpeaking = record.flags & FLEET_NAVIGATION;
+    return inputs;
+}
+
+/**
+ * @struct FleetConfig
+ * @brief Parameters of a VehicleFleet.
+ */
+struct FleetConfig {
+    std::uint32_t vehicles = 0;         ///< Number of vehicles
+    unsigned threads = 0;               ///< Workers, one shard each (0 = every CPU the process may run on)
+    std::uint32_t blockVehicles = 4096; ///< Vehicles per scheduling block
+    bool pinThreads = true;             ///< Pin worker w to the w-th allowed CPU in NUMA node order
+};
+
+/**
+ * @class VehicleFleet
+ * @brief Built-in volume policy for a whole fleet, one structure-of-arrays column per state field.
+ *
+ * Every vehicle costs BYTES_PER_VEHICLE bytes (no vtable, clock or sink),
+ * and advance() runs each vehicle exactly like RuntimeVolumeControl
+ * update(inputs) followed by tick(dt) at the frame time: targets and
+ * volumes are bit-identical. They also match AdaptiveVolumeControl
+ * update(inputs, now) / tick(dt) from the vehicle's first record with
+ * non-default inputs on (a new facade keeps DEFAULT_VOLUME until then).
+ *
+ * Vehicles are split into contiguous shards, one per worker, on block
+ * boundaries. Each worker pins itself to a CPU (CPUs ordered by NUMA node)
+ * and allocates and initializes its own shard, so first-touch places the
+ * shard's pages on the worker's node. advance() hands the blocks to a
+ * WorkStealingPool whose initial split matches the shards; only imbalance
+ * makes a worker steal blocks from a neighbour.
+ *
+ * ingest(), advance() and the getters must be called from one thread.
+ */
+class VehicleFleet {
+public:
+    /// State bytes per vehicle across all columns
+    static constexpr std::size_t BYTES_PER_VEHICLE = 2 * sizeof(std::int16_t) + 4 * sizeof(std::uint8_t) +
+                                                     sizeof(std::int64_t) + 2 * sizeof(float);
+
+    /**
+     * @brief Constructor allocates the shards on their workers and waits until they are initialized.
+     *
+     * Every vehicle starts like a new AdaptiveVolumeControl.
+     * @param config Fleet parameters.
+     */
+    explicit VehicleFleet(const FleetConfig& config);
+
+    /**
+     * @brief Destructor stops the workers.
+     */
+    ~VehicleFleet();
+
+    VehicleFleet(const VehicleFleet&) = delete;
+    VehicleFleet& operator=(const VehicleFleet&) = delete;
+
+    /**
+     * @brief Stages the inputs of a batch for the next advance().
+     *
+     * A record replaces all inputs of its vehicle (the manual volume only
+     * with FLEET_MANUAL, as update() does); vehicles without a record keep
+     * theirs. A later record for the same vehicle wins.
+     * @param records Telemetry records.
+     * @param count Number of records.
+     * @return Records accepted (unknown vehicles and invalid modes are skipped).
+     */
+    std::size_t ingest(const FleetTelemetry* records, std::size_t count);
+
+    /**
+     * @brief Runs one control frame for every vehicle in parallel.
+     * @param timestampNs Frame time in monotonic nanoseconds (must not go backwards).
+     * @param dt Elapsed time in seconds for the smoothing step.
+     */
+    void advance(std::int64_t timestampNs, double dt);
+
+    /**
+     * @brief Gathers the current volume of each record's vehicle, e.g. for a batch reply.
+     * @param records Telemetry records.
+     * @param count Number of records.
+     * @param volumes Output, count entries (NaN for unknown vehicles).
+     */
+    void trace(const FleetTelemetry* records, std::size_t count, float* volumes) const;
+
+    /**
+     * @brief Gets the current volume of one vehicle.
+     * @param vehicle Vehicle index (< getVehicles()).
+     * @return Smoothed volume after the last advance().
+     */
+    float getCurrentVolume(std::uint32_t vehicle) const;
+
+    /**
+     * @brief Gets the target volume of one vehicle.
+     * @param vehicle Vehicle index (< getVehicles()).
+     * @return Target volume of the last advance().
+     */
+    float getTargetVolume(std::uint32_t vehicle) const;
+
+    std::uint32_t getVehicles() const { return vehicles; }                              ///< @return Number of vehicles
+    unsigned getShards() const { return static_cast<unsigned>(shards.size()); }         ///< @return Number of shards (= workers)
+    std::uint32_t getShardVehicles(unsigned shard) const { return shards[shard].count; } ///< @return Vehicles in a shard
+    int getShardNode(unsigned shard) const { return shards[shard].node; }               ///< @return NUMA node of a shard's worker
+    int getShardCpu(unsigned shard) const { return shards[shard].cpu; }                 ///< @return CPU of a shard's worker (-1 = not pinned)
+
+private:
+    /**
+     * @struct Shard
+     * @brief Contiguous vehicle range owned by one worker, allocated on its node.
+     */
+    struct Shard {
+        std::uint32_t first = 0;                        ///< First vehicle
+        std::uint32_t count = 0;                        ///< Number of vehicles
+        int node = 0;                                   ///< NUMA node of the worker
+        int cpu = -1;                                   ///< CPU the worker is pinned to (-1 = not pinned)
+        std::unique_ptr<std::int16_t[]> speed;          ///< Latest speed input
+        std::unique_ptr<std::int16_t[]> appliedSpeed;   ///< Speed of the last advance (previous speed of the next)
+        std::unique_ptr<std::uint8_t[]> cabinNoise;     ///< Cabin noise input
+        std::unique_ptr<std::uint8_t[]> manualVolume;   ///< Manual volume
+        std::unique_ptr<std::uint8_t[]> inputs;         ///< FleetInputFlag bits, mode in bits 4-5
+        std::unique_ptr<std::uint8_t[]> hornDuck;       ///< Horn ducking (or its hold) active
+        std::unique_ptr<std::int64_t[]> hornDuckStartNs; ///< Start of the running horn-duck hold
+        std::unique_ptr<float[]> targetVolume;          ///< Target volume
+        std::unique_ptr<float[]> currentVolume;         ///< Current volume
+    };
+
+    std::uint32_t vehicles;                     ///< Number of vehicles
+    std::uint32_t blockVehicles;                ///< Vehicles per block
+    std::vector<Shard> shards;                  ///< One shard per worker
+    std::vector<std::uint32_t> blockShard;      ///< Shard of every block
+    double tickDt;                              ///< Elapsed time the cached factor was computed for
+    float tickFactor;                           ///< Smoothing factor for tickDt
+    std::unique_ptr<WorkStealingPool> pool;     ///< Workers (declared last: stopped before the shards go)
+
+    /**
+     * @brief Allocates and first-touches a shard on the calling (pinned) worker.
+     * @param shard Shard to initialize.
+     */
+    static void initializeShard(Shard& shard);
+
+    /**
+     * @brief Runs one frame for vehicles [begin, end) of a shard.
+     * @param shard Shard.
+     * @param begin First local index.
+     * @param end One past the last local index.
+     * @param timestampNs Frame time.
+     * @param factor Smoothing factor of the frame.
+     */
+    static void advanceRange(Shard& shard, std::uint32_t begin, std::uint32_t end, std::int64_t timestampNs, float factor);
+
+    /**
+     * @brief Finds a vehicle's shard.
+     * @param vehicle Vehicle index (< vehicles).
+     * @return Shard holding the vehicle.
+     */
+    const Shard& shardOf(std::uint32_t vehicle) const { return shards[blockShard[vehicle / blockVehicles]]; }
+};
+
+#endif // VEHICLE_FLEET_H
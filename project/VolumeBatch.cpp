@@ -0,0 +1,209 @@
+/**
+ * @file VolumeBatch.cpp
+ * @brief Implements batch evaluation of the volume policy over structure-of-arrays telemetry.
+ */
+
+#include "VolumeBatch.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VOLUME_BATCH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+using AVC = AdaptiveVolumeControl;
+
+constexpr std::size_t CHUNK_FRAMES = 256; ///< Frames resolved per horn-duck prepass
+constexpr std::int64_t HORN_DUCK_DURATION_NS =
+    static_cast<std::int64_t>(AVC::HORN_DUCK_DURATION * 1e9); ///< Horn hold in nanoseconds
+
+static_assert(sizeof(bool) == 1, "bool columns are loaded as bytes");
+static_assert(sizeof(Mode) == 4 && sizeof(VolumeControlType) == 4, "enum columns are loaded as 32-bit lanes");
+
+/**
+ * @brief Resolves the horn duck flag of each frame (the only inherently sequential step).
+ *
+ * Mirrors handleHornDucking(): an active horn restarts the hold, otherwise the
+ * duck ends once HORN_DUCK_DURATION has passed since the last horn frame.
+ *
+ * @param frames Input columns.
+ * @param begin First frame.
+ * @param end One past the last frame.
+ * @param duck Output flags, end - begin entries.
+ * @param state Horn duck state, updated.
+ */
+void resolveHornDuck(const TelemetryColumns& frames, std::size_t begin, std::size_t end,
+                     bool* duck, BatchState& state) {
+    for(std::size_t i = begin; i < end; ++i) {
+        std::int64_t now = frames.timestampNs[i];
+        if(frames.hornActive[i]) {
+            state.hornDuckActive = true;
+            state.hornDuckStartNs = now;
+        } else if(state.hornDuckActive && now - state.hornDuckStartNs >= HORN_DUCK_DURATION_NS) {
+            state.hornDuckActive = false;
+        }
+        duck[i - begin] = state.hornDuckActive;
+    }
+}
+
+/**
+ * @brief Branch-free scalar evaluation of one frame.
+ * @return Target volume.
+ */
+inline float evaluateFrame(int speed, int previousSpeed, int noise, bool reverseGear, bool hornDuck,
+                           bool navSpeaking, Mode mode, VolumeControlType controlType, int manualVolume) {
+    int boost = speed > AVC::HIGH_SPEED_THRESHOLD ? AVC::HIGH_SPEED_BOOST
+              : speed > AVC::LOW_SPEED_THRESHOLD ? AVC::MEDIUM_SPEED_BOOST
+              : speed > 0 ? AVC::LOW_SPEED_BOOST : 0;
+
+    float volume = AVC::BASE_VOLUME + static_cast<float>(boost);
+    volume += noise * AVC::NOISE_SLOPE;
+    volume *= mode == Mode::ECO ? AVC::ECO_MULTIPLIER : mode == Mode::SPORTS ? AVC::SPORTS_MULTIPLIER : 1.0f;
+
+    bool suddenBrake = !reverseGear && previousSpeed - speed > AVC::SUDDEN_BRAKE_THRESHOLD;
+    bool speedDecrease = !reverseGear && !suddenBrake && speed < previousSpeed;
+    volume *= hornDuck ? AVC::HORN_DUCK_MULTIPLIER : 1.0f;
+    volume *= navSpeaking ? AVC::NAV_DUCK_MULTIPLIER : 1.0f;
+    volume *= reverseGear ? AVC::REVERSE_MULTIPLIER : 1.0f;
+    volume *= suddenBrake ? AVC::SUDDEN_BRAKE_MULTIPLIER : speedDecrease ? AVC::SPEED_DECREASE_MULTIPLIER : 1.0f;
+
+    volume = volume < AVC::MIN_VOLUME ? AVC::MIN_VOLUME : volume;
+    volume = volume > AVC::MAX_ADAPTIVE_VOLUME ? AVC::MAX_ADAPTIVE_VOLUME : volume;
+
+    float manualTarget = std::clamp<float>(manualVolume, AVC::MIN_VOLUME, AVC::MAX_VOLUME);
+    return controlType == VolumeControlType::MANUAL ? manualTarget : volume;
+}
+
+/**
+ * @brief Scalar evaluation of frames [begin, end).
+ */
+void evaluateScalar(const TelemetryColumns& f, std::size_t begin, std::size_t end,
+                    const bool* duck, std::size_t duckBase, int previousSpeed, float* out) {
+    for(std::size_t i = begin; i < end; ++i) {
+        out[i] = evaluateFrame(f.speed[i], previousSpeed, f.noise[i], f.reverseGear[i], duck[i - duckBase],
+                               f.navSpeaking[i], f.mode[i], f.controlType[i], f.manualVolume[i]);
+        previousSpeed = f.speed[i];
+    }
+}
+
+#if VOLUME_BATCH_SSE2
+/**
+ * @brief Picks a where mask is set, b elsewhere.
+ */
+inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+/**
+ * @brief Loads four bool bytes as 32-bit lane masks.
+ */
+inline __m128i loadFlags(const bool* flags) {
+    std::int32_t packed;
+    std::memcpy(&packed, flags, sizeof(packed));
+    __m128i zero = _mm_setzero_si128();
+    __m128i lanes = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+    return _mm_cmpgt_epi32(lanes, zero);
+}
+
+/**
+ * @brief SSE2 evaluation of frames [begin, end); begin must be >= 1 so the previous speed is in the column.
+ * @return First frame not processed (the caller finishes the tail).
+ */
+std::size_t evaluateSse2(const TelemetryColumns& f, std::size_t begin, std::size_t end,
+                         const bool* duck, std::size_t duckBase, float* out) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lowThreshold = _mm_set1_epi32(AVC::LOW_SPEED_THRESHOLD);
+    const __m128i highThreshold = _mm_set1_epi32(AVC::HIGH_SPEED_THRESHOLD);
+    const __m128i brakeThreshold = _mm_set1_epi32(AVC::SUDDEN_BRAKE_THRESHOLD);
+    const __m128i eco = _mm_set1_epi32(static_cast<int>(Mode::ECO));
+    const __m128i sports = _mm_set1_epi32(static_cast<int>(Mode::SPORTS));
+    const __m128i manual = _mm_set1_epi32(static_cast<int>(VolumeControlType::MANUAL));
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    std::size_t i = begin;
+    for(; i + 4 <= end; i += 4) {
+        __m128i speed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f.speed + i));
+        __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f.speed + i - 1));
+        __m128i noise = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f.noise + i));
+        __m128i mode = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f.mode + i));
+        __m128i type = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f.controlType + i));
+        __m128i manualVolume = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f.manualVolume + i));
+        __m128 reverse = _mm_castsi128_ps(loadFlags(f.reverseGear + i));
+        __m128 nav = _mm_castsi128_ps(loadFlags(f.navSpeaking + i));
+        __m128 horn = _mm_castsi128_ps(loadFlags(duck + (i - duckBase)));
+
+        // Speed bucket: nested thresholds select the highest boost that applies
+        __m128i aboveHigh = _mm_cmpgt_epi32(speed, highThreshold);
+        __m128i aboveLow = _mm_cmpgt_epi32(speed, lowThreshold);
+        __m128i moving = _mm_cmpgt_epi32(speed, zero);
+        __m128i boost = _mm_and_si128(moving, _mm_set1_epi32(AVC::LOW_SPEED_BOOST));
+        boost = _mm_or_si128(_mm_and_si128(aboveLow, _mm_set1_epi32(AVC::MEDIUM_SPEED_BOOST)),
+                             _mm_andnot_si128(aboveLow, boost));
+        boost = _mm_or_si128(_mm_and_si128(aboveHigh, _mm_set1_epi32(AVC::HIGH_SPEED_BOOST)),
+                             _mm_andnot_si128(aboveHigh, boost));
+
+        __m128 volume = _mm_add_ps(_mm_set1_ps(AVC::BASE_VOLUME), _mm_cvtepi32_ps(boost));
+        volume = _mm_add_ps(volume, _mm_mul_ps(_mm_cvtepi32_ps(noise), _mm_set1_ps(AVC::NOISE_SLOPE)));
+        __m128 modeMultiplier = select(_mm_castsi128_ps(_mm_cmpeq_epi32(mode, eco)), _mm_set1_ps(AVC::ECO_MULTIPLIER),
+                                select(_mm_castsi128_ps(_mm_cmpeq_epi32(mode, sports)),
+                                       _mm_set1_ps(AVC::SPORTS_MULTIPLIER), one));
+        volume = _mm_mul_ps(volume, modeMultiplier);
+
+        // Modifiers, applied in the same order as applyVolumeModifiers()
+        __m128 brake = _mm_andnot_ps(reverse, _mm_castsi128_ps(
+                           _mm_cmpgt_epi32(_mm_sub_epi32(previous, speed), brakeThreshold)));
+        __m128 decrease = _mm_andnot_ps(_mm_or_ps(reverse, brake),
+                                        _mm_castsi128_ps(_mm_cmplt_epi32(speed, previous)));
+        volume = _mm_mul_ps(volume, select(horn, _mm_set1_ps(AVC::HORN_DUCK_MULTIPLIER), one));
+        volume = _mm_mul_ps(volume, select(nav, _mm_set1_ps(AVC::NAV_DUCK_MULTIPLIER), one));
+        volume = _mm_mul_ps(volume, select(reverse, _mm_set1_ps(AVC::REVERSE_MULTIPLIER), one));
+        volume = _mm_mul_ps(volume, select(brake, _mm_set1_ps(AVC::SUDDEN_BRAKE_MULTIPLIER),
+                                    select(decrease, _mm_set1_ps(AVC::SPEED_DECREASE_MULTIPLIER), one)));
+
+        // Operand order keeps the scalar semantics (the second operand wins on ties)
+        volume = _mm_max_ps(_mm_set1_ps(AVC::MIN_VOLUME), volume);
+        volume = _mm_min_ps(_mm_set1_ps(AVC::MAX_ADAPTIVE_VOLUME), volume);
+
+        __m128 manualTarget = _mm_max_ps(_mm_cvtepi32_ps(manualVolume), _mm_set1_ps(AVC::MIN_VOLUME));
+        manualTarget = _mm_min_ps(manualTarget, _mm_set1_ps(AVC::MAX_VOLUME));
+        volume = select(_mm_castsi128_ps(_mm_cmpeq_epi32(type, manual)), manualTarget, volume);
+        _mm_storeu_ps(out + i, volume);
+    }
+    return i;
+}
+#endif // VOLUME_BATCH_SSE2
+
+} // namespace
+
+/**
+ * @brief Evaluates the target volume of every frame, as update() would frame by frame.
+ * @param frames Input columns.
+ * @param count Number of frames.
+ * @param targetVolume Output, count entries.
+ * @param state State from the previous batch, updated to the last frame.
+ */
+void calculateTargetVolumeBatch(const TelemetryColumns& frames, std::size_t count,
+                                float* targetVolume, BatchState& state) {
+    bool duck[CHUNK_FRAMES];
+
+    for(std::size_t begin = 0; begin < count; begin += CHUNK_FRAMES) {
+        std::size_t end = std::min(count, begin + CHUNK_FRAMES);
+        resolveHornDuck(frames, begin, end, duck, state);
+
+        // The first frame of the stream compares against the carried-over speed
+        std::size_t next = begin;
+        if(begin == 0) {
+            evaluateScalar(frames, 0, 1, duck, begin, state.previousSpeed, targetVolume);
+            next = 1;
+        }
+#if VOLUME_BATCH_SSE2
+        next = evaluateSse2(frames, next, end, duck, begin, targetVolume);
+#endif
+        evaluateScalar(frames, next, end, duck, begin, frames.speed[next - 1], targetVolume);
+    }
+
+    if(count > 0) state.previousSpeed = frames.speed[count - 1];
+}
@@ -0,0 +1,59 @@
+/**
+ * @file VolumeBatch.h
+ * @brief Declares batch evaluation of the volume policy over structure-of-arrays telemetry.
+ */
+
+#ifndef VOLUME_BATCH_H
+#define VOLUME_BATCH_H
+
+#include "AdaptiveVolumeControl.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct TelemetryColumns
+ * @brief Structure-of-arrays view of logged telemetry frames (one entry per frame in every column).
+ */
+struct TelemetryColumns {
+    const std::int64_t* timestampNs;        ///< Monotonic frame time in nanoseconds (Clock::time_point count)
+    const int* speed;                       ///< Vehicle speed
+    const int* noise;                       ///< Cabin noise level
+    const bool* reverseGear;                ///< Reverse gear status
+    const bool* hornActive;                 ///< Horn active status
+    const bool* navSpeaking;                ///< Navigation speaking status
+    const Mode* mode;                       ///< Driving mode
+    const VolumeControlType* controlType;   ///< Volume control type
+    const int* manualVolume;                ///< Manual volume value
+};
+
+/**
+ * @struct BatchState
+ * @brief State carried across consecutive batches (previous speed, horn duck hold).
+ *
+ * Default values match a freshly constructed AdaptiveVolumeControl.
+ */
+struct BatchState {
+    int previousSpeed = 0;               ///< Speed of the last frame evaluated
+    bool hornDuckActive = false;         ///< Horn ducking active after the last frame
+    std::int64_t hornDuckStartNs = 0;    ///< Time of the last frame with the horn pressed
+};
+
+/**
+ * @brief Evaluates the target volume of every frame, as update() would frame by frame.
+ *
+ * The speed buckets, noise term, mode multiplier, modifiers and clamping are
+ * computed branch-free, four frames at a time with SSE2 where available. The
+ * sequential parts (brake detection against the previous frame, horn duck
+ * hold) carry over between calls through @p state. Results are bit-identical
+ * to AdaptiveVolumeControl::getTargetVolume() after the same update() sequence
+ * driven by a ManualClock set to each frame's timestamp.
+ *
+ * @param frames Input columns.
+ * @param count Number of frames.
+ * @param targetVolume Output, count entries.
+ * @param state State from the previous batch, updated to the last frame.
+ */
+void calculateTargetVolumeBatch(const TelemetryColumns& frames, std::size_t count,
+                                float* targetVolume, BatchState& state);
+
+#endif // VOLUME_BATCH_H
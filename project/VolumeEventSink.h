@@ -0,0 +1,57 @@
+/**
+ * @file VolumeEventSink.h
+ * @brief Defines the observer interface for AdaptiveVolumeControl events and volume steps.
+ */
+
+#ifndef VOLUME_EVENT_SINK_H
+#define VOLUME_EVENT_SINK_H
+
+#include "AdaptiveVolumeControl.h"
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @class VolumeEventSink
+ * @brief Optional observer notified by AdaptiveVolumeControl.
+ *
+ * All callbacks default to no-ops so a sink only overrides what it needs.
+ */
+class VolumeEventSink {
+public:
+    virtual ~VolumeEventSink() = default;
+
+    /**
+     * @brief Called when the horn input changes state.
+     * @param pressed True if the horn was pressed, false if released.
+     */
+    virtual void onHornChanged(bool pressed) { (void)pressed; }
+
+    /**
+     * @brief Called after a target volume has been calculated in adaptive mode.
+     * @param modifiers VolumeModifier bits that were applied.
+     */
+    virtual void onModifiersApplied(std::uint8_t modifiers) { (void)modifiers; }
+
+    /**
+     * @brief Called when an event starts being displayed/smoothed.
+     * @param eventName Name of the event.
+     * @param avc Controller state at the start of the event.
+     */
+    virtual void onEventStart(std::string_view eventName, const AdaptiveVolumeControl& avc) {
+        (void)eventName; (void)avc;
+    }
+
+    /**
+     * @brief Called after each smoothing step.
+     * @param currentVolume Current volume after the step.
+     */
+    virtual void onVolumeStep(float currentVolume) { (void)currentVolume; }
+
+    /**
+     * @brief Called once the current volume has reached the target.
+     * @param currentVolume Final volume.
+     */
+    virtual void onTargetReached(float currentVolume) { (void)currentVolume; }
+};
+
+#endif // VOLUME_EVENT_SINK_H
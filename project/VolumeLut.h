@@ -0,0 +1,124 @@
+/**
+ * @file VolumeLut.h
+ * @brief Compile-time lookup tables for the adaptive volume policy.
+ *
+ * The adaptive target is a pure function of (speed bucket, cabin noise, mode,
+ * modifier bits). The tables below are built by the compiler, so evaluating
+ * a target is two loads, one multiply and the clamp. Define
+ * ADAPTIVE_VOLUME_USE_LUT to make AdaptiveVolumeControl use them.
+ *
+ * Results are bit-identical to the float path: the table folds in the only
+ * modifiers whose multipliers are not powers of two (horn duck, speed
+ * decrease), and the remaining power-of-two multipliers (navigation,
+ * reverse, sudden brake) scale exactly in any order.
+ */
+
+#ifndef VOLUME_LUT_H
+#define VOLUME_LUT_H
+
+#include "AdaptiveVolumeControl.h"
+#include <cstdint>
+
+/**
+ * @struct VolumeLutTables
+ * @brief Flat tables indexed by quantized inputs.
+ */
+struct VolumeLutTables {
+    static constexpr int NOISE_LEVELS = 128;   ///< Cabin noise values 0..127 are tabulated
+    static constexpr int SPEED_BUCKETS = 4;    ///< Stopped, low, medium, high speed
+    static constexpr int MODES = 3;            ///< Eco, Comfort, Sports
+    static constexpr int FOLDED_MODIFIERS = 4; ///< Horn duck x speed decrease
+    static constexpr int MODIFIER_MASKS = 32;  ///< All VolumeModifier bit combinations
+
+    /// Unclamped target with horn duck / speed decrease folded in: [folded][mode][bucket][noise]
+    float target[FOLDED_MODIFIERS][MODES][SPEED_BUCKETS][NOISE_LEVELS];
+    /// Product of the power-of-two multipliers (navigation, reverse, sudden brake) per modifier mask
+    float exactGain[MODIFIER_MASKS];
+};
+
+/**
+ * @brief Maps a speed to its bucket, using the thresholds of calculateTargetVolume().
+ * @param speed Vehicle speed.
+ * @return Bucket index 0..3.
+ */
+constexpr int volumeLutSpeedBucket(int speed) {
+    return speed > AdaptiveVolumeControl::HIGH_SPEED_THRESHOLD ? 3
+         : speed > AdaptiveVolumeControl::LOW_SPEED_THRESHOLD ? 2
+         : speed > 0 ? 1 : 0;
+}
+
+/**
+ * @brief Builds the tables with the same float operations, in the same order, as the runtime policy.
+ * @return Filled tables.
+ */
+constexpr VolumeLutTables buildVolumeLut() {
+    using AVC = AdaptiveVolumeControl;
+    VolumeLutTables lut{};
+    const int boost[VolumeLutTables::SPEED_BUCKETS] = {0, AVC::LOW_SPEED_BOOST, AVC::MEDIUM_SPEED_BOOST,
+                                                       AVC::HIGH_SPEED_BOOST};
+    const float modeMultiplier[VolumeLutTables::MODES] = {AVC::ECO_MULTIPLIER, 1.0f, AVC::SPORTS_MULTIPLIER};
+
+    for(int folded = 0; folded < VolumeLutTables::FOLDED_MODIFIERS; ++folded) {
+        for(int mode = 0; mode < VolumeLutTables::MODES; ++mode) {
+            for(int bucket = 0; bucket < VolumeLutTables::SPEED_BUCKETS; ++bucket) {
+                for(int noise = 0; noise < VolumeLutTables::NOISE_LEVELS; ++noise) {
+                    float volume = AVC::BASE_VOLUME;
+                    volume += boost[bucket];
+                    volume += noise * AVC::NOISE_SLOPE;
+                    volume *= modeMultiplier[mode];
+                    if(folded & 1) volume *= AVC::HORN_DUCK_MULTIPLIER;
+                    if(folded & 2) volume *= AVC::SPEED_DECREASE_MULTIPLIER;
+                    lut.target[folded][mode][bucket][noise] = volume;
+                }
+            }
+        }
+    }
+
+    for(int mask = 0; mask < VolumeLutTables::MODIFIER_MASKS; ++mask) {
+        float gain = 1.0f;
+        if(mask & MODIFIER_NAVIGATION) gain *= AVC::NAV_DUCK_MULTIPLIER;
+        if(mask & MODIFIER_REVERSE) gain *= AVC::REVERSE_MULTIPLIER;
+        if(mask & MODIFIER_SUDDEN_BRAKE) gain *= AVC::SUDDEN_BRAKE_MULTIPLIER;
+        lut.exactGain[mask] = gain;
+    }
+    return lut;
+}
+
+inline constexpr VolumeLutTables VOLUME_LUT = buildVolumeLut(); ///< Tables evaluated at compile time
+
+static_assert(Mode::ECO == Mode{0} && Mode::COMFORT == Mode{1} && Mode::SPORTS == Mode{2},
+              "mode is used as a table index");
+static_assert(AdaptiveVolumeControl::NAV_DUCK_MULTIPLIER == 0.5f &&
+              AdaptiveVolumeControl::REVERSE_MULTIPLIER == 0.25f &&
+              AdaptiveVolumeControl::SUDDEN_BRAKE_MULTIPLIER == 0.5f,
+              "exactGain is only bit-exact for power-of-two multipliers; fold others into target");
+
+/**
+ * @brief Checks whether a cabin noise value is tabulated.
+ * @param noise Cabin noise level.
+ * @return True if lookupTargetVolume() may be used.
+ */
+constexpr bool volumeLutCovers(int noise) {
+    return noise >= 0 && noise < VolumeLutTables::NOISE_LEVELS;
+}
+
+/**
+ * @brief Looks up the clamped adaptive target volume.
+ * @param speed Vehicle speed.
+ * @param noise Cabin noise level (must satisfy volumeLutCovers()).
+ * @param mode Driving mode (out-of-range values use Comfort, as the float path does).
+ * @param modifiers VolumeModifier bits.
+ * @return Target volume, identical to the float path.
+ */
+inline float lookupTargetVolume(int speed, int noise, Mode mode, std::uint8_t modifiers) {
+    int folded = (modifiers & MODIFIER_HORN_DUCK ? 1 : 0) | (modifiers & MODIFIER_SPEED_DECREASE ? 2 : 0);
+    unsigned modeIndex = static_cast<unsigned>(mode);
+    if(modeIndex >= static_cast<unsigned>(VolumeLutTables::MODES)) modeIndex = static_cast<unsigned>(Mode::COMFORT);
+    float volume = VOLUME_LUT.target[folded][modeIndex][volumeLutSpeedBucket(speed)][noise] *
+                   VOLUME_LUT.exactGain[modifiers & (VolumeLutTables::MODIFIER_MASKS - 1)];
+    if(volume < AdaptiveVolumeControl::MIN_VOLUME) volume = AdaptiveVolumeControl::MIN_VOLUME;
+    if(volume > AdaptiveVolumeControl::MAX_ADAPTIVE_VOLUME) volume = AdaptiveVolumeControl::MAX_ADAPTIVE_VOLUME;
+    return volume;
+}
+
+#endif // VOLUME_LUT_H
@@ -0,0 +1,99 @@
+/**
+ * @file VolumeProfile.cpp
+ * @brief Implements compilation, validation and writing of volume policy profiles.
+ */
+
+#include "VolumeProfile.h"
+#include "Checksum.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+constexpr char VOLUME_PROFILE_MAGIC[4] = {'A', 'V', 'P', 'F'}; ///< Profile file signature
+}
+
+/**
+ * @brief Evaluates a piecewise-linear curve, holding the end values outside its range.
+ * @param curve Breakpoints with increasing x.
+ * @param x Input.
+ * @return Interpolated value (0 for an empty curve).
+ */
+float evaluateCurve(const std::vector<CurvePoint>& curve, float x) {
+    if(curve.empty()) return 0.0f;
+    if(x <= curve.front().x) return curve.front().y;
+    if(x >= curve.back().x) return curve.back().y;
+
+    std::size_t i = 1;
+    while(curve[i].x <= x) ++i;
+    const CurvePoint& a = curve[i - 1];
+    const CurvePoint& b = curve[i];
+    float slope = (b.y - a.y) / (b.x - a.x);
+    return a.y + slope * (x - a.x);
+}
+
+/**
+ * @brief Samples the curves of a spec into flat tables.
+ * @param spec Authoring form.
+ * @return Compiled profile.
+ */
+VolumeProfileData compileVolumeProfile(const VolumeProfileSpec& spec) {
+    VolumeProfileData data{};
+    for(int speed = 0; speed < VolumeProfileData::SPEED_TABLE_SIZE; ++speed)
+        data.speedVolume[speed] = spec.baseVolume + evaluateCurve(spec.speedCurve, static_cast<float>(speed));
+    for(int noise = 0; noise < VolumeProfileData::NOISE_TABLE_SIZE; ++noise)
+        data.noiseVolume[noise] = evaluateCurve(spec.noiseCurve, static_cast<float>(noise));
+
+    std::memcpy(data.modeMultiplier, spec.modeMultiplier, sizeof(data.modeMultiplier));
+    std::memcpy(data.modifierMultiplier, spec.modifierMultiplier, sizeof(data.modifierMultiplier));
+    // Clamps stay inside the controller's volume range (the smoothing bounds assume it)
+    data.maxVolume = std::clamp(spec.maxVolume, AdaptiveVolumeControl::MIN_VOLUME, AdaptiveVolumeControl::MAX_VOLUME);
+    data.minVolume = std::clamp(spec.minVolume, AdaptiveVolumeControl::MIN_VOLUME, data.maxVolume);
+    data.hornDuckDuration = spec.hornDuckDuration;
+    data.suddenBrakeThreshold = spec.suddenBrakeThreshold;
+    return data;
+}
+
+/**
+ * @brief Validates a mapped or loaded profile image.
+ * @param bytes Start of the image (header first).
+ * @param size Image size in bytes.
+ * @return Payload inside the image, or nullptr if the magic, version, size or CRC do not match
+ *         or the clamps leave [MIN_VOLUME, MAX_VOLUME].
+ */
+const VolumeProfileData* validateVolumeProfile(const unsigned char* bytes, std::size_t size) {
+    if(!bytes || size != sizeof(VolumeProfileHeader) + sizeof(VolumeProfileData)) return nullptr;
+
+    VolumeProfileHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    const unsigned char* payload = bytes + sizeof(header);
+    if(std::memcmp(header.magic, VOLUME_PROFILE_MAGIC, sizeof(header.magic)) != 0 ||
+       header.version != VOLUME_PROFILE_VERSION || header.payloadSize != sizeof(VolumeProfileData) ||
+       header.crc != crc32(payload, sizeof(VolumeProfileData)))
+        return nullptr;
+    const VolumeProfileData* data = reinterpret_cast<const VolumeProfileData*>(payload);
+    if(!(data->minVolume >= AdaptiveVolumeControl::MIN_VOLUME && data->minVolume <= data->maxVolume &&
+         data->maxVolume <= AdaptiveVolumeControl::MAX_VOLUME))
+        return nullptr;
+    return data;
+}
+
+/**
+ * @brief Writes a compiled profile with its header and CRC.
+ * @param path File to create (or truncate).
+ * @param data Compiled profile.
+ * @return True on success.
+ */
+bool writeVolumeProfile(const std::string& path, const VolumeProfileData& data) {
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if(!out) return false;
+
+    VolumeProfileHeader header{};
+    std::memcpy(header.magic, VOLUME_PROFILE_MAGIC, sizeof(header.magic));
+    header.version = VOLUME_PROFILE_VERSION;
+    header.payloadSize = sizeof(VolumeProfileData);
+    header.crc = crc32(&data, sizeof(data));
+
+    bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1 && std::fwrite(&data, sizeof(data), 1, out) == 1;
+    return std::fclose(out) == 0 && ok;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file VolumeProfile.h
+ * @brief Defines the binary volume policy profile: curve source, compiled tables and file format.
+ *
+ * A profile is authored as piecewise-linear speed and noise curves plus the
+ * mode/modifier multipliers (VolumeProfileSpec), compiled offline into flat
+ * per-km/h and per-dB tables (VolumeProfileData), and stored behind a small
+ * header with a CRC. The on-disk payload is exactly VolumeProfileData, so a
+ * mapped file is used in place without parsing.
+ */
+
+#ifndef VOLUME_PROFILE_H
+#define VOLUME_PROFILE_H
+
+#include "AdaptiveVolumeControl.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @struct VolumeProfileHeader
+ * @brief Fixed header at the start of every profile file.
+ */
+struct VolumeProfileHeader {
+    char magic[4];              ///< "AVPF"
+    std::uint32_t version;      ///< Format version (VOLUME_PROFILE_VERSION)
+    std::uint32_t payloadSize;  ///< sizeof(VolumeProfileData)
+    std::uint32_t crc;          ///< crc32() of the payload
+};
+
+/**
+ * @struct VolumeProfileData
+ * @brief Compiled policy tables, identical in memory and on disk.
+ *
+ * Speeds and noise levels outside the tables use the nearest end entry.
+ */
+struct VolumeProfileData {
+    static constexpr int SPEED_TABLE_SIZE = 256;   ///< Speeds 0..255 km/h are tabulated
+    static constexpr int NOISE_TABLE_SIZE = 256;   ///< Noise levels 0..255 are tabulated
+    static constexpr int MODES = 3;                ///< Eco, Comfort, Sports
+    static constexpr int MODIFIERS = 5;            ///< VolumeModifier bits
+
+    float speedVolume[SPEED_TABLE_SIZE];   ///< Base volume plus speed term, per km/h
+    float noiseVolume[NOISE_TABLE_SIZE];   ///< Noise term, per noise level
+    float modeMultiplier[MODES];           ///< Multiplier per Mode
+    float modifierMultiplier[MODIFIERS];   ///< Multiplier per VolumeModifier bit (bit 0 first)
+    float minVolume;                       ///< Lower clamp of the adaptive target
+    float maxVolume;                       ///< Upper clamp of the adaptive target
+    float hornDuckDuration;                ///< Horn duck hold in seconds
+    std::int32_t suddenBrakeThreshold;     ///< Speed drop between updates treated as sudden brake
+
+    /**
+     * @brief Evaluates the volume before event modifiers.
+     * @param speed Vehicle speed.
+     * @param noise Cabin noise level.
+     * @param mode Driving mode (out-of-range values use Comfort, as the built-in policy does).
+     * @return Base volume.
+     */
+    float baseVolume(int speed, int noise, Mode mode) const {
+        float volume = speedVolume[clampIndex(speed, SPEED_TABLE_SIZE)];
+        volume += noiseVolume[clampIndex(noise, NOISE_TABLE_SIZE)];
+        unsigned modeIndex = static_cast<unsigned>(mode);
+        if(modeIndex >= static_cast<unsigned>(MODES)) modeIndex = static_cast<unsigned>(Mode::COMFORT);
+        return volume * modeMultiplier[modeIndex];
+    }
+
+    /**
+     * @brief Evaluates the clamped adaptive target volume.
+     * @param speed Vehicle speed.
+     * @param noise Cabin noise level.
+     * @param mode Driving mode.
+     * @param modifiers VolumeModifier bits.
+     * @return Target volume.
+     */
+    float targetVolume(int speed, int noise, Mode mode, std::uint8_t modifiers) const {
+        float volume = baseVolume(speed, noise, mode);
+        for(int bit = 0; bit < MODIFIERS; ++bit)
+            if(modifiers & (1u << bit)) volume *= modifierMultiplier[bit];
+        if(volume < minVolume) volume = minVolume;
+        if(volume > maxVolume) volume = maxVolume;
+        return volume;
+    }
+
+private:
+    static int clampIndex(int value, int size) { return value < 0 ? 0 : value >= size ? size - 1 : value; }
+};
+
+static_assert(sizeof(VolumeProfileHeader) == 16, "profile header layout is fixed");
+static_assert(std::is_trivially_copyable<VolumeProfileData>::value && std::is_standard_layout<VolumeProfileData>::value,
+              "profile payload is used in place from the mapping");
+
+constexpr std::uint32_t VOLUME_PROFILE_VERSION = 1; ///< Current profile format version
+
+/**
+ * @struct CurvePoint
+ * @brief Breakpoint of a piecewise-linear curve.
+ */
+struct CurvePoint {
+    float x; ///< Input (km/h or noise level), strictly increasing along a curve
+    float y; ///< Volume contribution at x
+};
+
+/**
+ * @struct VolumeProfileSpec
+ * @brief Authoring form of a profile; the defaults reproduce the built-in policy.
+ */
+struct VolumeProfileSpec {
+    using AVC = AdaptiveVolumeControl;
+
+    float baseVolume = AVC::BASE_VOLUME;    ///< Volume before curves and multipliers
+    /// Speed boost curve (integer-aligned steps reproduce the 30/70 km/h thresholds)
+    std::vector<CurvePoint> speedCurve = {{0, 0}, {1, AVC::LOW_SPEED_BOOST},
+                                          {AVC::LOW_SPEED_THRESHOLD, AVC::LOW_SPEED_BOOST},
+                                          {AVC::LOW_SPEED_THRESHOLD + 1, AVC::MEDIUM_SPEED_BOOST},
+                                          {AVC::HIGH_SPEED_THRESHOLD, AVC::MEDIUM_SPEED_BOOST},
+                                          {AVC::HIGH_SPEED_THRESHOLD + 1, AVC::HIGH_SPEED_BOOST}};
+    /// Noise curve (a line of slope NOISE_SLOPE)
+    std::vector<CurvePoint> noiseCurve = {{0, 0}, {VolumeProfileData::NOISE_TABLE_SIZE - 1,
+                                                   (VolumeProfileData::NOISE_TABLE_SIZE - 1) * AVC::NOISE_SLOPE}};
+    float modeMultiplier[VolumeProfileData::MODES] = {AVC::ECO_MULTIPLIER, 1.0f, AVC::SPORTS_MULTIPLIER}; ///< Per Mode
+    /// Per VolumeModifier bit: horn duck, navigation, reverse, sudden brake, speed decrease
+    float modifierMultiplier[VolumeProfileData::MODIFIERS] = {AVC::HORN_DUCK_MULTIPLIER, AVC::NAV_DUCK_MULTIPLIER,
+                                                              AVC::REVERSE_MULTIPLIER, AVC::SUDDEN_BRAKE_MULTIPLIER,
+                                                              AVC::SPEED_DECREASE_MULTIPLIER};
+    float minVolume = AVC::MIN_VOLUME;                                  ///< Lower clamp
+    float maxVolume = AVC::MAX_ADAPTIVE_VOLUME;                         ///< Upper clamp
+    float hornDuckDuration = static_cast<float>(AVC::HORN_DUCK_DURATION); ///< Horn duck hold in seconds
+    int suddenBrakeThreshold = AVC::SUDDEN_BRAKE_THRESHOLD;             ///< Sudden brake speed drop
+};
+
+/**
+ * @brief Evaluates a piecewise-linear curve, holding the end values outside its range.
+ * @param curve Breakpoints with increasing x.
+ * @param x Input.
+ * @return Interpolated value (0 for an empty curve).
+ */
+float evaluateCurve(const std::vector<CurvePoint>& curve, float x);
+
+/**
+ * @brief Samples the curves of a spec into flat tables.
+ * @param spec Authoring form (clamps are limited to [MIN_VOLUME, MAX_VOLUME]).
+ * @return Compiled profile.
+ */
+VolumeProfileData compileVolumeProfile(const VolumeProfileSpec& spec);
+
+/**
+ * @brief Validates a mapped or loaded profile image.
+ * @param bytes Start of the image (header first).
+ * @param size Image size in bytes.
+ * @return Payload inside the image, or nullptr if the magic, version, size or CRC do not match
+ *         or the clamps leave [MIN_VOLUME, MAX_VOLUME].
+ */
+const VolumeProfileData* validateVolumeProfile(const unsigned char* bytes, std::size_t size);
+
+/**
+ * @brief Writes a compiled profile with its header and CRC.
+ * @param path File to create (or truncate).
+ * @param data Compiled profile.
+ * @return True on success.
+ */
+bool writeVolumeProfile(const std::string& path, const VolumeProfileData& data);
+
+#endif // VOLUME_PROFILE_H
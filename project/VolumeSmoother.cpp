@@ -0,0 +1,156 @@
+/**
+ * @file VolumeSmoother.cpp
+ * @brief Implements the VolumeSmoother class.
+ */
+
+#include "VolumeSmoother.h"
+#include "AdaptiveVolumeControl.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+/**
+ * @brief Converts a transition time to ticks.
+ * @param ms Transition time in milliseconds.
+ * @param tickInterval Seconds per tick.
+ * @return At least one tick.
+ */
+int ticksFor(float ms, double tickInterval) {
+    double ticks = std::ceil(ms / 1000.0 / tickInterval - 1e-9);
+    return ticks < 1.0 ? 1 : static_cast<int>(ticks);
+}
+
+/**
+ * @brief Tabulates smoothstep progress for a transition.
+ * @param curve Receives the progress after each tick; the last entry is exactly 1.
+ * @param ticks Ticks of the transition.
+ */
+void buildSCurve(std::vector<float>& curve, int ticks) {
+    curve.resize(ticks);
+    for(int k = 1; k <= ticks; ++k) {
+        double x = static_cast<double>(k) / ticks;
+        curve[k - 1] = static_cast<float>(x * x * (3.0 - 2.0 * x));
+    }
+    curve[ticks - 1] = 1.0f;
+}
+}
+
+/**
+ * @brief Constructor precomputes the coefficients.
+ * @param config Curve and time constants.
+ * @param tickInterval Seconds per step().
+ */
+VolumeSmoother::VolumeSmoother(const SmootherConfig& config, double tickInterval) {
+    configure(config, tickInterval);
+}
+
+/**
+ * @brief Changes the curve or the tick interval; the next step() starts a new transition.
+ * @param newConfig Curve and time constants.
+ * @param newTickInterval Seconds per step().
+ */
+void VolumeSmoother::configure(const SmootherConfig& newConfig, double newTickInterval) {
+    using AVC = AdaptiveVolumeControl;
+    config = newConfig;
+    tickInterval = newTickInterval;
+    attackTicks = ticksFor(config.attackMs, tickInterval);
+    releaseTicks = ticksFor(config.releaseMs, tickInterval);
+
+    // Same expression as AdaptiveVolumeControl::tick(), so LEGACY_LINEAR is bit-identical to it
+    legacyFactor = 1.0f - static_cast<float>(std::pow(1.0 - AVC::SMOOTH_FACTOR, tickInterval / AVC::SMOOTH_INTERVAL));
+    attackStep = AVC::MAX_VOLUME / attackTicks;
+    releaseStep = AVC::MAX_VOLUME / releaseTicks;
+    if(config.mode == SmoothingMode::S_CURVE) {
+        buildSCurve(attackCurve, attackTicks);
+        buildSCurve(releaseCurve, releaseTicks);
+    }
+
+    segmentStart = 0.0f;
+    segmentTarget = std::numeric_limits<float>::quiet_NaN(); // never equal, forces a retarget
+    segmentRatio = 1.0f;
+    segmentValue = 0.0f;
+    segmentTick = 0;
+    segmentTicks = 0;
+}
+
+/**
+ * @brief Starts a transition.
+ * @param current Start volume.
+ * @param target Target volume.
+ */
+void VolumeSmoother::retarget(float current, float target) {
+    segmentStart = current;
+    segmentTarget = target;
+    segmentTick = 0;
+    bool rising = target > current;
+    int ticks = rising ? attackTicks : releaseTicks;
+
+    switch(config.mode) {
+        case SmoothingMode::LEGACY_LINEAR:
+            ticks = 0;
+            break;
+        case SmoothingMode::DECIBEL_EXPONENTIAL: {
+            float from = std::max(current, DB_FLOOR), to = std::max(target, DB_FLOOR);
+            segmentValue = from;
+            segmentRatio = static_cast<float>(std::pow(static_cast<double>(to) / from, 1.0 / ticks));
+            break;
+        }
+        case SmoothingMode::S_CURVE:
+            break;
+        case SmoothingMode::RATE_LIMITED: {
+            float needed = std::ceil(std::abs(target - current) / (rising ? attackStep : releaseStep));
+            ticks = std::min(ticks, std::max(1, static_cast<int>(needed)));
+            break;
+        }
+    }
+    segmentTicks = current == target ? 0 : ticks;
+}
+
+/**
+ * @brief Advances one tick.
+ * @param current Current volume (the transition restarts from it when the target changed).
+ * @param target Target volume.
+ * @return New current volume.
+ */
+float VolumeSmoother::step(float current, float target) {
+    if(config.mode == SmoothingMode::LEGACY_LINEAR) {
+        if(std::abs(current - target) <= AdaptiveVolumeControl::SETTLE_THRESHOLD) return target;
+        float diff = target - current;
+        current += diff * legacyFactor;
+        return std::abs(current - target) <= AdaptiveVolumeControl::SETTLE_THRESHOLD ? target : current;
+    }
+
+    if(target != segmentTarget) retarget(current, target);
+    if(segmentTick >= segmentTicks) return target;
+    if(++segmentTick == segmentTicks) return target;
+
+    switch(config.mode) {
+        case SmoothingMode::DECIBEL_EXPONENTIAL:
+            segmentValue *= segmentRatio;
+            return segmentValue;
+        case SmoothingMode::S_CURVE: {
+            const std::vector<float>& curve = target > segmentStart ? attackCurve : releaseCurve;
+            return segmentStart + (target - segmentStart) * curve[segmentTick - 1];
+        }
+        case SmoothingMode::RATE_LIMITED:
+            return target > segmentStart ? segmentStart + attackStep * segmentTick
+                                         : segmentStart - releaseStep * segmentTick;
+        default:
+            return target;
+    }
+}
+
+/**
+ * @brief Gets the worst-case ticks for one target change.
+ * @return Upper bound of step() calls from any volume to any target.
+ */
+int VolumeSmoother::maxTicks() const {
+    using AVC = AdaptiveVolumeControl;
+    if(config.mode == SmoothingMode::LEGACY_LINEAR) {
+        // Distance shrinks by (1 - factor) per tick from at most MAX_VOLUME down to SETTLE_THRESHOLD
+        double ticks = std::log(AVC::SETTLE_THRESHOLD / AVC::MAX_VOLUME) / std::log(1.0 - legacyFactor);
+        return static_cast<int>(std::ceil(ticks)) + 1;
+    }
+    return std::max(attackTicks, releaseTicks);
+}
@@ -0,0 +1,110 @@
+/**
+ * @file VolumeSmoother.h
+ * @brief Defines the VolumeSmoother class with selectable volume transition curves and bounded settle time.
+ */
+
+#ifndef VOLUME_SMOOTHER_H
+#define VOLUME_SMOOTHER_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @enum SmoothingMode
+ * @brief Shape of the transition from the current to the target volume.
+ */
+enum class SmoothingMode : std::uint8_t {
+    LEGACY_LINEAR,       ///< Fixed fraction of the remaining distance per tick, snap within SETTLE_THRESHOLD (tick() default)
+    DECIBEL_EXPONENTIAL, ///< Constant dB change per tick (exponential in volume units), i.e. perceptually even
+    S_CURVE,             ///< Smoothstep ease-in/ease-out over the transition time
+    RATE_LIMITED         ///< Constant volume change per tick, a full-scale swing takes the transition time
+};
+
+/**
+ * @struct SmootherConfig
+ * @brief Curve and time constants of a VolumeSmoother.
+ */
+struct SmootherConfig {
+    SmoothingMode mode = SmoothingMode::DECIBEL_EXPONENTIAL; ///< Transition curve
+    float attackMs = 300.0f;        ///< Transition time for rising volume (ms)
+    float releaseMs = 600.0f;       ///< Transition time for falling volume (ms)
+};
+
+/**
+ * @class VolumeSmoother
+ * @brief Moves a volume towards its target along a precomputed curve.
+ *
+ * All curve coefficients are computed by configure(); a step() is a table
+ * lookup or a multiply-add (DECIBEL_EXPONENTIAL takes one pow() when the
+ * target changes). Except in LEGACY_LINEAR mode every transition lands
+ * exactly on the target after at most ceil(time / tick interval) ticks, so
+ * maxTicks() bounds the settle time of any single target change.
+ */
+class VolumeSmoother {
+public:
+    static constexpr float DB_FLOOR = 0.1f;      ///< Volume treated as -60 dB full scale by the dB curve
+
+    /**
+     * @brief Constructor precomputes the coefficients.
+     * @param config Curve and time constants.
+     * @param tickInterval Seconds per step().
+     */
+    explicit VolumeSmoother(const SmootherConfig& config = SmootherConfig(), double tickInterval = 0.01);
+
+    /**
+     * @brief Changes the curve or the tick interval; the next step() starts a new transition.
+     * @param config Curve and time constants.
+     * @param tickInterval Seconds per step().
+     */
+    void configure(const SmootherConfig& config, double tickInterval);
+
+    /**
+     * @brief Advances one tick.
+     * @param current Current volume (the transition restarts from it when the target changed).
+     * @param target Target volume.
+     * @return New current volume.
+     */
+    float step(float current, float target);
+
+    /**
+     * @brief Gets the worst-case ticks for one target change.
+     * @return Upper bound of step() calls from any volume to any target.
+     */
+    int maxTicks() const;
+
+    /**
+     * @brief Gets the ticks left in the current transition.
+     * @return Remaining step() calls until the last target is reached (0 = reached).
+     */
+    int remainingTicks() const { return segmentTicks - segmentTick; }
+
+    const SmootherConfig& getConfig() const { return config; }   ///< @return Curve and time constants
+    double getTickInterval() const { return tickInterval; }      ///< @return Seconds per step()
+
+private:
+    SmootherConfig config;          ///< Curve and time constants
+    double tickInterval;            ///< Seconds per step()
+    int attackTicks;                ///< Ticks of a rising transition
+    int releaseTicks;               ///< Ticks of a falling transition
+    float legacyFactor;             ///< LEGACY_LINEAR fraction per tick
+    float attackStep;               ///< RATE_LIMITED rise per tick
+    float releaseStep;              ///< RATE_LIMITED fall per tick
+    std::vector<float> attackCurve; ///< S_CURVE progress after tick k+1 of a rising transition
+    std::vector<float> releaseCurve;///< S_CURVE progress after tick k+1 of a falling transition
+
+    float segmentStart;             ///< Volume the current transition started from
+    float segmentTarget;            ///< Target of the current transition
+    float segmentRatio;             ///< DECIBEL_EXPONENTIAL volume ratio per tick
+    float segmentValue;             ///< DECIBEL_EXPONENTIAL floored volume after the last tick
+    int segmentTick;                ///< Ticks taken in the current transition
+    int segmentTicks;               ///< Ticks of the current transition
+
+    /**
+     * @brief Starts a transition.
+     * @param current Start volume.
+     * @param target Target volume.
+     */
+    void retarget(float current, float target);
+};
+
+#endif // VOLUME_SMOOTHER_H
@@ -0,0 +1,85 @@
+/**
+ * @file VolumeState.h
+ * @brief Defines VolumeStateSnapshot, the fixed-layout controller state persisted across ECU sleep.
+ */
+
+#ifndef VOLUME_STATE_H
+#define VOLUME_STATE_H
+
+#include "Checksum.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+constexpr std::uint32_t VOLUME_STATE_MAGIC = 0x53435641u; ///< "AVCS" read as a little-endian word
+constexpr std::uint16_t VOLUME_STATE_VERSION = 1;         ///< Current snapshot layout version
+
+/**
+ * @struct VolumeStateSnapshot
+ * @brief Controller state as a trivially copyable blob (AdaptiveVolumeControl::saveState()).
+ *
+ * Time points are not portable across a sleep (the clock may restart), so
+ * the horn duck timer is stored as the time elapsed since the horn was last
+ * active. The CRC covers every byte before it; fill with sealVolumeState()
+ * and check with validateVolumeState().
+ */
+struct VolumeStateSnapshot {
+    std::uint32_t magic;            ///< VOLUME_STATE_MAGIC
+    std::uint16_t version;          ///< VOLUME_STATE_VERSION
+    std::uint16_t size;             ///< sizeof(VolumeStateSnapshot)
+    float currentVolume;            ///< Smoothed volume
+    float targetVolume;             ///< Target volume
+    std::int32_t speed;             ///< Current speed
+    std::int32_t previousSpeed;     ///< Speed of the previous frame
+    std::int32_t cabinNoise;        ///< Cabin noise level
+    std::int32_t manualVolume;      ///< Manual volume value
+    std::int64_t hornDuckElapsedNs; ///< Time since the horn was last active (valid while hornDuckActive)
+    std::uint8_t mode;              ///< Mode
+    std::uint8_t controlType;       ///< VolumeControlType
+    std::uint8_t flags;             ///< VolumeStateFlag bits
+    std::uint8_t activeModifiers;   ///< VolumeModifier bits applied to the target
+    std::uint32_t crc;              ///< crc32() of the preceding bytes
+};
+
+/**
+ * @enum VolumeStateFlag
+ * @brief Boolean inputs packed into VolumeStateSnapshot::flags.
+ */
+enum VolumeStateFlag : std::uint8_t {
+    STATE_REVERSE_GEAR     = 1u << 0, ///< Reverse gear engaged
+    STATE_HORN_ACTIVE      = 1u << 1, ///< Horn pressed
+    STATE_NAV_SPEAKING     = 1u << 2, ///< Navigation prompt speaking
+    STATE_HORN_DUCK_ACTIVE = 1u << 3  ///< Horn duck engaged or holding
+};
+
+static_assert(sizeof(VolumeStateSnapshot) == 48, "snapshot layout is fixed");
+static_assert(std::is_trivially_copyable<VolumeStateSnapshot>::value && std::is_standard_layout<VolumeStateSnapshot>::value,
+              "snapshot is persisted with memcpy");
+
+/**
+ * @brief Fills the header and CRC of a snapshot.
+ * @param state Snapshot with the state fields set.
+ */
+inline void sealVolumeState(VolumeStateSnapshot& state) {
+    state.magic = VOLUME_STATE_MAGIC;
+    state.version = VOLUME_STATE_VERSION;
+    state.size = sizeof(VolumeStateSnapshot);
+    state.crc = crc32(&state, offsetof(VolumeStateSnapshot, crc));
+}
+
+/**
+ * @brief Checks a persisted snapshot image.
+ * @param bytes Start of the image.
+ * @param size Image size in bytes.
+ * @param state Receives the snapshot.
+ * @return False if the size, magic, version or CRC do not match.
+ */
+inline bool validateVolumeState(const void* bytes, std::size_t size, VolumeStateSnapshot& state) {
+    if(!bytes || size != sizeof(VolumeStateSnapshot)) return false;
+    std::memcpy(&state, bytes, sizeof(state));
+    return state.magic == VOLUME_STATE_MAGIC && state.version == VOLUME_STATE_VERSION &&
+           state.size == sizeof(VolumeStateSnapshot) && state.crc == crc32(&state, offsetof(VolumeStateSnapshot, crc));
+}
+
+#endif // VOLUME_STATE_H
@@ -0,0 +1,180 @@
+/**
+ * @file WorkStealingPool.h
+ * @brief Defines the WorkStealingPool class running index ranges across persistent worker threads.
+ */
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkStealingPool
+ * @brief Fixed set of workers splitting parallelFor() ranges by work stealing.
+ *
+ * Each worker owns a contiguous index range packed into one atomic word
+ * (begin << 32 | end). The owner takes grain-sized chunks from the front;
+ * an idle worker steals the back half of a victim's range. Both sides
+ * move the range with a compare-exchange on the same word, so there are
+ * no locks on the scheduling path and uneven work rebalances itself.
+ * The initial split gives worker w the w-th contiguous slice of
+ * [0, count), and thieves try their neighbours first, so data laid out
+ * per worker (NUMA shards) is mostly processed where it lives.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @brief Constructor starts the workers.
+     * @param threads Number of workers (0 = hardware concurrency).
+     * @param onStart Called once on each worker thread with its index before it takes jobs
+     *                (CPU pinning, first-touch allocation); may be empty.
+     */
+    explicit WorkStealingPool(unsigned threads = 0, std::function<void(unsigned)> onStart = nullptr) {
+        if(threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        slots.reset(new Slot[threads]);
+        for(unsigned id = 0; id < threads; ++id) {
+            workers.emplace_back([this, id, onStart] {
+                if(onStart) onStart(id);
+                workerLoop(id);
+            });
+        }
+    }
+
+    /**
+     * @brief Destructor stops and joins the workers.
+     */
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for(std::thread& worker : workers) worker.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()); } ///< @return Number of workers
+
+    /**
+     * @brief Runs body(worker, index) for every index in [0, count) and waits for completion.
+     * @param count Number of indices.
+     * @param grain Indices an owner takes per chunk.
+     * @param body Callable taking (unsigned worker, std::uint32_t index); must not call parallelFor().
+     */
+    void parallelFor(std::uint32_t count, std::uint32_t grain, std::function<void(unsigned, std::uint32_t)> body) {
+        if(count == 0) return;
+        unsigned n = size();
+        for(unsigned id = 0; id < n; ++id) {
+            std::uint32_t begin = static_cast<std::uint32_t>(std::uint64_t(count) * id / n);
+            std::uint32_t end = static_cast<std::uint32_t>(std::uint64_t(count) * (id + 1) / n);
+            slots[id].range.store(pack(begin, end), std::memory_order_relaxed);
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        job = std::move(body);
+        jobGrain = std::max<std::uint32_t>(1, grain);
+        running = n;
+        ++generation;
+        wake.notify_all();
+        done.wait(lock, [this] { return running == 0; });
+        job = nullptr;
+    }
+
+private:
+    /**
+     * @struct Slot
+     * @brief Range owned by one worker, on its own cache line.
+     */
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> range{0}; ///< begin << 32 | end
+    };
+
+    std::vector<std::thread> workers;                               ///< Worker threads
+    std::unique_ptr<Slot[]> slots;                                  ///< Per-worker ranges
+    std::mutex mutex;                                               ///< Guards the job hand-off
+    std::condition_variable wake;                                   ///< Signals a new job or shutdown
+    std::condition_variable done;                                   ///< Signals job completion
+    std::function<void(unsigned, std::uint32_t)> job;               ///< Current job body
+    std::uint32_t jobGrain = 1;                                     ///< Current chunk size
+    std::uint64_t generation = 0;                                   ///< Job counter
+    unsigned running = 0;                                           ///< Workers still draining
+    bool stopping = false;                                          ///< Set by the destructor
+
+    static std::uint64_t pack(std::uint32_t begin, std::uint32_t end) { return std::uint64_t(begin) << 32 | end; }
+    static std::uint32_t rangeBegin(std::uint64_t range) { return static_cast<std::uint32_t>(range >> 32); }
+    static std::uint32_t rangeEnd(std::uint64_t range) { return static_cast<std::uint32_t>(range); }
+
+    /**
+     * @brief Waits for jobs and drains them until shutdown.
+     * @param id Worker index.
+     */
+    void workerLoop(unsigned id) {
+        std::uint64_t seen = 0;
+        for(;;) {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if(stopping) return;
+            seen = generation;
+            lock.unlock();
+
+            drain(id);
+
+            lock.lock();
+            if(--running == 0) done.notify_one();
+        }
+    }
+
+    /**
+     * @brief Processes the own range, then steals until no worker has indices left.
+     * @param id Worker index.
+     */
+    void drain(unsigned id) {
+        Slot& own = slots[id];
+        unsigned n = size();
+        for(;;) {
+            std::uint64_t range = own.range.load(std::memory_order_acquire);
+            std::uint32_t begin = rangeBegin(range), end = rangeEnd(range);
+            if(begin < end) {
+                std::uint32_t stop = end - begin > jobGrain ? begin + jobGrain : end;
+                if(!own.range.compare_exchange_weak(range, pack(stop, end), std::memory_order_acq_rel)) continue;
+                for(std::uint32_t i = begin; i < stop; ++i) job(id, i);
+                continue;
+            }
+            if(!steal(id, n)) return;
+        }
+    }
+
+    /**
+     * @brief Moves the back half of another worker's range into the own slot.
+     * @param id Thief index.
+     * @param n Number of workers.
+     * @return False if every range was empty.
+     */
+    bool steal(unsigned id, unsigned n) {
+        for(unsigned k = 1; k < n; ++k) {
+            Slot& victim = slots[(id + k) % n];
+            std::uint64_t range = victim.range.load(std::memory_order_acquire);
+            while(rangeBegin(range) < rangeEnd(range)) {
+                std::uint32_t begin = rangeBegin(range), end = rangeEnd(range);
+                std::uint32_t mid = begin + (end - begin) / 2;
+                if(victim.range.compare_exchange_weak(range, pack(begin, mid), std::memory_order_acq_rel)) {
+                    slots[id].range.store(pack(mid, end), std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+#endif // WORK_STEALING_POOL_H
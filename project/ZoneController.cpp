@@ -0,0 +1,118 @@
+/**
+ * @file ZoneController.cpp
+ * @brief Implements the ZoneController class managing several audio zones in one pass.
+ */
+
+#include "ZoneController.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std::chrono;
+
+namespace {
+using AVC = AdaptiveVolumeControl;
+}
+
+/**
+ * @brief Constructor initializes all zones to the AdaptiveVolumeControl defaults.
+ * @param zoneCount Number of zones (capped at MAX_ZONES).
+ * @param clock Time source for horn ducking.
+ */
+ZoneController::ZoneController(std::size_t zoneCount, Clock& clock)
+    : zones(std::min(zoneCount, MAX_ZONES)), clock(&clock),
+      speed(0), previousSpeed(0), hornActive(false), hornDuckActive(false),
+      hornDuckStartTime(clock.now()),
+      tickDt(AVC::SMOOTH_INTERVAL), tickFactor(AVC::SMOOTH_FACTOR) {
+    std::fill(std::begin(targetVolume), std::end(targetVolume), AVC::DEFAULT_VOLUME);
+    std::fill(std::begin(currentVolume), std::end(currentVolume), AVC::DEFAULT_VOLUME);
+    std::fill(std::begin(cabinNoise), std::end(cabinNoise), 30);
+    std::fill(std::begin(manualVolume), std::end(manualVolume), 25);
+    std::fill(std::begin(manual), std::end(manual), false);
+    std::fill(std::begin(navSpeaking), std::end(navSpeaking), false);
+}
+
+/**
+ * @brief Sets the volume control type of a zone.
+ * @param zone Zone index.
+ * @param type Volume control type.
+ * @param volume Manual volume (kept only in manual mode).
+ */
+void ZoneController::setZoneControl(std::size_t zone, VolumeControlType type, int volume) {
+    manual[zone] = type == VolumeControlType::MANUAL;
+    if(manual[zone]) manualVolume[zone] = volume;
+}
+
+/**
+ * @brief Applies vehicle-wide inputs and recalculates every zone's target volume.
+ * @param newSpeed Current vehicle speed.
+ * @param newReverseGear Reverse gear status.
+ * @param newHornActive Horn active status.
+ * @param newMode Current driving mode.
+ */
+void ZoneController::update(int newSpeed, bool newReverseGear, bool newHornActive, Mode newMode) {
+    previousSpeed = speed;
+    speed = newSpeed;
+    hornActive = newHornActive;
+
+    // --- Horn Ducking Logic (same timer as AdaptiveVolumeControl::handleHornDucking) ---
+    auto now = clock->now();
+    if(hornActive) {
+        hornDuckActive = true;
+        hornDuckStartTime = now;
+    } else if(hornDuckActive) {
+        duration<double> elapsed = now - hornDuckStartTime;
+        if(elapsed.count() >= AVC::HORN_DUCK_DURATION) hornDuckActive = false;
+    }
+
+    // --- Vehicle-wide terms, evaluated once ---
+    int boost = speed > AVC::HIGH_SPEED_THRESHOLD ? AVC::HIGH_SPEED_BOOST
+              : speed > AVC::LOW_SPEED_THRESHOLD ? AVC::MEDIUM_SPEED_BOOST
+              : speed > 0 ? AVC::LOW_SPEED_BOOST : 0;
+    const float speedVolume = AVC::BASE_VOLUME + static_cast<float>(boost);
+    const float modeMultiplier = newMode == Mode::ECO ? AVC::ECO_MULTIPLIER
+                               : newMode == Mode::SPORTS ? AVC::SPORTS_MULTIPLIER : 1.0f;
+    const float hornMultiplier = hornDuckActive ? AVC::HORN_DUCK_MULTIPLIER : 1.0f;
+    const float reverseMultiplier = newReverseGear ? AVC::REVERSE_MULTIPLIER : 1.0f;
+    float brakeMultiplier = 1.0f;
+    if(!newReverseGear) {
+        if(previousSpeed - speed > AVC::SUDDEN_BRAKE_THRESHOLD) brakeMultiplier = AVC::SUDDEN_BRAKE_MULTIPLIER;
+        else if(speed < previousSpeed) brakeMultiplier = AVC::SPEED_DECREASE_MULTIPLIER;
+    }
+
+    // --- Per-zone pass: branch-free, multipliers applied in applyVolumeModifiers() order ---
+    for(std::size_t z = 0; z < zones; ++z) {
+        float volume = speedVolume;
+        volume += cabinNoise[z] * AVC::NOISE_SLOPE;
+        volume *= modeMultiplier;
+        volume *= hornMultiplier;
+        volume *= navSpeaking[z] ? AVC::NAV_DUCK_MULTIPLIER : 1.0f;
+        volume *= reverseMultiplier;
+        volume *= brakeMultiplier;
+        volume = volume < AVC::MIN_VOLUME ? AVC::MIN_VOLUME : volume;
+        volume = volume > AVC::MAX_ADAPTIVE_VOLUME ? AVC::MAX_ADAPTIVE_VOLUME : volume;
+
+        float manualTarget = std::clamp<float>(manualVolume[z], AVC::MIN_VOLUME, AVC::MAX_VOLUME);
+        targetVolume[z] = manual[z] ? manualTarget : volume;
+    }
+}
+
+/**
+ * @brief Advances the smoothing of every zone in one pass.
+ * @param dt Elapsed time in seconds since the previous tick.
+ */
+void ZoneController::tick(double dt) {
+    if(dt != tickDt) {
+        tickDt = dt;
+        tickFactor = 1.0f - static_cast<float>(std::pow(1.0 - AVC::SMOOTH_FACTOR, dt / AVC::SMOOTH_INTERVAL));
+    }
+
+    const float factor = tickFactor;
+    for(std::size_t z = 0; z < zones; ++z) {
+        float target = targetVolume[z];
+        float current = currentVolume[z];
+        bool settled = std::abs(current - target) <= AVC::SETTLE_THRESHOLD;
+        float stepped = current + (target - current) * factor;
+        bool settledAfter = std::abs(stepped - target) <= AVC::SETTLE_THRESHOLD;
+        currentVolume[z] = settled || settledAfter ? target : stepped;
+    }
+}
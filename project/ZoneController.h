@@ -0,0 +1,100 @@
+/**
+ * @file ZoneController.h
+ * @brief Defines the ZoneController class managing several audio zones in one pass.
+ */
+
+#ifndef ZONE_CONTROLLER_H
+#define ZONE_CONTROLLER_H
+
+#include "AdaptiveVolumeControl.h"
+#include "Clock.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class ZoneController
+ * @brief Adaptive volume for up to MAX_ZONES audio zones stored as structure of arrays.
+ *
+ * Vehicle-wide inputs (speed, reverse gear, horn, driving mode) are evaluated
+ * once per update; per-zone inputs (cabin noise, navigation prompt routing,
+ * manual override) live in contiguous arrays and all zones are computed in a
+ * single branch-free loop. Each zone behaves exactly like its own
+ * AdaptiveVolumeControl fed with the same inputs.
+ */
+class ZoneController {
+public:
+    static constexpr std::size_t MAX_ZONES = 32; ///< Capacity of the per-zone arrays
+
+    /**
+     * @brief Constructor initializes all zones to the AdaptiveVolumeControl defaults.
+     * @param zoneCount Number of zones (capped at MAX_ZONES).
+     * @param clock Time source for horn ducking.
+     */
+    explicit ZoneController(std::size_t zoneCount, Clock& clock = SteadyClock::instance());
+
+    /**
+     * @brief Sets the cabin noise measured in a zone.
+     * @param zone Zone index.
+     * @param noise Cabin noise level.
+     */
+    void setZoneNoise(std::size_t zone, int noise) { cabinNoise[zone] = noise; }
+
+    /**
+     * @brief Sets whether a navigation prompt is routed to (and ducks) a zone.
+     * @param zone Zone index.
+     * @param speaking Navigation speaking status.
+     */
+    void setZoneNavSpeaking(std::size_t zone, bool speaking) { navSpeaking[zone] = speaking; }
+
+    /**
+     * @brief Sets the volume control type of a zone.
+     * @param zone Zone index.
+     * @param type Volume control type.
+     * @param volume Manual volume (kept only in manual mode, like update()).
+     */
+    void setZoneControl(std::size_t zone, VolumeControlType type, int volume);
+
+    /**
+     * @brief Applies vehicle-wide inputs and recalculates every zone's target volume.
+     * @param newSpeed Current vehicle speed.
+     * @param newReverseGear Reverse gear status.
+     * @param newHornActive Horn active status.
+     * @param newMode Current driving mode.
+     */
+    void update(int newSpeed, bool newReverseGear, bool newHornActive, Mode newMode);
+
+    /**
+     * @brief Advances the smoothing of every zone (see AdaptiveVolumeControl::tick()).
+     * @param dt Elapsed time in seconds since the previous tick.
+     */
+    void tick(double dt);
+
+    std::size_t zoneCount() const { return zones; }                                 ///< @return Number of zones
+    float getTargetVolume(std::size_t zone) const { return targetVolume[zone]; }    ///< @return Zone target volume
+    float getCurrentVolume(std::size_t zone) const { return currentVolume[zone]; }  ///< @return Zone current volume
+    const float* targetVolumes() const { return targetVolume; }                     ///< @return All zone targets
+    const float* currentVolumes() const { return currentVolume; }                   ///< @return All zone current volumes
+
+private:
+    std::size_t zones;                          ///< Number of active zones
+    Clock* clock;                               ///< Time source for horn ducking
+
+    // Vehicle-wide state
+    int speed;                                  ///< Current speed
+    int previousSpeed;                          ///< Previous speed
+    bool hornActive;                            ///< Horn active status
+    bool hornDuckActive;                        ///< Horn ducking active flag
+    Clock::time_point hornDuckStartTime;        ///< Horn ducking start time
+    double tickDt;                              ///< Elapsed time the cached tick factor was computed for
+    float tickFactor;                           ///< Cached smoothing factor for tickDt
+
+    // Per-zone state (structure of arrays)
+    alignas(64) float targetVolume[MAX_ZONES];  ///< Target volume per zone
+    alignas(64) float currentVolume[MAX_ZONES]; ///< Current volume per zone
+    alignas(64) int cabinNoise[MAX_ZONES];      ///< Cabin noise per zone
+    alignas(64) int manualVolume[MAX_ZONES];    ///< Manual volume per zone
+    alignas(64) bool manual[MAX_ZONES];         ///< Manual control flag per zone
+    alignas(64) bool navSpeaking[MAX_ZONES];    ///< Navigation ducking flag per zone
+};
+
+#endif // ZONE_CONTROLLER_H
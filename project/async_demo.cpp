@@ -0,0 +1,140 @@
+/**
+ * @file async_demo.cpp
+ * @brief Runs the demo event sequence for many simulated vehicles as coroutines on one thread.
+ *
+ * Usage: async_demo [vehicles] [--realtime] [--console]
+ *
+ * Every vehicle is a Task awaiting its events, smoothing ramps and horn-duck
+ * hold on a single AsyncExecutor. By default the executor runs in virtual
+ * time (a ManualClock jumped to the next timer); --realtime sleeps on the
+ * steady clock instead. --console prints the first vehicle's events.
+ * Requires C++20.
+ */
+
+#include "AsyncDriver.h"
+#include "ConsoleVolumeSink.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+/**
+ * @struct ScriptEvent
+ * @brief One step of the demo script (the main.cpp sequence).
+ */
+struct ScriptEvent {
+    ControlInputs inputs;   ///< Inputs applied by the event
+    const char* name;       ///< Event name
+};
+
+/**
+ * @brief Builds inputs for a script event.
+ * @return Packed inputs.
+ */
+ControlInputs makeInputs(int speed, int noise, bool reverse, bool horn, bool nav, Mode mode,
+                         VolumeControlType type = VolumeControlType::ADAPTIVE, int manual = 0) {
+    ControlInputs in;
+    in.speed = speed;
+    in.cabinNoise = noise;
+    in.reverseGear = reverse;
+    in.hornActive = horn;
+    in.navSpeaking = nav;
+    in.mode = mode;
+    in.controlType = type;
+    in.manualVolume = manual;
+    return in;
+}
+
+const ScriptEvent SCRIPT[] = {
+    {makeInputs(0, 30, false, false, false, Mode::ECO), "Engine Started"},
+    {makeInputs(50, 55, false, false, false, Mode::COMFORT), "Acceleration to 50 km/h"},
+    {makeInputs(50, 55, false, true, false, Mode::COMFORT), "Horn Pressed"},
+    {makeInputs(50, 55, false, false, false, Mode::COMFORT), "Horn Released"},
+    {makeInputs(50, 60, false, false, true, Mode::SPORTS), "Navigation Speaking Started"},
+    {makeInputs(50, 60, false, false, false, Mode::SPORTS), "Navigation Speaking Ended"},
+    {makeInputs(50, 60, false, false, false, Mode::COMFORT, VolumeControlType::MANUAL, 90), "User sets Manual Volume 90"},
+    {makeInputs(50, 60, false, false, false, Mode::COMFORT), "Switch back to Adaptive"},
+    {makeInputs(0, 40, true, false, false, Mode::SPORTS), "Reverse Gear Engaged"},
+    {makeInputs(30, 40, false, false, false, Mode::SPORTS), "Reverse to Drive"},
+    {makeInputs(20, 35, false, false, false, Mode::ECO), "Speed Decreased"},
+    {makeInputs(5, 30, false, false, false, Mode::ECO), "Sudden Brake"}
+};
+
+/**
+ * @brief Drives one vehicle through the script.
+ * @param executor Executor running the vehicles.
+ * @param avc Vehicle controller.
+ * @param index Vehicle index (staggers the start).
+ * @param events Incremented per completed event.
+ * @return Task.
+ */
+Task driveVehicle(AsyncExecutor& executor, AdaptiveVolumeControl& avc, int index, long& events) {
+    co_await executor.sleepFor(std::chrono::milliseconds(index * 37 % 1000));
+    for(const ScriptEvent& event : SCRIPT) {
+        co_await runEvent(executor, avc, event.inputs, event.name);
+        if(!event.inputs.hornActive && (avc.getActiveModifiers() & MODIFIER_HORN_DUCK))
+            co_await awaitDuckHold(executor, avc);
+        ++events;
+        co_await executor.sleepFor(std::chrono::seconds(1));
+    }
+}
+
+/**
+ * @brief Runs all vehicles on one executor.
+ * @param executor Executor (virtual or real time).
+ * @param clock Clock of the executor.
+ * @param vehicles Number of vehicles.
+ * @param console Print the first vehicle's events.
+ * @return Exit code.
+ */
+int runVehicles(AsyncExecutor& executor, Clock& clock, int vehicles, bool console) {
+    std::vector<AdaptiveVolumeControl> fleet(vehicles, AdaptiveVolumeControl(clock));
+    ConsoleVolumeSink sink;
+    if(console && vehicles > 0) fleet[0].setEventSink(&sink);
+
+    long events = 0;
+    auto started = std::chrono::steady_clock::now();
+    Clock::time_point simulatedStart = clock.now();
+    for(int i = 0; i < vehicles; ++i) executor.spawn(driveVehicle(executor, fleet[i], i, events));
+    executor.run();
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - started;
+    std::chrono::duration<double> simulated = clock.now() - simulatedStart;
+
+    int unsettled = 0;
+    for(const AdaptiveVolumeControl& avc : fleet)
+        if(avc.getCurrentVolume() != avc.getTargetVolume()) ++unsettled;
+
+    std::fprintf(stderr, "%d vehicles, %ld events on one thread: %.1f s simulated in %.3f s wall, %d unsettled\n",
+                 vehicles, events, simulated.count(), wall.count(), unsettled);
+    return unsettled == 0 ? 0 : 1;
+}
+
+} // namespace
+
+/**
+ * @brief Main entry point. Multiplexes the demo script over many vehicles.
+ * @return Exit code.
+ */
+int main(int argc, char** argv) {
+    int vehicles = 500;
+    bool realtime = false, console = false;
+    for(int i = 1; i < argc; ++i) {
+        if(!std::strcmp(argv[i], "--realtime")) realtime = true;
+        else if(!std::strcmp(argv[i], "--console")) console = true;
+        else if((vehicles = std::atoi(argv[i])) <= 0) {
+            std::fprintf(stderr, "usage: %s [vehicles] [--realtime] [--console]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if(realtime) {
+        AsyncExecutor executor(SteadyClock::instance());
+        return runVehicles(executor, SteadyClock::instance(), vehicles, console);
+    }
+    ManualClock clock;
+    AsyncExecutor executor(clock);
+    return runVehicles(executor, clock, vehicles, console);
+}
@@ -0,0 +1,300 @@
+/**
+ * @file benchmark.cpp
+ * @brief Google Benchmark suite for AdaptiveVolumeControl hot paths.
+ *
+ * Covers update() throughput (silent core, the compile-time specialized
+ * controllers, and with the console sink formatting into a discarded
+ * stream), per-call calculateTargetVolume() latency
+ * percentiles with cached and changing inputs, smoothing convergence steps, and the batch and block paths.
+ */
+
+#include "AdaptiveVolumeControl.h"
+#include "BasicVolumeControl.h"
+#include "ConsoleVolumeSink.h"
+#include "GainRamp.h"
+#include "VolumeBatch.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <streambuf>
+#include <vector>
+
+namespace {
+
+/**
+ * @class NullBuffer
+ * @brief Stream buffer that discards everything (measures formatting without terminal I/O).
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+/**
+ * @struct Probe
+ * @brief Exposes the protected policy step for latency measurement.
+ */
+struct Probe : AdaptiveVolumeControl {
+    using AdaptiveVolumeControl::AdaptiveVolumeControl;
+    using AdaptiveVolumeControl::calculateTargetVolume;
+    void invalidateBaseVolume() { baseVolumeStale = true; } ///< Forces the next calculateTargetVolume() to recompute the base
+};
+
+/**
+ * @brief Generates a reproducible sequence of control inputs.
+ * @param count Number of input sets.
+ * @return Inputs covering all modes and modifiers.
+ */
+std::vector<ControlInputs> makeInputs(std::size_t count) {
+    std::mt19937 rng(11);
+    std::vector<ControlInputs> inputs(count);
+    int speed = 50;
+    for(ControlInputs& in : inputs) {
+        speed = std::max(0, std::min(160, speed + std::uniform_int_distribution<int>(-15, 12)(rng)));
+        in.speed = speed;
+        in.cabinNoise = std::uniform_int_distribution<int>(20, 110)(rng);
+        in.reverseGear = rng() % 20 == 0;
+        in.hornActive = rng() % 10 == 0;
+        in.navSpeaking = rng() % 5 == 0;
+        in.mode = static_cast<Mode>(rng() % 3);
+        in.controlType = rng() % 10 == 0 ? VolumeControlType::MANUAL : VolumeControlType::ADAPTIVE;
+        in.manualVolume = static_cast<int>(rng() % 100);
+    }
+    return inputs;
+}
+
+/**
+ * @brief update() throughput with no sink attached.
+ */
+void BM_UpdateSilent(benchmark::State& state) {
+    auto inputs = makeInputs(4096);
+    ManualClock clock;
+    AdaptiveVolumeControl avc(clock);
+    std::size_t i = 0;
+    for(auto _ : state) {
+        avc.update(inputs[i++ & 4095]);
+        benchmark::DoNotOptimize(avc.getTargetVolume());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UpdateSilent);
+
+/**
+ * @brief update() + tick() of one Comfort/adaptive zone; range(0) selects 0 facade, 1 BasicVolumeControl, 2 RuntimeVolumeControl.
+ */
+void BM_UpdateSpecialized(benchmark::State& state) {
+    auto inputs = makeInputs(4096);
+    for(ControlInputs& in : inputs) {
+        in.mode = Mode::COMFORT;
+        in.controlType = VolumeControlType::ADAPTIVE;
+    }
+    ManualClock clock;
+    AdaptiveVolumeControl avc(clock);
+    BasicVolumeControl<Mode::COMFORT, VolumeControlType::ADAPTIVE> basic(clock);
+    RuntimeVolumeControl<> runtime(clock);
+    std::size_t i = 0;
+    for(auto _ : state) {
+        const ControlInputs& in = inputs[i++ & 4095];
+        if(state.range(0) == 0) {
+            avc.update(in);
+            avc.tick(0.001);
+            benchmark::DoNotOptimize(avc.getCurrentVolume());
+        } else if(state.range(0) == 1) {
+            basic.update(in);
+            basic.tick(0.001);
+            benchmark::DoNotOptimize(basic.getCurrentVolume());
+        } else {
+            runtime.update(in);
+            runtime.tick(0.001);
+            benchmark::DoNotOptimize(runtime.getCurrentVolume());
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UpdateSpecialized)->Arg(0)->Arg(1)->Arg(2);
+
+/**
+ * @brief update() throughput with the console sink formatting every event.
+ */
+void BM_UpdateConsoleSink(benchmark::State& state) {
+    auto inputs = makeInputs(4096);
+    NullBuffer discard;
+    std::ostream out(&discard);
+    ConsoleVolumeSink console(out);
+    ManualClock clock;
+    AdaptiveVolumeControl avc(clock);
+    avc.setEventSink(&console);
+    std::size_t i = 0;
+    for(auto _ : state) {
+        avc.update(inputs[i++ & 4095]);
+        benchmark::DoNotOptimize(avc.getTargetVolume());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UpdateConsoleSink);
+
+/**
+ * @brief Median cost of one steady_clock timestamp pair, subtracted from each latency sample.
+ * @return Overhead in nanoseconds.
+ */
+double timerOverheadNs() {
+    std::vector<double> pairs(1001);
+    for(double& pair : pairs) {
+        auto start = std::chrono::steady_clock::now();
+        auto stop = std::chrono::steady_clock::now();
+        pair = std::chrono::duration<double, std::nano>(stop - start).count();
+    }
+    std::nth_element(pairs.begin(), pairs.begin() + pairs.size() / 2, pairs.end());
+    return pairs[pairs.size() / 2];
+}
+
+/**
+ * @brief Per-call calculateTargetVolume() latency; range(0) selects 0 cached (inputs held) or 1 uncached (inputs change every frame).
+ *
+ * Each call is timed on its own and the timer overhead is subtracted, so
+ * p50/p99 are per call. With held inputs every call reuses the cached base
+ * volume; with changing inputs every call recomputes it.
+ */
+void BM_CalculateTargetVolumeLatency(benchmark::State& state) {
+    bool changing = state.range(0) != 0;
+    auto inputs = makeInputs(4096);
+    ManualClock clock;
+    Probe avc(clock);
+    avc.update(inputs[0]);
+    double overhead = timerOverheadNs();
+    std::vector<double> samples;
+    samples.reserve(1 << 20);
+    std::size_t i = 0;
+    for(auto _ : state) {
+        if(changing) {
+            state.PauseTiming();
+            // update() already consumed the change; restage it so the timed call computes the base like a changed frame
+            avc.update(inputs[++i & 4095]);
+            avc.invalidateBaseVolume();
+            state.ResumeTiming();
+        }
+        auto start = std::chrono::steady_clock::now();
+        avc.calculateTargetVolume();
+        auto stop = std::chrono::steady_clock::now();
+        benchmark::DoNotOptimize(avc.getTargetVolume());
+        if(samples.size() < samples.capacity())
+            samples.push_back(std::max(0.0, std::chrono::duration<double, std::nano>(stop - start).count() - overhead));
+    }
+    if(!samples.empty()) {
+        std::sort(samples.begin(), samples.end());
+        state.counters["p50_ns"] = samples[samples.size() / 2];
+        state.counters["p99_ns"] = samples[samples.size() * 99 / 100];
+        state.counters["timer_ns"] = overhead;
+    }
+    state.SetLabel(changing ? "uncached" : "cached");
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CalculateTargetVolumeLatency)->Arg(0)->Arg(1);
+
+/**
+ * @brief Steps needed by tick() to settle after a target jump; range(0) selects the sink (0 none, 1 console).
+ */
+void BM_SmoothConvergence(benchmark::State& state) {
+    NullBuffer discard;
+    std::ostream out(&discard);
+    ConsoleVolumeSink console(out);
+    ManualClock clock;
+    AdaptiveVolumeControl avc(clock);
+    if(state.range(0)) avc.setEventSink(&console);
+    long steps = 0, events = 0;
+    bool loud = false;
+    for(auto _ : state) {
+        loud = !loud;
+        avc.update(loud ? 150 : 0, loud ? 110 : 20, false, false, false, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0);
+        while(!avc.isSettled()) {
+            avc.tick(AdaptiveVolumeControl::SMOOTH_INTERVAL);
+            ++steps;
+        }
+        avc.tick(AdaptiveVolumeControl::SMOOTH_INTERVAL); // snap
+        ++events;
+    }
+    state.counters["steps_per_event"] = static_cast<double>(steps) / std::max(1L, events);
+    state.SetItemsProcessed(events);
+}
+BENCHMARK(BM_SmoothConvergence)->Arg(0)->Arg(1);
+
+/**
+ * @brief calculateTargetVolumeBatch() throughput over range(0) frames.
+ */
+void BM_Batch(benchmark::State& state) {
+    std::size_t n = static_cast<std::size_t>(state.range(0));
+    auto inputs = makeInputs(n);
+    std::vector<std::int64_t> ts(n);
+    std::vector<int> speed(n), noise(n), manual(n);
+    std::unique_ptr<bool[]> reverse(new bool[n]), horn(new bool[n]), nav(new bool[n]);
+    std::vector<Mode> mode(n);
+    std::vector<VolumeControlType> type(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        ts[i] = static_cast<std::int64_t>(i) * 10000000;
+        speed[i] = inputs[i].speed;
+        noise[i] = inputs[i].cabinNoise;
+        manual[i] = inputs[i].manualVolume;
+        reverse[i] = inputs[i].reverseGear;
+        horn[i] = inputs[i].hornActive;
+        nav[i] = inputs[i].navSpeaking;
+        mode[i] = inputs[i].mode;
+        type[i] = inputs[i].controlType;
+    }
+    TelemetryColumns columns{ts.data(), speed.data(), noise.data(), reverse.get(), horn.get(), nav.get(),
+                             mode.data(), type.data(), manual.data()};
+    std::vector<float> out(n);
+    for(auto _ : state) {
+        BatchState batchState;
+        calculateTargetVolumeBatch(columns, n, out.data(), batchState);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Batch)->Arg(1 << 16);
+
+/**
+ * @brief processBlock() on a 10 ms, 8-channel block at 48 kHz.
+ */
+void BM_ProcessBlock(benchmark::State& state) {
+    constexpr std::size_t FRAMES = 480;
+    constexpr int CHANNELS = 8;
+    std::vector<float> pcm(FRAMES * CHANNELS, 0.5f);
+    ManualClock clock;
+    AdaptiveVolumeControl avc(clock);
+    bool loud = false;
+    for(auto _ : state) {
+        if(avc.isSettled()) {
+            loud = !loud;
+            avc.update(loud ? 100 : 0, 60, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+        }
+        avc.processBlock(pcm.data(), FRAMES, CHANNELS);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * FRAMES * CHANNELS);
+}
+BENCHMARK(BM_ProcessBlock);
+
+/**
+ * @brief Gain ramp kernels; range(0) selects 0 scalar reference, 1 dispatched SIMD.
+ */
+void BM_GainRamp(benchmark::State& state) {
+    constexpr std::size_t FRAMES = 480;
+    constexpr int CHANNELS = 8;
+    std::vector<float> pcm(FRAMES * CHANNELS, 0.5f);
+    auto ramp = state.range(0) ? applyGainRamp : applyGainRampScalar;
+    for(auto _ : state) {
+        ramp(pcm.data(), FRAMES, CHANNELS, 1.0f, 1.0f);
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(state.range(0) ? gainRampImplementation() : "scalar");
+    state.SetItemsProcessed(state.iterations() * FRAMES * CHANNELS);
+}
+BENCHMARK(BM_GainRamp)->Arg(0)->Arg(1);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,339 @@
+/**
+ * @file fleet_server.cpp
+ * @brief Digital-twin server advancing a whole fleet per telemetry batch received over TCP.
+ *
+ * Usage: fleet_server [--port N] [--vehicles N] [--threads N] [--dt S] [--timeout S] [--connections N] [--no-pin]
+ *        fleet_server --client PORT [--vehicles N] [--records N] [--batches N] [--dt S] [--seed N]
+ *
+ * Server: listens on --port (POSIX sockets) and serves one telemetry
+ * gateway connection at a time. Each message is a FleetFrameHeader with
+ * FLEET_BATCH_MAGIC followed by count FleetTelemetry records. The records
+ * are ingested, every vehicle advances one frame, and the reply is a
+ * FleetFrameHeader with FLEET_TRACE_MAGIC (echoing the batch timestamp)
+ * followed by the current volume of each record's vehicle as float (NaN for
+ * unknown vehicles).
+ *
+ * Timestamps are per connection: they must advance within a connection
+ * (dt = time since the previous batch), and the first batch of every
+ * connection advances the fleet by --dt. A reconnecting gateway may thus
+ * restart its stream at any value. The fleet keeps its own monotonic frame
+ * time across connections, so horn holds carry over. A malformed header, a
+ * timestamp that does not advance (equal or backwards: dt must be positive)
+ * or a gateway that sends nothing for --timeout seconds (default 5, 0 =
+ * wait forever) closes the connection. The server exits after
+ * --connections connections (0 = never).
+ *
+ * Client: a load generator sending --batches batches of --records random
+ * records to 127.0.0.1:PORT, checking each reply and printing throughput.
+ */
+
+#include "VehicleFleet.h"
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::uint32_t MAX_BATCH_RECORDS = 1u << 24; ///< Larger batches are rejected (192 MB of records)
+
+/**
+ * @struct ServerConfig
+ * @brief Command-line parameters.
+ */
+struct ServerConfig {
+    int port = 7411;                    ///< TCP port
+    FleetConfig fleet;                  ///< Fleet size, workers and pinning
+    double dt = 0.1;                    ///< Frame period of the first batch (and of the client)
+    double timeout = 5.0;               ///< Receive timeout in seconds for a stalled gateway (0 = none)
+    std::uint64_t connections = 0;      ///< Connections to serve before exiting (0 = forever)
+    bool client = false;                ///< Run the load generator instead of the server
+    std::uint32_t records = 100000;     ///< Client: records per batch
+    std::uint64_t batches = 100;        ///< Client: batches to send
+    std::uint64_t seed = 1;             ///< Client: input stream seed
+};
+
+/**
+ * @struct StreamTime
+ * @brief Fleet frame time of the last batch; kept across connections, like the fleet state.
+ */
+struct StreamTime {
+    bool started = false;           ///< A batch was advanced
+    std::int64_t lastNs = 0;        ///< Fleet time of that batch (monotonic, independent of gateway timestamps)
+};
+
+/**
+ * @brief Reads exactly size bytes.
+ * @param fd Socket.
+ * @param data Destination.
+ * @param size Bytes to read.
+ * @return False on error, end of stream or receive timeout.
+ */
+bool readAll(int fd, void* data, std::size_t size) {
+    char* out = static_cast<char*>(data);
+    while(size > 0) {
+        ssize_t n = ::recv(fd, out, size, 0);
+        if(n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            std::fprintf(stderr, "fleet_server: receive timed out, closing connection\n");
+            return false;
+        }
+        if(n <= 0) return false;
+        out += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief Writes exactly size bytes.
+ * @param fd Socket.
+ * @param data Source.
+ * @param size Bytes to write.
+ * @return False on error.
+ */
+bool writeAll(int fd, const void* data, std::size_t size) {
+    const char* in = static_cast<const char*>(data);
+    while(size > 0) {
+        ssize_t n = ::send(fd, in, size, MSG_NOSIGNAL);
+        if(n <= 0) return false;
+        in += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief Serves one gateway connection until it closes or misbehaves.
+ * @param fd Connected socket.
+ * @param fleet Fleet to drive.
+ * @param time Fleet time of the previous batch, updated.
+ * @param config Parameters.
+ */
+void serveConnection(int fd, VehicleFleet& fleet, StreamTime& time, const ServerConfig& config) {
+    std::vector<FleetTelemetry> records;   // grows to the largest batch, then reused
+    std::vector<float> volumes;
+    std::uint64_t batches = 0, received = 0;
+    double advanceSeconds = 0.0;
+    bool connected = false;                // a batch of this connection was advanced
+    std::int64_t previousNs = 0;           // gateway timestamp of that batch
+
+    FleetFrameHeader header;
+    while(readAll(fd, &header, sizeof(header))) {
+        if(header.magic != FLEET_BATCH_MAGIC || header.count > MAX_BATCH_RECORDS) {
+            std::fprintf(stderr, "fleet_server: malformed batch header, closing connection\n");
+            break;
+        }
+        if(connected && header.timestampNs <= previousNs) {
+            std::fprintf(stderr, "fleet_server: timestamp did not advance, closing connection\n");
+            break;
+        }
+        records.resize(header.count);
+        volumes.resize(header.count);
+        if(!readAll(fd, records.data(), records.size() * sizeof(FleetTelemetry))) break;
+
+        std::int64_t dtNs = connected ? header.timestampNs - previousNs : static_cast<std::int64_t>(config.dt * 1e9);
+        double dt = connected ? static_cast<double>(dtNs) * 1e-9 : config.dt;
+        connected = true;
+        previousNs = header.timestampNs;
+        time.lastNs = time.started ? time.lastNs + dtNs : header.timestampNs;
+        time.started = true;
+
+        auto start = std::chrono::steady_clock::now();
+        fleet.ingest(records.data(), records.size());
+        fleet.advance(time.lastNs, dt);
+        fleet.trace(records.data(), records.size(), volumes.data());
+        advanceSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        FleetFrameHeader reply{FLEET_TRACE_MAGIC, header.count, header.timestampNs};
+        if(!writeAll(fd, &reply, sizeof(reply)) || !writeAll(fd, volumes.data(), volumes.size() * sizeof(float))) break;
+        ++batches;
+        received += header.count;
+    }
+
+    double vehicleFrames = static_cast<double>(batches) * fleet.getVehicles();
+    std::printf("connection closed: %llu batches, %llu records, %.1f M vehicle-frames/s in ingest+advance\n",
+                static_cast<unsigned long long>(batches), static_cast<unsigned long long>(received),
+                advanceSeconds > 0.0 ? vehicleFrames / advanceSeconds * 1e-6 : 0.0);
+    std::fflush(stdout);
+}
+
+/**
+ * @brief Runs the server.
+ * @param config Parameters.
+ * @return Exit code.
+ */
+int runServer(const ServerConfig& config) {
+    VehicleFleet fleet(config.fleet);
+    std::printf("%u vehicles (%zu bytes each) in %u shards:", fleet.getVehicles(), VehicleFleet::BYTES_PER_VEHICLE,
+                fleet.getShards());
+    for(unsigned s = 0; s < fleet.getShards(); ++s) std::printf(" %u@node%d/cpu%d", fleet.getShardVehicles(s),
+                                                               fleet.getShardNode(s), fleet.getShardCpu(s));
+    std::printf("\n");
+
+    int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    int on = 1;
+    if(listener >= 0) ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(static_cast<std::uint16_t>(config.port));
+    if(listener < 0 || ::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+       ::listen(listener, 4) != 0) {
+        std::perror("fleet_server: listen");
+        return 1;
+    }
+    std::printf("listening on port %d\n", config.port);
+    std::fflush(stdout);
+
+    StreamTime time;
+    for(std::uint64_t served = 0; config.connections == 0 || served < config.connections; ++served) {
+        int fd = ::accept(listener, nullptr, nullptr);
+        if(fd < 0) continue;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        if(config.timeout > 0.0) {
+            // A stalled gateway must not block the next one forever
+            timeval timeout{};
+            timeout.tv_sec = static_cast<time_t>(config.timeout);
+            timeout.tv_usec = static_cast<suseconds_t>((config.timeout - static_cast<double>(timeout.tv_sec)) * 1e6);
+            ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        }
+        serveConnection(fd, fleet, time, config);
+        ::close(fd);
+    }
+    ::close(listener);
+    return 0;
+}
+
+/**
+ * @brief Runs the load generator against a local server.
+ * @param config Parameters.
+ * @return Exit code.
+ */
+int runClient(const ServerConfig& config) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<std::uint16_t>(config.port));
+    if(fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        std::perror("fleet_server: connect");
+        return 1;
+    }
+    int on = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+    std::uint64_t state = config.seed * 0x9E3779B97F4A7C15ULL + 1;
+    auto draw = [&state] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<std::uint32_t>(state >> 32);
+    };
+
+    std::vector<FleetTelemetry> records(config.records);
+    std::vector<float> volumes(config.records);
+    std::uint64_t frameNs = static_cast<std::uint64_t>(config.dt * 1e9);
+    auto start = std::chrono::steady_clock::now();
+    for(std::uint64_t batch = 0; batch < config.batches; ++batch) {
+        for(FleetTelemetry& record : records) {
+            std::uint32_t r = draw();
+            record.vehicle = draw() % config.fleet.vehicles;
+            record.speed = static_cast<std::int16_t>(r % 160);
+            record.cabinNoise = static_cast<std::uint8_t>((r >> 8) % 120);
+            record.manualVolume = static_cast<std::uint8_t>((r >> 16) % 101);
+            record.flags = static_cast<std::uint8_t>((r >> 24) % 64 == 0 ? FLEET_HORN : 0) |
+                           static_cast<std::uint8_t>((r >> 24) % 97 == 1 ? FLEET_NAVIGATION : 0) |
+                           static_cast<std::uint8_t>((r >> 24) % 251 == 2 ? FLEET_MANUAL : 0);
+            record.mode = static_cast<std::uint8_t>(draw() % 3);
+            record.reserved = 0;
+        }
+        FleetFrameHeader header{FLEET_BATCH_MAGIC, config.records, static_cast<std::int64_t>(batch * frameNs)};
+        FleetFrameHeader reply;
+        if(!writeAll(fd, &header, sizeof(header)) || !writeAll(fd, records.data(), records.size() * sizeof(FleetTelemetry)) ||
+           !readAll(fd, &reply, sizeof(reply)) || reply.magic != FLEET_TRACE_MAGIC || reply.count != config.records ||
+           reply.timestampNs != header.timestampNs || !readAll(fd, volumes.data(), volumes.size() * sizeof(float))) {
+            std::fprintf(stderr, "fleet_server: bad reply to batch %llu\n", static_cast<unsigned long long>(batch));
+            return 1;
+        }
+        for(float volume : volumes) {
+            if(!(volume >= AdaptiveVolumeControl::MIN_VOLUME && volume <= AdaptiveVolumeControl::MAX_VOLUME)) {
+                std::fprintf(stderr, "fleet_server: volume %f out of range\n", volume);
+                return 1;
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ::close(fd);
+    std::printf("%llu batches of %u records in %.3f s: %.1f batches/s, %.1f M records/s\n",
+                static_cast<unsigned long long>(config.batches), config.records, seconds,
+                static_cast<double>(config.batches) / seconds,
+                static_cast<double>(config.batches) * config.records / seconds * 1e-6);
+    return 0;
+}
+
+/**
+ * @brief Parses the command line.
+ * @param argc Argument count.
+ * @param argv Arguments.
+ * @param config Receives the parameters.
+ * @return False on a malformed command line.
+ */
+bool parseArguments(int argc, char** argv, ServerConfig& config) {
+    for(int i = 1; i < argc; ++i) {
+        const char* name = argv[i];
+        if(!std::strcmp(name, "--no-pin")) {
+            config.fleet.pinThreads = false;
+            continue;
+        }
+        if(i + 1 >= argc) return false;
+        const char* value = argv[++i];
+        char* end = nullptr;
+        if(!std::strcmp(name, "--port")) config.port = static_cast<int>(std::strtol(value, &end, 10));
+        else if(!std::strcmp(name, "--client")) {
+            config.client = true;
+            config.port = static_cast<int>(std::strtol(value, &end, 10));
+        }
+        else if(!std::strcmp(name, "--vehicles")) config.fleet.vehicles = static_cast<std::uint32_t>(std::strtoul(value, &end, 10));
+        else if(!std::strcmp(name, "--threads")) config.fleet.threads = static_cast<unsigned>(std::strtoul(value, &end, 10));
+        else if(!std::strcmp(name, "--dt")) config.dt = std::strtod(value, &end);
+        else if(!std::strcmp(name, "--timeout")) config.timeout = std::strtod(value, &end);
+        else if(!std::strcmp(name, "--connections")) config.connections = std::strtoull(value, &end, 10);
+        else if(!std::strcmp(name, "--records")) config.records = static_cast<std::uint32_t>(std::strtoul(value, &end, 10));
+        else if(!std::strcmp(name, "--batches")) config.batches = std::strtoull(value, &end, 10);
+        else if(!std::strcmp(name, "--seed")) config.seed = std::strtoull(value, &end, 10);
+        else return false;
+        if(!end || *end) return false;
+    }
+    return config.port > 0 && config.port < 65536 && config.fleet.vehicles > 0 && config.dt > 0.0 && config.timeout >= 0.0 &&
+           config.records > 0 && config.records <= MAX_BATCH_RECORDS;
+}
+
+} // namespace
+
+/**
+ * @brief Main entry point. Runs the server or the load generator.
+ * @return Exit code.
+ */
+int main(int argc, char** argv) {
+    ServerConfig config;
+    config.fleet.vehicles = 1000000;
+    if(!parseArguments(argc, argv, config)) {
+        std::fprintf(stderr, "usage: %s [--port N] [--vehicles N] [--threads N] [--dt S] [--timeout S] [--connections N] [--no-pin]\n"
+                             "       %s --client PORT [--vehicles N] [--records N] [--batches N] [--dt S] [--seed N]\n",
+                     argv[0], argv[0]);
+        return 2;
+    }
+    return config.client ? runClient(config) : runServer(config);
+}
@@ -4,6 +4,8 @@
  */
 
 #include "AdaptiveVolumeControl.h"
+#include "ConsoleVolumeSink.h"
+#include "EventRegistry.h"
 #include <iostream>
 #include <thread>
 
@@ -13,6 +15,10 @@
  */
 int main() {
     AdaptiveVolumeControl avc;
+    ConsoleVolumeSink console;
+    EventRegistry registry;
+    avc.setEventSink(&console);
+    avc.setEventRegistry(&registry);
 
     /**
      * @struct Event
@@ -27,28 +33,28 @@ int main() {
         Mode mode;                       ///< Driving mode
         VolumeControlType controlType;   ///< Volume control type
         int manualVolume;                ///< Manual volume value
-        std::string name;                ///< Event name
+        EventId id;                      ///< Interned event name
     };
 
     Event events[] = {
-        {0, 30, false, false, false, Mode::ECO, VolumeControlType::ADAPTIVE, 0, "Engine Started"},
-        {50, 55, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0, "Acceleration to 50 km/h"},
-        {50, 55, false, true, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0, "Horn Pressed"},
-        {50, 55, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0, "Horn Released"},
-        {50, 60, false, false, true, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0, "Navigation Speaking Started"},
-        {50, 60, false, false, false, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0, "Navigation Speaking Ended"},
-        {50, 60, false, false, false, Mode::COMFORT, VolumeControlType::MANUAL, 90, "User sets Manual Volume 90"},
-        {50, 60, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0, "Switch back to Adaptive"},
-        {0, 40, true, false, false, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0, "Reverse Gear Engaged"},
-        {30, 40, false, false, false, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0, "Reverse to Drive"},
-        {20, 35, false, false, false, Mode::ECO, VolumeControlType::ADAPTIVE, 0, "Speed Decreased"},
-        {5, 30, false, false, false, Mode::ECO, VolumeControlType::ADAPTIVE, 0, "Sudden Brake"}
+        {0, 30, false, false, false, Mode::ECO, VolumeControlType::ADAPTIVE, 0, registry.intern("Engine Started")},
+        {50, 55, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0, registry.intern("Acceleration to 50 km/h")},
+        {50, 55, false, true, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0, registry.intern("Horn Pressed")},
+        {50, 55, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0, registry.intern("Horn Released")},
+        {50, 60, false, false, true, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0, registry.intern("Navigation Speaking Started")},
+        {50, 60, false, false, false, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0, registry.intern("Navigation Speaking Ended")},
+        {50, 60, false, false, false, Mode::COMFORT, VolumeControlType::MANUAL, 90, registry.intern("User sets Manual Volume 90")},
+        {50, 60, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0, registry.intern("Switch back to Adaptive")},
+        {0, 40, true, false, false, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0, registry.intern("Reverse Gear Engaged")},
+        {30, 40, false, false, false, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0, registry.intern("Reverse to Drive")},
+        {20, 35, false, false, false, Mode::ECO, VolumeControlType::ADAPTIVE, 0, registry.intern("Speed Decreased")},
+        {5, 30, false, false, false, Mode::ECO, VolumeControlType::ADAPTIVE, 0, registry.intern("Sudden Brake")}
     };
 
     for (const auto& e : events) {
         avc.update(e.speed, e.noise, e.reverseGear, e.hornActive, e.navSpeaking,
                    e.mode, e.controlType, e.manualVolume);
-        avc.printAndSmooth(e.name);
+        avc.printAndSmooth(e.id);
         std::this_thread::sleep_for(std::chrono::seconds(1));
     }
 
@@ -0,0 +1,236 @@
+/**
+ * @file regression.cpp
+ * @brief Runs recorded telemetry captures through the controllers and diffs the volume traces against golden files.
+ *
+ * Usage: regression [--update] [directory]
+ *
+ * Every <name>.avlog capture in the directory (default "regression") is
+ * replayed under a ManualClock, exactly like replay.cpp, and compared with
+ * <name>.golden:
+ *   float  AdaptiveVolumeControl target and current volume (exact)
+ *   batch  calculateTargetVolumeBatch() target volume (exact)
+ *   fixed  FixedPointVolumeControl target and current volume (documented tolerances)
+ * Builds with ADAPTIVE_VOLUME_USE_LUT must match the same goldens exactly.
+ * --update rewrites the goldens from the float controller; review the
+ * reported drift before committing them.
+ */
+
+#include "AdaptiveVolumeControl.h"
+#include "FixedPointVolumeControl.h"
+#include "GoldenTrace.h"
+#include "TelemetryLog.h"
+#include "VolumeBatch.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Current-volume tolerance of the fixed-point build: its per-tick rounding can
+/// settle one tick apart from the float controller, leaving up to a settle
+/// threshold of difference for that tick.
+constexpr float FIXED_CURRENT_TOLERANCE = AdaptiveVolumeControl::SETTLE_THRESHOLD + FixedPointVolumeControl::FLOAT_TOLERANCE;
+
+/**
+ * @struct VolumeTrace
+ * @brief Planar target/current columns produced by one pipeline.
+ */
+struct VolumeTrace {
+    std::vector<float> target;   ///< Target volume per frame
+    std::vector<float> current;  ///< Current volume per frame
+};
+
+/**
+ * @brief Replays a capture through AdaptiveVolumeControl (the replay.cpp loop).
+ * @param capture Recorded frames.
+ * @return Volume trace.
+ */
+VolumeTrace runFloat(const TelemetryLogView& capture) {
+    VolumeTrace trace;
+    trace.target.reserve(capture.size());
+    trace.current.reserve(capture.size());
+    ManualClock clock;
+    AdaptiveVolumeControl avc(clock);
+    std::int64_t previousNs = capture.size() ? capture.begin()->timestampNs : 0;
+    for(const TelemetryRecord& record : capture) {
+        avc.tick((record.timestampNs - previousNs) * 1e-9);
+        previousNs = record.timestampNs;
+        clock.set(Clock::time_point(std::chrono::nanoseconds(record.timestampNs)));
+        applyRecord(avc, record);
+        trace.target.push_back(avc.getTargetVolume());
+        trace.current.push_back(avc.getCurrentVolume());
+    }
+    return trace;
+}
+
+/**
+ * @brief Evaluates the capture's targets with calculateTargetVolumeBatch().
+ * @param capture Recorded frames.
+ * @return Target volume per frame.
+ */
+std::vector<float> runBatch(const TelemetryLogView& capture) {
+    std::size_t n = capture.size();
+    std::vector<std::int64_t> timestampNs(n);
+    std::vector<int> speed(n), noise(n), manualVolume(n);
+    std::unique_ptr<bool[]> reverseGear(new bool[n]), hornActive(new bool[n]), navSpeaking(new bool[n]);
+    std::vector<Mode> mode(n);
+    std::vector<VolumeControlType> controlType(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        const TelemetryRecord& record = capture.begin()[i];
+        timestampNs[i] = record.timestampNs;
+        speed[i] = record.speed;
+        noise[i] = record.noise;
+        manualVolume[i] = record.manualVolume;
+        reverseGear[i] = record.reverseGear != 0;
+        hornActive[i] = record.hornActive != 0;
+        navSpeaking[i] = record.navSpeaking != 0;
+        mode[i] = static_cast<Mode>(record.mode);
+        controlType[i] = static_cast<VolumeControlType>(record.controlType);
+    }
+
+    TelemetryColumns columns{timestampNs.data(), speed.data(), noise.data(), reverseGear.get(), hornActive.get(),
+                             navSpeaking.get(), mode.data(), controlType.data(), manualVolume.data()};
+    std::vector<float> target(n);
+    BatchState state;
+    calculateTargetVolumeBatch(columns, n, target.data(), state);
+    return target;
+}
+
+/**
+ * @brief Replays a capture through FixedPointVolumeControl.
+ * @param capture Recorded frames.
+ * @return Volume trace.
+ */
+VolumeTrace runFixed(const TelemetryLogView& capture) {
+    VolumeTrace trace;
+    trace.target.reserve(capture.size());
+    trace.current.reserve(capture.size());
+    ManualClock clock;
+    FixedPointVolumeControl fixed(clock);
+    std::int64_t previousNs = capture.size() ? capture.begin()->timestampNs : 0;
+    std::int64_t intervalNs = -1;
+    for(const TelemetryRecord& record : capture) {
+        std::int64_t gapNs = record.timestampNs - previousNs;
+        if(gapNs != intervalNs) {
+            intervalNs = gapNs;
+            fixed.setTickInterval(gapNs * 1e-9);
+        }
+        if(gapNs > 0) fixed.tick();
+        previousNs = record.timestampNs;
+        clock.set(Clock::time_point(std::chrono::nanoseconds(record.timestampNs)));
+        fixed.update(record.speed, record.noise, record.reverseGear != 0, record.hornActive != 0,
+                     record.navSpeaking != 0, static_cast<Mode>(record.mode),
+                     static_cast<VolumeControlType>(record.controlType), record.manualVolume);
+        trace.target.push_back(fixed.getTargetVolume());
+        trace.current.push_back(fixed.getCurrentVolume());
+    }
+    return trace;
+}
+
+/**
+ * @brief Diffs one column against the golden file and prints the summary line.
+ * @return True if no frame exceeds the tolerance.
+ */
+bool report(const std::string& name, std::size_t frames, const char* pipeline, const char* column,
+            const float* expected, const float* actual, float tolerance) {
+    TraceDiff diff = diffTraces(expected, actual, frames, tolerance);
+    bool ok = diff.exceeding == 0;
+    char frame[24] = "-";
+    if(diff.maxError > 0.0f) std::snprintf(frame, sizeof(frame), "%zu", diff.maxIndex);
+    std::printf("%-20s %8zu  %-6s %-8s %10.6f %10.6f %9s  %s", name.c_str(), frames, pipeline, column,
+                diff.maxError, diff.meanError, frame, ok ? "ok" : "FAIL");
+    if(!ok) std::printf(" (%zu frames above %.3f, expected %.3f got %.3f)", diff.exceeding, tolerance,
+                        expected[diff.maxIndex], actual[diff.maxIndex]);
+    std::printf("\n");
+    return ok;
+}
+
+} // namespace
+
+/**
+ * @brief Main entry point. Checks every capture of a directory against its golden trace.
+ * @return 0 if every trace matches, 1 on drift or missing files, 2 on bad usage.
+ */
+int main(int argc, char** argv) {
+    bool update = false;
+    std::string directory = "regression";
+    for(int i = 1; i < argc; ++i) {
+        if(!std::strcmp(argv[i], "--update")) update = true;
+        else if(argv[i][0] == '-') {
+            std::fprintf(stderr, "usage: %s [--update] [directory]\n", argv[0]);
+            return 2;
+        } else directory = argv[i];
+    }
+
+    std::vector<std::filesystem::path> captures;
+    std::error_code error;
+    for(const auto& entry : std::filesystem::directory_iterator(directory, error))
+        if(entry.path().extension() == ".avlog") captures.push_back(entry.path());
+    std::sort(captures.begin(), captures.end());
+    if(captures.empty()) {
+        std::fprintf(stderr, "regression: no .avlog captures in '%s'\n", directory.c_str());
+        return 1;
+    }
+
+    if(!update)
+        std::printf("%-20s %8s  %-6s %-8s %10s %10s %9s  %s\n", "trace", "frames", "run", "column",
+                    "max err", "mean err", "at frame", "result");
+    auto started = std::chrono::steady_clock::now();
+    std::size_t totalFrames = 0;
+    int comparisons = 0, failures = 0;
+    for(const std::filesystem::path& path : captures) {
+        std::string name = path.stem().string();
+        std::filesystem::path goldenPath = path;
+        goldenPath.replace_extension(".golden");
+
+        TelemetryLogView capture;
+        if(!capture.open(path.string())) {
+            std::fprintf(stderr, "regression: cannot open capture '%s'\n", path.string().c_str());
+            ++failures;
+            continue;
+        }
+        std::size_t frames = capture.size();
+        totalFrames += frames;
+        VolumeTrace reference = runFloat(capture);
+
+        if(update) {
+            if(!writeGoldenTrace(goldenPath.string(), reference.target.data(), reference.current.data(), frames)) {
+                std::fprintf(stderr, "regression: cannot write '%s'\n", goldenPath.string().c_str());
+                ++failures;
+                continue;
+            }
+            std::printf("wrote %s (%zu frames)\n", goldenPath.string().c_str(), frames);
+            continue;
+        }
+
+        GoldenTraceView golden;
+        if(!golden.open(goldenPath.string()) || golden.size() != frames) {
+            std::fprintf(stderr, "regression: missing or mismatched golden '%s' (run with --update)\n",
+                         goldenPath.string().c_str());
+            ++failures;
+            continue;
+        }
+
+        std::vector<float> batch = runBatch(capture);
+        VolumeTrace fixed = runFixed(capture);
+        const float* target = golden.targetVolume();
+        const float* current = golden.currentVolume();
+        failures += !report(name, frames, "float", "target", target, reference.target.data(), 0.0f);
+        failures += !report(name, frames, "float", "current", current, reference.current.data(), 0.0f);
+        failures += !report(name, frames, "batch", "target", target, batch.data(), 0.0f);
+        failures += !report(name, frames, "fixed", "target", target, fixed.target.data(),
+                            FixedPointVolumeControl::FLOAT_TOLERANCE);
+        failures += !report(name, frames, "fixed", "current", current, fixed.current.data(), FIXED_CURRENT_TOLERANCE);
+        comparisons += 5;
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - started;
+
+    std::fprintf(stderr, "%zu captures, %zu frames, %d comparisons in %.1f ms: %s\n", captures.size(), totalFrames,
+                 comparisons, elapsed.count(), failures ? "FAILED" : "all ok");
+    return failures ? 1 : 0;
+}
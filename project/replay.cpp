@@ -0,0 +1,151 @@
+/**
+ * @file replay.cpp
+ * @brief Replays a memory-mapped telemetry capture through AdaptiveVolumeControl.
+ *
+ * Usage: replay <capture.avlog> [trace.csv]
+ *
+ * Frames are streamed straight from the mapping under a simulated clock, so
+ * replay runs as fast as the controller allows. The optional trace holds one
+ * "timestamp_ns,target_volume,current_volume" line per frame.
+ */
+
+#include "AdaptiveVolumeControl.h"
+#include "TelemetryLog.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+/**
+ * @class TraceWriter
+ * @brief Buffered CSV writer for the volume trace.
+ */
+class TraceWriter {
+public:
+    static constexpr std::size_t BUFFER_SIZE = 1 << 20; ///< Bytes buffered between writes
+
+    explicit TraceWriter(std::FILE* out) : out(out), buffer(BUFFER_SIZE) {}
+    ~TraceWriter() { flush(); }
+
+    /**
+     * @brief Appends one trace line.
+     * @param timestampNs Frame time.
+     * @param target Target volume after the frame.
+     * @param current Current volume after the frame.
+     */
+    void write(long long timestampNs, float target, float current) {
+        if(used + 64 > buffer.size()) flush();
+        char* p = buffer.data() + used;
+        p = appendInteger(p, timestampNs);
+        *p++ = ',';
+        p = appendFixed3(p, target);
+        *p++ = ',';
+        p = appendFixed3(p, current);
+        *p++ = '\n';
+        used = static_cast<std::size_t>(p - buffer.data());
+    }
+
+    /**
+     * @brief Writes the buffered lines out.
+     */
+    void flush() {
+        if(used) std::fwrite(buffer.data(), 1, used, out);
+        used = 0;
+    }
+
+private:
+    /**
+     * @brief Formats a signed integer (printf is the bottleneck of large replays).
+     * @return Position after the last character written.
+     */
+    static char* appendInteger(char* p, long long value) {
+        unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value)
+                                                 : static_cast<unsigned long long>(value);
+        if(value < 0) *p++ = '-';
+        char digits[20];
+        int n = 0;
+        do {
+            digits[n++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while(magnitude);
+        while(n) *p++ = digits[--n];
+        return p;
+    }
+
+    /**
+     * @brief Formats a value with three decimals, like "%.3f".
+     * @return Position after the last character written.
+     */
+    static char* appendFixed3(char* p, float value) {
+        long long thousandths = std::llround(static_cast<double>(value) * 1000.0);
+        if(thousandths < 0) {
+            *p++ = '-';
+            thousandths = -thousandths;
+        }
+        p = appendInteger(p, thousandths / 1000);
+        int fraction = static_cast<int>(thousandths % 1000);
+        *p++ = '.';
+        *p++ = static_cast<char>('0' + fraction / 100);
+        *p++ = static_cast<char>('0' + fraction / 10 % 10);
+        *p++ = static_cast<char>('0' + fraction % 10);
+        return p;
+    }
+
+    std::FILE* out;            ///< Output file
+    std::vector<char> buffer;  ///< Pending output
+    std::size_t used = 0;      ///< Bytes pending
+};
+
+} // namespace
+
+/**
+ * @brief Main entry point. Replays a capture and optionally writes the volume trace.
+ * @return Exit code.
+ */
+int main(int argc, char** argv) {
+    if(argc < 2 || argc > 3) {
+        std::fprintf(stderr, "usage: %s <capture.avlog> [trace.csv]\n", argv[0]);
+        return 2;
+    }
+
+    TelemetryLogView capture;
+    if(!capture.open(argv[1])) {
+        std::fprintf(stderr, "replay: cannot open capture '%s'\n", argv[1]);
+        return 1;
+    }
+
+    std::FILE* traceFile = nullptr;
+    if(argc == 3) {
+        traceFile = std::fopen(argv[2], "wb");
+        if(!traceFile) {
+            std::fprintf(stderr, "replay: cannot create trace '%s'\n", argv[2]);
+            return 1;
+        }
+    }
+
+    ManualClock clock;
+    AdaptiveVolumeControl avc(clock);
+    auto started = std::chrono::steady_clock::now();
+    {
+        TraceWriter trace(traceFile);
+        std::int64_t previousNs = capture.size() ? capture.begin()->timestampNs : 0;
+        for(const TelemetryRecord& record : capture) {
+            // Smooth over the gap since the previous frame, then apply the new inputs
+            avc.tick((record.timestampNs - previousNs) * 1e-9);
+            previousNs = record.timestampNs;
+            clock.set(Clock::time_point(std::chrono::nanoseconds(record.timestampNs)));
+            applyRecord(avc, record);
+            if(traceFile) trace.write(record.timestampNs, avc.getTargetVolume(), avc.getCurrentVolume());
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+    if(traceFile) std::fclose(traceFile);
+
+    double megabytes = capture.size() * sizeof(TelemetryRecord) / 1e6;
+    std::fprintf(stderr, "replayed %zu frames (%.1f MB) in %.3f s: %.1f Mframes/s, %.1f MB/s\n",
+                 capture.size(), megabytes, elapsed.count(),
+                 capture.size() / 1e6 / elapsed.count(), megabytes / elapsed.count());
+    return 0;
+}
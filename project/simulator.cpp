@@ -0,0 +1,262 @@
+/**
+ * @file simulator.cpp
+ * @brief Monte Carlo drive-scenario simulator for validating the adaptive volume policy.
+ *
+ * Usage: simulator [--scenarios N] [--threads N] [--seed N] [--duration S] [--rate HZ] [--threshold V]
+ *
+ * Every scenario is a randomized drive (speed profile, cabin noise, horn
+ * bursts, navigation prompts, reversing) run through its own
+ * AdaptiveVolumeControl under a simulated clock. Scenarios are spread over a
+ * WorkStealingPool; each worker accumulates into its own statistics and the
+ * results are merged at the end. A scenario's random stream depends only on
+ * the seed and its index, so the report is identical for any thread count.
+ */
+
+#include "AdaptiveVolumeControl.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+/**
+ * @struct SimulationConfig
+ * @brief Command-line parameters.
+ */
+struct SimulationConfig {
+    std::uint32_t scenarios = 10000;    ///< Number of drives
+    unsigned threads = 0;               ///< Workers (0 = hardware concurrency)
+    std::uint64_t seed = 1;             ///< Base seed
+    double duration = 600.0;            ///< Seconds per drive
+    double rate = 10.0;                 ///< Control frames per second
+    float threshold = 60.0f;            ///< Volume counted as "loud"
+};
+
+/**
+ * @struct SimulationStats
+ * @brief Integer counters, so merged results do not depend on the merge order.
+ */
+struct alignas(64) SimulationStats {
+    static constexpr int HISTOGRAM_BINS = 64; ///< Convergence histogram bins (one per frame, last bin open)
+
+    std::uint64_t scenarios = 0;            ///< Drives simulated
+    std::uint64_t frames = 0;               ///< Control frames simulated
+    std::uint64_t framesAboveThreshold = 0; ///< Frames with the current volume at or above the threshold
+    std::uint64_t duckEvents = 0;           ///< Rising edges of horn/navigation/reverse/brake modifiers
+    std::uint64_t clampFrames = 0;          ///< Adaptive frames with the target on MIN_VOLUME or MAX_ADAPTIVE_VOLUME
+    std::uint64_t adaptiveFrames = 0;       ///< Frames in adaptive mode
+    std::uint64_t convergences = 0;         ///< Target jumps that settled
+    std::uint64_t convergenceFrames = 0;    ///< Sum of frames to settle
+    std::uint64_t maxConvergenceFrames = 0; ///< Slowest settle
+    std::uint64_t histogram[HISTOGRAM_BINS] = {}; ///< Settle time distribution in frames
+
+    /**
+     * @brief Adds another worker's counters.
+     * @param other Counters to add.
+     */
+    void merge(const SimulationStats& other) {
+        scenarios += other.scenarios;
+        frames += other.frames;
+        framesAboveThreshold += other.framesAboveThreshold;
+        duckEvents += other.duckEvents;
+        clampFrames += other.clampFrames;
+        adaptiveFrames += other.adaptiveFrames;
+        convergences += other.convergences;
+        convergenceFrames += other.convergenceFrames;
+        maxConvergenceFrames = std::max(maxConvergenceFrames, other.maxConvergenceFrames);
+        for(int i = 0; i < HISTOGRAM_BINS; ++i) histogram[i] += other.histogram[i];
+    }
+
+    /**
+     * @brief Finds a percentile of the settle time.
+     * @param fraction Percentile as a fraction (0.5 = median).
+     * @return Frames (the last bin is reported as its lower bound).
+     */
+    int convergencePercentile(double fraction) const {
+        std::uint64_t rank = static_cast<std::uint64_t>(fraction * convergences), seen = 0;
+        for(int i = 0; i < HISTOGRAM_BINS; ++i) {
+            seen += histogram[i];
+            if(seen > rank) return i;
+        }
+        return HISTOGRAM_BINS - 1;
+    }
+};
+
+/**
+ * @brief Derives an independent seed per scenario (splitmix64).
+ * @param seed Base seed.
+ * @param index Scenario index.
+ * @return Scenario seed.
+ */
+std::uint64_t scenarioSeed(std::uint64_t seed, std::uint64_t index) {
+    std::uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (index + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Simulates one drive and accumulates its statistics.
+ * @param config Simulation parameters.
+ * @param index Scenario index.
+ * @param stats Worker-local counters.
+ */
+void runScenario(const SimulationConfig& config, std::uint32_t index, SimulationStats& stats) {
+    using AVC = AdaptiveVolumeControl;
+    std::mt19937_64 rng(scenarioSeed(config.seed, index));
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::normal_distribution<double> jitter(0.0, 1.0);
+
+    const double dt = 1.0 / config.rate;
+    const auto frameStep = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(dt));
+    const std::uint64_t frames = static_cast<std::uint64_t>(config.duration * config.rate);
+
+    ManualClock clock;
+    AdaptiveVolumeControl avc(clock);
+    ControlInputs in;
+    in.mode = static_cast<Mode>(rng() % 3);
+
+    double speed = 0.0, cruise = 0.0, accel = 2.0;  // km/h, km/h, km/h per second
+    double segmentLeft = 0.0, hornLeft = 0.0, navLeft = 0.0, reverseLeft = 0.0;
+    double roughRoad = 0.0;                          // extra noise of the current road surface
+    std::uint8_t previousModifiers = 0;
+    float previousTarget = avc.getTargetVolume();
+    std::uint64_t settling = 0;                      // frames since the last target jump (0 = settled)
+
+    for(std::uint64_t frame = 0; frame < frames; ++frame) {
+        // Speed profile: cruise segments with random targets, stops, and occasional hard braking
+        if((segmentLeft -= dt) <= 0.0) {
+            segmentLeft = 5.0 + uniform(rng) * 40.0;
+            double pick = uniform(rng);
+            cruise = pick < 0.15 ? 0.0 : pick < 0.5 ? 20.0 + uniform(rng) * 40.0 : 60.0 + uniform(rng) * 80.0;
+            accel = uniform(rng) < 0.1 ? 30.0 : 3.0 + uniform(rng) * 8.0; // hard brake / launch
+            roughRoad = uniform(rng) < 0.2 ? 5.0 + uniform(rng) * 15.0 : 0.0;
+            if(cruise == 0.0 && uniform(rng) < 0.3) reverseLeft = 3.0 + uniform(rng) * 10.0;
+        }
+        bool reversing = reverseLeft > 0.0 && speed < 1.0;
+        double goal = reversing ? 5.0 : cruise;
+        double change = std::min(std::abs(goal - speed), accel * dt);
+        speed += goal > speed ? change : -change;
+        if(reversing) reverseLeft -= dt;
+        else if(reverseLeft > 0.0 && speed >= 1.0) reverseLeft = 0.0;
+
+        // Horn bursts and navigation prompts as Poisson events
+        if(hornLeft <= 0.0 && uniform(rng) < 0.02 * dt) hornLeft = 0.2 + uniform(rng) * 0.8;
+        if(navLeft <= 0.0 && uniform(rng) < 0.01 * dt) navLeft = 2.0 + uniform(rng) * 4.0;
+
+        in.speed = static_cast<int>(speed + 0.5);
+        in.cabinNoise = std::max(20, std::min(120, static_cast<int>(30.0 + speed * 0.45 + roughRoad + 3.0 * jitter(rng))));
+        in.reverseGear = reversing;
+        in.hornActive = hornLeft > 0.0;
+        in.navSpeaking = navLeft > 0.0;
+        hornLeft -= dt;
+        navLeft -= dt;
+
+        clock.advance(frameStep);
+        avc.update(in);
+        avc.tick(dt);
+
+        // Statistics
+        float target = avc.getTargetVolume();
+        std::uint8_t modifiers = avc.getActiveModifiers();
+        constexpr std::uint8_t DUCKS = MODIFIER_HORN_DUCK | MODIFIER_NAVIGATION | MODIFIER_REVERSE | MODIFIER_SUDDEN_BRAKE;
+        for(std::uint8_t rising = modifiers & ~previousModifiers & DUCKS; rising; rising &= rising - 1) ++stats.duckEvents;
+        previousModifiers = modifiers;
+
+        if(avc.getCurrentVolume() >= config.threshold) ++stats.framesAboveThreshold;
+        if(avc.getControlType() == VolumeControlType::ADAPTIVE) {
+            ++stats.adaptiveFrames;
+            if(target == AVC::MIN_VOLUME || target == AVC::MAX_ADAPTIVE_VOLUME) ++stats.clampFrames;
+        }
+
+        if(std::abs(target - previousTarget) > AVC::SETTLE_THRESHOLD) settling = 1;
+        else if(settling) ++settling;
+        previousTarget = target;
+        if(settling && avc.isSettled()) {
+            std::uint64_t took = settling;
+            ++stats.convergences;
+            stats.convergenceFrames += took;
+            stats.maxConvergenceFrames = std::max(stats.maxConvergenceFrames, took);
+            ++stats.histogram[std::min<std::uint64_t>(took, SimulationStats::HISTOGRAM_BINS - 1)];
+            settling = 0;
+        }
+    }
+
+    ++stats.scenarios;
+    stats.frames += frames;
+}
+
+/**
+ * @brief Parses the command line.
+ * @param argc Argument count.
+ * @param argv Arguments.
+ * @param config Receives the parameters.
+ * @return False on a malformed command line.
+ */
+bool parseArguments(int argc, char** argv, SimulationConfig& config) {
+    for(int i = 1; i < argc; ++i) {
+        if(i + 1 >= argc) return false;
+        const char* name = argv[i];
+        const char* value = argv[++i];
+        char* end = nullptr;
+        if(!std::strcmp(name, "--scenarios")) config.scenarios = static_cast<std::uint32_t>(std::strtoul(value, &end, 10));
+        else if(!std::strcmp(name, "--threads")) config.threads = static_cast<unsigned>(std::strtoul(value, &end, 10));
+        else if(!std::strcmp(name, "--seed")) config.seed = std::strtoull(value, &end, 10);
+        else if(!std::strcmp(name, "--duration")) config.duration = std::strtod(value, &end);
+        else if(!std::strcmp(name, "--rate")) config.rate = std::strtod(value, &end);
+        else if(!std::strcmp(name, "--threshold")) config.threshold = std::strtof(value, &end);
+        else return false;
+        if(!end || *end) return false;
+    }
+    return config.duration > 0.0 && config.rate > 0.0;
+}
+
+} // namespace
+
+/**
+ * @brief Main entry point. Runs the scenarios and prints the aggregated statistics.
+ * @return Exit code.
+ */
+int main(int argc, char** argv) {
+    SimulationConfig config;
+    if(!parseArguments(argc, argv, config)) {
+        std::fprintf(stderr, "usage: %s [--scenarios N] [--threads N] [--seed N] [--duration S] [--rate HZ] [--threshold V]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    WorkStealingPool pool(config.threads);
+    std::vector<SimulationStats> perWorker(pool.size());
+
+    auto started = std::chrono::steady_clock::now();
+    pool.parallelFor(config.scenarios, 4, [&](unsigned worker, std::uint32_t index) {
+        runScenario(config, index, perWorker[worker]);
+    });
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+
+    SimulationStats total;
+    for(const SimulationStats& stats : perWorker) total.merge(stats);
+
+    double frameMs = 1000.0 / config.rate;
+    double simulatedHours = total.frames / config.rate / 3600.0;
+    std::printf("scenarios:            %llu (%.0f s each, %.0f Hz) on %u threads\n",
+                static_cast<unsigned long long>(total.scenarios), config.duration, config.rate, pool.size());
+    std::printf("simulated:            %.1f h in %.2f s (%.0fx real time, %.1f Mframes/s)\n",
+                simulatedHours, elapsed.count(), simulatedHours * 3600.0 / elapsed.count(),
+                total.frames / 1e6 / elapsed.count());
+    std::printf("time above threshold: %.3f %% (volume >= %.0f)\n",
+                100.0 * total.framesAboveThreshold / std::max<std::uint64_t>(1, total.frames), config.threshold);
+    std::printf("duck events:          %.2f per hour\n", total.duckEvents / std::max(1e-9, simulatedHours));
+    std::printf("clamp rate:           %.3f %% of adaptive frames\n",
+                100.0 * total.clampFrames / std::max<std::uint64_t>(1, total.adaptiveFrames));
+    std::printf("convergence:          mean %.0f ms, p50 %.0f ms, p95 %.0f ms, max %.0f ms (%llu jumps)\n",
+                frameMs * total.convergenceFrames / std::max<std::uint64_t>(1, total.convergences),
+                frameMs * total.convergencePercentile(0.5), frameMs * total.convergencePercentile(0.95),
+                frameMs * total.maxConvergenceFrames, static_cast<unsigned long long>(total.convergences));
+    return 0;
+}
@@ -8,11 +8,174 @@
  */
 
 #include "AdaptiveVolumeControl.h"
+#include "VolumeEventSink.h"
+#include "GainRamp.h"
+#include "VolumeBatch.h"
+#include "TelemetryLog.h"
+#include "ZoneController.h"
+#include "InputMailbox.h"
+#include "NoiseEstimator.h"
+#include "VolumeLut.h"
+#include "Instrumentation.h"
+#include "PolicyEngine.h"
+#include "Checksum.h"
+#include "DuckingArbiter.h"
+#include "FixedPointVolumeControl.h"
+#include "WorkStealingPool.h"
+#include "VolumeSmoother.h"
+#include "VolumeState.h"
+#include "SpeedTrend.h"
+#include "SharedVolumeState.h"
+#include "AsyncDriver.h"
+#include "EventRegistry.h"
+#include "FormatBuffer.h"
+#include "GoldenTrace.h"
+#include "MultibandGain.h"
+#include "BasicVolumeControl.h"
+#include "AmplifierOutputStage.h"
+#include "VehicleFleet.h"
+#include "ConsoleVolumeSink.h"
 #include <cassert>
 #include <cmath>
 #include <iostream>
-#include <thread>
 #include <chrono>
+#include <vector>
+#include <random>
+#include <memory>
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <limits>
+#include <cstring>
+#include <stdexcept>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <streambuf>
+#include <type_traits>
+
+std::atomic<long> heapAllocations{0}; ///< Calls to the global operator new
+
+#if defined(__GNUC__)
+#define TEST_NOINLINE __attribute__((noinline)) // keeps GCC from flagging the inlined free() as a new/free mismatch
+#else
+#define TEST_NOINLINE
+#endif
+
+/**
+ * @brief Global allocation hook counting heap allocations (Test 46).
+ * @param size Bytes requested.
+ * @return Allocated memory.
+ */
+void* operator new(std::size_t size) {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if(void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+TEST_NOINLINE void operator delete(void* memory) noexcept { std::free(memory); }
+TEST_NOINLINE void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+/**
+ * @class FixedStreamBuffer
+ * @brief Stream buffer writing into a fixed array, so capturing output does not allocate.
+ */
+class FixedStreamBuffer : public std::streambuf {
+public:
+    FixedStreamBuffer() { setp(text, text + sizeof(text)); }
+
+    std::string_view view() const { return std::string_view(pbase(), static_cast<std::size_t>(pptr() - pbase())); } ///< @return Captured text
+    void clear() { setp(text, text + sizeof(text)); } ///< Discards the captured text
+
+protected:
+    int_type overflow(int_type ch) override { return traits_type::not_eof(ch); } ///< Drops output once full, keeping the stream good
+
+private:
+    char text[16384]; ///< Captured text (excess is dropped)
+};
+
+/**
+ * @class CountingClock
+ * @brief Manual clock that counts how often it is read.
+ */
+class CountingClock : public ManualClock {
+public:
+    mutable int reads = 0; ///< Number of now() calls
+
+    time_point now() const override { ++reads; return ManualClock::now(); }
+};
+
+/**
+ * @struct RecordingSink
+ * @brief Test sink that records the notifications it receives.
+ */
+struct RecordingSink : VolumeEventSink {
+    int hornChanges = 0;            ///< Number of horn press/release notifications
+    std::uint8_t lastModifiers = 0; ///< Last reported modifier bits
+    int steps = 0;                  ///< Number of smoothing steps reported
+
+    void onHornChanged(bool) override { ++hornChanges; }
+    void onModifiersApplied(std::uint8_t modifiers) override { lastModifiers = modifiers; }
+    void onVolumeStep(float) override { ++steps; }
+};
+
+#if defined(__cpp_impl_coroutine)
+/**
+ * @brief Test coroutine: sleeps and records the time it woke up.
+ * @param executor Executor.
+ * @param delay Sleep time.
+ * @param woke Receives the wake-up time.
+ * @return Task.
+ */
+Task sleepAndRecord(AsyncExecutor& executor, Clock::duration delay, Clock::time_point& woke) {
+    co_await executor.sleepFor(delay);
+    woke = executor.getClock().now();
+}
+
+/**
+ * @brief Test coroutine: throws after one yield.
+ * @param executor Executor.
+ * @return Task.
+ */
+Task failAfterYield(AsyncExecutor& executor) {
+    co_await executor.yield();
+    throw std::runtime_error("bench failure");
+}
+
+/**
+ * @brief Test coroutine: awaits a failing task and records the exception.
+ * @param executor Executor.
+ * @param caught Set when the nested exception arrives.
+ * @return Task.
+ */
+Task catchNested(AsyncExecutor& executor, bool& caught) {
+    try {
+        co_await failAfterYield(executor);
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+}
+
+/**
+ * @brief Test coroutine: horn press and release, then waits out the duck hold.
+ * @param executor Executor.
+ * @param avc Controller on the executor's clock.
+ * @param released Receives the time the horn was released.
+ * @return Task.
+ */
+Task hornScript(AsyncExecutor& executor, AdaptiveVolumeControl& avc, Clock::time_point& released) {
+    ControlInputs in;
+    in.speed = 50;
+    in.cabinNoise = 55;
+    co_await runEvent(executor, avc, in, "Cruise");
+    in.hornActive = true;
+    co_await runEvent(executor, avc, in, "Horn Pressed");
+    in.hornActive = false;
+    released = executor.getClock().now();
+    co_await runEvent(executor, avc, in, "Horn Released");
+    co_await awaitDuckHold(executor, avc);
+}
+#endif
 
 /**
  * @brief Main function executing all unit tests for AdaptiveVolumeControl.
@@ -24,7 +187,8 @@
  * @return int Exit code (0 if all tests pass).
  */
 int main() {
-    AdaptiveVolumeControl avc;
+    ManualClock clock;
+    AdaptiveVolumeControl avc(clock);
 
     // --- Test 1: Initial values ---
     assert(avc.getCurrentVolume() == 25);
@@ -72,7 +236,7 @@ int main() {
     std::cout << "[Test 8] Horn Ducking Passed\n";
 
     // --- Test 9: Horn duration expired ---
-    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    clock.advance(std::chrono::milliseconds(600));
     avc.update(50, 50, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
     float hornNormal = 25 + 10 + 50*0.2f; // 45
     assert(std::abs(avc.getTargetVolume() - hornNormal) <= 1);
@@ -147,7 +311,7 @@ int main() {
 
     // --- Test 21: Adaptive volume cannot exceed 80 ---
     // Ensure horn is released and ducking timer starts
-    std::this_thread::sleep_for(std::chrono::milliseconds(600)); // Ensure horn ducking expired
+    clock.advance(std::chrono::milliseconds(600)); // Ensure horn ducking expired
     avc.update(150, 100, false, false, false, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0);
     float maxExpected = (25 + 15 + 100*0.2f) * 1.2f;
     if(maxExpected > 80) maxExpected = 80;
@@ -162,6 +326,1625 @@ int main() {
     assert(std::abs(avc.getTargetVolume() - minExpected2) <= 1);
     std::cout << "[Test 22] Adaptive Min Limit Passed\n";
 
-    std::cout << "\nAll 22 tests passed successfully!\n";
+    // --- Test 23: Horn hold timing under simulated clock ---
+    avc.update(50, 50, false, true, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+    clock.advance(std::chrono::milliseconds(499));
+    avc.update(50, 50, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+    assert(std::abs(avc.getTargetVolume() - hornExpected) <= 1); // still within HORN_DUCK_DURATION
+    clock.advance(std::chrono::milliseconds(1));
+    avc.update(50, 50, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+    assert(std::abs(avc.getTargetVolume() - hornNormal) <= 1);
+    std::cout << "[Test 23] Horn Hold Simulated Clock Passed\n";
+
+    // --- Test 24: Event sink notifications ---
+    RecordingSink recorder;
+    avc.setEventSink(&recorder);
+    avc.update(50, 50, false, true, true, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+    avc.update(40, 50, false, false, true, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+#ifndef ADAPTIVE_VOLUME_RT
+    assert(recorder.hornChanges == 2);
+    assert(recorder.lastModifiers == (MODIFIER_HORN_DUCK | MODIFIER_NAVIGATION | MODIFIER_SPEED_DECREASE));
+    assert(avc.getActiveModifiers() == recorder.lastModifiers);
+#else
+    // Real-time builds ignore the sink and compile the notifications out
+    assert(avc.getEventSink() == nullptr);
+    assert(recorder.hornChanges == 0 && recorder.lastModifiers == 0 && recorder.steps == 0);
+    assert(avc.getActiveModifiers() == (MODIFIER_HORN_DUCK | MODIFIER_NAVIGATION | MODIFIER_SPEED_DECREASE));
+#endif
+    avc.setEventSink(nullptr);
+    std::cout << "[Test 24] Event Sink Passed\n";
+
+    // --- Test 25: Tick-driven smoothing is frame-rate independent ---
+    AdaptiveVolumeControl coarse(clock), fine(clock), sampled(clock);
+    for (AdaptiveVolumeControl* c : {&coarse, &fine, &sampled})
+        c->update(50, 50, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+    coarse.tick(AdaptiveVolumeControl::SMOOTH_INTERVAL);
+    for (int i = 0; i < 4; ++i) fine.tick(AdaptiveVolumeControl::SMOOTH_INTERVAL / 4);
+    sampled.advance(9600); // 0.2 s at 48 kHz
+    float oneStep = 25 + (45 - 25) * AdaptiveVolumeControl::SMOOTH_FACTOR; // 31
+    assert(std::abs(coarse.getCurrentVolume() - oneStep) < 1e-3f);
+    assert(std::abs(fine.getCurrentVolume() - oneStep) < 1e-3f);
+    assert(std::abs(sampled.getCurrentVolume() - oneStep) < 1e-3f);
+    assert(!coarse.isSettled());
+    coarse.tick(-AdaptiveVolumeControl::SMOOTH_INTERVAL); // a negative dt must not push the volume away
+    coarse.tick(0.0);
+    assert(std::abs(coarse.getCurrentVolume() - oneStep) < 1e-3f);
+    for (int i = 0; i < 20 && !coarse.isSettled(); ++i) coarse.tick(AdaptiveVolumeControl::SMOOTH_INTERVAL);
+    assert(coarse.isSettled() && coarse.getCurrentVolume() == coarse.getTargetVolume());
+    std::cout << "[Test 25] Tick Smoothing Passed\n";
+
+    // --- Test 26: SIMD gain ramp matches scalar reference ---
+    for (int channels = 1; channels <= 8; ++channels) {
+        const std::size_t frames = 67; // not a multiple of any vector width
+        std::vector<float> simd(frames * channels), scalar(frames * channels);
+        for (std::size_t i = 0; i < simd.size(); ++i) simd[i] = scalar[i] = std::sin(0.1f * i);
+        applyGainRamp(simd.data(), frames, channels, 0.2f, 0.7f);
+        applyGainRampScalar(scalar.data(), frames, channels, 0.2f, 0.7f);
+        assert(simd == scalar);
+        std::vector<float> ones(frames * channels, 1.0f);
+        applyGainRamp(ones.data(), frames, channels, 0.2f, 0.7f);
+        for (int ch = 0; ch < channels; ++ch) assert(ones[(frames - 1) * channels + ch] == 0.7f); // exactly endGain
+    }
+    std::cout << "[Test 26] Gain Ramp (" << gainRampImplementation() << ") Passed\n";
+
+    // --- Test 27: processBlock ramps to the smoothed volume ---
+    AdaptiveVolumeControl block(clock);
+    block.update(50, 50, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+    std::vector<float> pcm(480 * 2, 1.0f);
+    block.processBlock(pcm.data(), 480, 2);
+    assert(std::abs(pcm[1] - 0.25f) < 1e-3f); // starts at previous volume 25
+    assert(pcm[pcm.size() - 1] == block.getCurrentVolume() / AdaptiveVolumeControl::MAX_VOLUME);
+    assert(pcm[pcm.size() - 2] == pcm[pcm.size() - 1]);
+    std::cout << "[Test 27] Process Block Passed\n";
+
+    // --- Test 28: Batch evaluation matches frame-by-frame update() ---
+    {
+        const std::size_t n = 5000;
+        std::mt19937 rng(28);
+        std::vector<std::int64_t> ts(n);
+        std::vector<int> speed(n), noise(n), manual(n);
+        std::unique_ptr<bool[]> reverse(new bool[n]), horn(new bool[n]), nav(new bool[n]);
+        std::vector<Mode> mode(n);
+        std::vector<VolumeControlType> type(n);
+        std::int64_t t = 0;
+        int v = 40;
+        for (std::size_t i = 0; i < n; ++i) {
+            t += std::uniform_int_distribution<std::int64_t>(0, 300000000)(rng);
+            v = std::max(-20, std::min(200, v + std::uniform_int_distribution<int>(-25, 15)(rng)));
+            ts[i] = t;
+            speed[i] = v;
+            noise[i] = std::uniform_int_distribution<int>(-50, 300)(rng);
+            reverse[i] = rng() % 10 == 0;
+            horn[i] = rng() % 6 == 0;
+            nav[i] = rng() % 4 == 0;
+            mode[i] = static_cast<Mode>(rng() % 3);
+            type[i] = rng() % 8 == 0 ? VolumeControlType::MANUAL : VolumeControlType::ADAPTIVE;
+            manual[i] = std::uniform_int_distribution<int>(-50, 150)(rng);
+        }
+        TelemetryColumns columns{ts.data(), speed.data(), noise.data(), reverse.get(), horn.get(), nav.get(),
+                                 mode.data(), type.data(), manual.data()};
+        std::vector<float> batch(n);
+        BatchState state;
+        calculateTargetVolumeBatch(columns, 1234, batch.data(), state); // split to exercise carried state
+        TelemetryColumns rest{ts.data() + 1234, speed.data() + 1234, noise.data() + 1234, reverse.get() + 1234,
+                              horn.get() + 1234, nav.get() + 1234, mode.data() + 1234, type.data() + 1234,
+                              manual.data() + 1234};
+        calculateTargetVolumeBatch(rest, n - 1234, batch.data() + 1234, state);
+
+        ManualClock replayClock;
+        AdaptiveVolumeControl reference(replayClock);
+        for (std::size_t i = 0; i < n; ++i) {
+            replayClock.set(Clock::time_point(std::chrono::nanoseconds(ts[i])));
+            reference.update(speed[i], noise[i], reverse[i], horn[i], nav[i], mode[i], type[i], manual[i]);
+            assert(batch[i] == reference.getTargetVolume());
+        }
+    }
+    std::cout << "[Test 28] Batch Evaluation Passed\n";
+
+    // --- Test 29: Telemetry capture round trip through the memory map ---
+    {
+        const char* path = "test_capture.avlog";
+        TelemetryLogWriter writer;
+        assert(writer.open(path));
+        for (int i = 0; i < 100; ++i) {
+            TelemetryRecord r{};
+            r.timestampNs = i * 10000000LL;
+            r.speed = i;
+            r.noise = 40;
+            r.hornActive = i % 10 == 0;
+            r.mode = static_cast<std::uint8_t>(Mode::SPORTS);
+            writer.write(r);
+        }
+        assert(writer.close());
+
+        {
+            TelemetryLogView view;
+            assert(view.open(path));
+            assert(view.size() == 100);
+            assert(view.begin()[42].speed == 42 && view.begin()[40].hornActive == 1);
+            AdaptiveVolumeControl replayed(clock);
+            applyRecord(replayed, view.begin()[99]);
+            assert(replayed.getMode() == Mode::SPORTS && replayed.getSpeed() == 99);
+        }
+        std::remove(path);
+
+        TelemetryLogView missing;
+        assert(!missing.open(path));
+    }
+    std::cout << "[Test 29] Telemetry Capture Passed\n";
+
+    // --- Test 30: Zone controller matches one controller per zone ---
+    {
+        ManualClock zoneClock;
+        const std::size_t zoneCount = 6;
+        ZoneController zones(zoneCount, zoneClock);
+        std::vector<AdaptiveVolumeControl> reference(zoneCount, AdaptiveVolumeControl(zoneClock));
+        std::mt19937 rng(30);
+        int v = 50;
+        for (int step = 0; step < 2000; ++step) {
+            zoneClock.advance(std::chrono::milliseconds(rng() % 250));
+            v = std::max(0, std::min(180, v + std::uniform_int_distribution<int>(-20, 12)(rng)));
+            bool reverseGear = rng() % 12 == 0, hornActive = rng() % 7 == 0;
+            Mode m = static_cast<Mode>(rng() % 3);
+            for (std::size_t z = 0; z < zoneCount; ++z) {
+                int zoneNoise = std::uniform_int_distribution<int>(0, 120)(rng);
+                bool zoneNav = z < 2 && rng() % 3 == 0;
+                VolumeControlType zoneType = rng() % 10 == 0 ? VolumeControlType::MANUAL : VolumeControlType::ADAPTIVE;
+                int zoneManual = rng() % 120;
+                zones.setZoneNoise(z, zoneNoise);
+                zones.setZoneNavSpeaking(z, zoneNav);
+                zones.setZoneControl(z, zoneType, zoneManual);
+                reference[z].update(v, zoneNoise, reverseGear, hornActive, zoneNav, m, zoneType, zoneManual);
+            }
+            zones.update(v, reverseGear, hornActive, m);
+            double dt = (rng() % 5 + 1) * 0.02;
+            zones.tick(dt);
+            for (std::size_t z = 0; z < zoneCount; ++z) {
+                reference[z].tick(dt);
+                assert(zones.getTargetVolume(z) == reference[z].getTargetVolume());
+                assert(zones.getCurrentVolume(z) == reference[z].getCurrentVolume());
+            }
+        }
+    }
+    std::cout << "[Test 30] Zone Controller Passed\n";
+
+    // --- Test 31: Mailbox snapshots stay consistent under concurrent publishers ---
+    {
+        InputMailbox mailbox;
+        const int publications = 100000;
+        std::atomic<bool> done{false};
+        std::thread can([&] {
+            for (int i = 1; i <= publications; ++i) mailbox.publishVehicle(i, i % 2 == 1, i % 3 == 0);
+        });
+        std::thread hmi([&] {
+            for (int i = 1; i <= publications; ++i)
+                mailbox.publishSettings(static_cast<Mode>(i % 3),
+                                        i % 2 ? VolumeControlType::MANUAL : VolumeControlType::ADAPTIVE, i);
+            done = true;
+        });
+        AdaptiveVolumeControl consumer(clock);
+        int lastSpeed = 0;
+        while (!done) {
+            ControlInputs in = mailbox.snapshot();
+            assert(in.speed >= lastSpeed); // latest value only moves forward
+            lastSpeed = in.speed;
+            assert(in.reverseGear == (in.speed % 2 == 1)); // one CAN frame, never torn
+            assert(in.hornActive == (in.speed > 0 && in.speed % 3 == 0));
+            if (in.manualVolume != 25) { // settings come as a matching set
+                assert(static_cast<int>(in.mode) == in.manualVolume % 3);
+                assert((in.controlType == VolumeControlType::MANUAL) == (in.manualVolume % 2 == 1));
+            }
+            consumer.update(in);
+        }
+        can.join();
+        hmi.join();
+        ControlInputs last = mailbox.snapshot();
+        assert(last.speed == publications && last.manualVolume == publications);
+        assert(mailbox.getVersion() == 2u * publications);
+        mailbox.publishHorn(false); // single signals keep the rest of their frame
+        mailbox.publishSpeed(7);
+        last = mailbox.snapshot();
+        assert(last.speed == 7 && !last.hornActive && last.reverseGear == (publications % 2 == 1));
+        assert(mailbox.getVersion() == 2u * publications + 2);
+    }
+    std::cout << "[Test 31] Input Mailbox Passed\n";
+
+    // --- Test 32: Noise estimator levels and A-weighting ---
+    {
+        auto measure = [](float hz, float amplitude, bool weighted) {
+            NoiseEstimatorConfig config;
+            config.aWeighting = weighted;
+            NoiseEstimator estimator(config);
+            std::vector<float> block(64);
+            std::size_t t = 0;
+            for (int b = 0; b < 48000 / 64; ++b) { // one second in small blocks
+                for (float& x : block) x = amplitude * std::sin(2.0f * 3.14159265f * hz * (t++) / 48000.0f);
+                estimator.process(block.data(), block.size());
+            }
+            return estimator;
+        };
+        float expectedDb = 20.0f * std::log10(0.01f / std::sqrt(2.0f)) + 120.0f; // ~77 dB
+        NoiseEstimator flat = measure(1000.0f, 0.01f, false);
+        assert(flat.hasEstimate() && std::abs(flat.getNoiseDb() - expectedDb) < 0.5f);
+        NoiseEstimator weighted1k = measure(1000.0f, 0.01f, true);
+        assert(std::abs(weighted1k.getNoiseDb() - expectedDb) < 0.5f); // A(1 kHz) = 0 dB
+        NoiseEstimator weighted50 = measure(50.0f, 0.01f, true);
+        assert(std::abs(weighted50.getNoiseDb() - (expectedDb - 30.2f)) < 1.5f); // A(50 Hz) = -30.2 dB
+        assert(weighted1k.getNoiseLevel() == static_cast<int>(std::lround(weighted1k.getNoiseDb())));
+    }
+    std::cout << "[Test 32] Noise Estimator Passed\n";
+
+    // --- Test 33: Lookup tables match the float policy bit for bit ---
+    {
+        using AVC = AdaptiveVolumeControl;
+        const int speeds[] = {0, 20, 50, 100};
+        const Mode modes[] = {Mode::ECO, Mode::COMFORT, Mode::SPORTS};
+        for (int sp : speeds)
+            for (Mode m : modes)
+                for (int n = 0; n < VolumeLutTables::NOISE_LEVELS; ++n)
+                    for (int mask = 0; mask < VolumeLutTables::MODIFIER_MASKS; ++mask) {
+                        if ((mask & MODIFIER_SUDDEN_BRAKE) && (mask & MODIFIER_SPEED_DECREASE)) continue;
+                        if ((mask & MODIFIER_REVERSE) && (mask & (MODIFIER_SUDDEN_BRAKE | MODIFIER_SPEED_DECREASE))) continue;
+                        float ref = AVC::BASE_VOLUME;
+                        ref += sp > 70 ? 15 : sp > 30 ? 10 : sp > 0 ? 5 : 0;
+                        ref += n * AVC::NOISE_SLOPE;
+                        if (m == Mode::ECO) ref *= AVC::ECO_MULTIPLIER;
+                        if (m == Mode::SPORTS) ref *= AVC::SPORTS_MULTIPLIER;
+                        if (mask & MODIFIER_HORN_DUCK) ref *= AVC::HORN_DUCK_MULTIPLIER;
+                        if (mask & MODIFIER_NAVIGATION) ref *= AVC::NAV_DUCK_MULTIPLIER;
+                        if (mask & MODIFIER_REVERSE) ref *= AVC::REVERSE_MULTIPLIER;
+                        if (mask & MODIFIER_SUDDEN_BRAKE) ref *= AVC::SUDDEN_BRAKE_MULTIPLIER;
+                        if (mask & MODIFIER_SPEED_DECREASE) ref *= AVC::SPEED_DECREASE_MULTIPLIER;
+                        ref = std::min(std::max(ref, AVC::MIN_VOLUME), AVC::MAX_ADAPTIVE_VOLUME);
+                        assert(lookupTargetVolume(sp, n, m, static_cast<std::uint8_t>(mask)) == ref);
+                    }
+        assert(volumeLutCovers(0) && !volumeLutCovers(-1) && !volumeLutCovers(VolumeLutTables::NOISE_LEVELS));
+        assert(lookupTargetVolume(50, 60, static_cast<Mode>(7), 0) == lookupTargetVolume(50, 60, Mode::COMFORT, 0));
+        assert(lookupTargetVolume(50, 60, static_cast<Mode>(-1), 0) == lookupTargetVolume(50, 60, Mode::COMFORT, 0));
+    }
+    std::cout << "[Test 33] Lookup Tables Passed\n";
+
+    // --- Test 34: Trace ring and instrumentation counters ---
+    {
+        TraceRing<4> ring;
+        TraceRecord record{};
+        assert(!ring.pop(record));
+        for (int i = 0; i < 5; ++i) ring.push(TraceRecord{std::uint64_t(i), 0.0f, 0.0f, 0, TraceKind::TICK});
+        assert(ring.getDropped() == 1);
+        for (std::uint64_t i = 0; i < 4; ++i) assert(ring.pop(record) && record.cycles == i);
+        assert(!ring.pop(record));
+
+        // A diagnostics thread drains while the producer pushes; order and count are preserved
+        auto big = std::make_unique<TraceRing<VolumeInstrumentation::TRACE_CAPACITY>>();
+        const std::uint64_t total = 100000;
+        std::thread consumer([&] {
+            TraceRecord r{};
+            for (std::uint64_t expected = 0; expected < total;)
+                if (big->pop(r)) { assert(r.cycles == expected); ++expected; }
+        });
+        for (std::uint64_t i = 0; i < total;)
+            if (big->push(TraceRecord{i, 0.0f, 0.0f, 0, TraceKind::UPDATE})) ++i;
+        consumer.join();
+
+        std::uint64_t c0 = readCycleCounter();
+        assert(readCycleCounter() >= c0);
+
+#ifdef ADAPTIVE_VOLUME_INSTRUMENTATION
+        ManualClock instrClock;
+        auto instrumented = std::make_unique<AdaptiveVolumeControl>(instrClock);
+        instrumented->update(100, 150, false, false, false, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0); // clamps high
+        instrumented->update(80, 30, false, true, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);   // horn + brake
+        instrumented->update(80, 30, false, true, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);   // still ducking
+        instrumented->tick(0.2);
+        const VolumeCounters& counters = instrumented->getInstrumentation().counters;
+        assert(counters.updates == 3);
+        assert(counters.hornDuckActivations == 1);
+        assert(counters.suddenBrakes == 1);
+        assert(counters.clampMax == 1 && counters.clampMin == 0);
+
+        TraceRecord r{};
+        auto& trace = instrumented->getInstrumentation().trace;
+        assert(trace.pop(r) && r.kind == TraceKind::UPDATE && r.targetVolume == AdaptiveVolumeControl::MAX_ADAPTIVE_VOLUME);
+        assert(trace.pop(r) && r.kind == TraceKind::UPDATE &&
+               r.modifiers == (MODIFIER_HORN_DUCK | MODIFIER_SUDDEN_BRAKE));
+        assert(trace.pop(r) && r.kind == TraceKind::UPDATE);
+        assert(trace.pop(r) && r.kind == TraceKind::TICK && r.currentVolume == instrumented->getCurrentVolume());
+        assert(!trace.pop(r));
+#endif
+    }
+    std::cout << "[Test 34] Instrumentation Passed\n";
+
+    // --- Test 35: Unchanged frames take the fast path ---
+    {
+        CountingClock counting;
+        RecordingSink fastSink;
+        AdaptiveVolumeControl fast(counting);
+        fast.setEventSink(&fastSink);
+        fast.update(60, 50, false, false, true, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0);
+        fast.update(60, 50, false, false, true, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0); // speed settles
+        float cached = fast.getTargetVolume();
+        int reads = counting.reads;
+        int steps = fastSink.steps;
+        for (int i = 0; i < 100; ++i)
+            fast.update(60, 50, false, false, true, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0);
+        assert(counting.reads == reads && fastSink.steps == steps);
+        assert(fast.getTargetVolume() == cached && fast.getActiveModifiers() == MODIFIER_NAVIGATION);
+
+        // Any changed input still recomputes
+        fast.update(60, 51, false, false, true, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0);
+        assert(fast.getTargetVolume() > cached);
+
+        // A held horn keeps restarting the hold; the hold then runs out against the clock
+        fast.setEventSink(nullptr);
+        for (int i = 0; i < 30; ++i) {
+            fast.update(60, 51, false, true, true, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0);
+            counting.advance(std::chrono::milliseconds(10));
+        }
+        counting.advance(std::chrono::milliseconds(-10)); // last held frame at 290 ms
+        for (int i = 0; i < 50; ++i) {
+            counting.advance(std::chrono::milliseconds(10));
+            fast.update(60, 51, false, false, true, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0);
+            assert((fast.getActiveModifiers() & MODIFIER_HORN_DUCK) == (i < 49 ? MODIFIER_HORN_DUCK : 0));
+        }
+    }
+    std::cout << "[Test 35] Unchanged Input Fast Path Passed\n";
+
+    // --- Test 36: Per-signal setters match full updates ---
+    {
+        ManualClock setterClock;
+        AdaptiveVolumeControl full(setterClock), incremental(setterClock);
+        std::mt19937 rng(14);
+        ControlInputs in;
+        for (int frame = 0; frame < 5000; ++frame) {
+            ControlInputs prev = in;
+            switch (rng() % 8) { // change one signal (or none) per frame
+                case 0: in.speed = std::max(0, in.speed + int(rng() % 31) - 15); break;
+                case 1: in.cabinNoise = 20 + int(rng() % 90); break;
+                case 2: in.reverseGear = !in.reverseGear; break;
+                case 3: in.hornActive = !in.hornActive; break;
+                case 4: in.navSpeaking = !in.navSpeaking; break;
+                case 5: in.mode = static_cast<Mode>(rng() % 3); break;
+                case 6: in.controlType = rng() % 2 ? VolumeControlType::MANUAL : VolumeControlType::ADAPTIVE;
+                        in.manualVolume = int(rng() % 100); break;
+                default: break;
+            }
+            full.update(in);
+
+            if (in.speed != prev.speed) incremental.setSpeed(in.speed);
+            if (in.cabinNoise != prev.cabinNoise) incremental.setCabinNoise(in.cabinNoise);
+            if (in.reverseGear != prev.reverseGear) incremental.setReverseGear(in.reverseGear);
+            if (in.hornActive != prev.hornActive) incremental.setHorn(in.hornActive);
+            if (in.navSpeaking != prev.navSpeaking) incremental.setNavSpeaking(in.navSpeaking);
+            if (in.mode != prev.mode) incremental.setMode(in.mode);
+            if (in.controlType != prev.controlType) incremental.setControlType(in.controlType);
+            if (in.controlType == VolumeControlType::MANUAL) incremental.setManualVolume(in.manualVolume);
+            incremental.commit();
+
+            assert(full.getTargetVolume() == incremental.getTargetVolume());
+            assert(full.getActiveModifiers() == incremental.getActiveModifiers());
+            setterClock.advance(std::chrono::milliseconds(10 + rng() % 200));
+        }
+    }
+    std::cout << "[Test 36] Per-Signal Setters Passed\n";
+
+    // --- Test 37: Policy engine profiles ---
+    {
+        const char check[] = "123456789";
+        assert(crc32(check, 9) == 0xCBF43926u);
+        assert(crc32(check + 4, 5, crc32(check, 4)) == 0xCBF43926u);
+
+        // The built-in profile reproduces the hardcoded policy
+        ManualClock policyClock;
+        PolicyEngine engine;
+        AdaptiveVolumeControl builtIn(policyClock), tuned(policyClock);
+        tuned.setPolicyEngine(&engine);
+        std::mt19937 rng(15);
+        for (int frame = 0; frame < 5000; ++frame) {
+            ControlInputs in;
+            in.speed = int(rng() % 200) - 10;
+            in.cabinNoise = int(rng() % 256);
+            in.reverseGear = rng() % 8 == 0;
+            in.hornActive = rng() % 6 == 0;
+            in.navSpeaking = rng() % 4 == 0;
+            in.mode = static_cast<Mode>(rng() % 3);
+            builtIn.update(in);
+            tuned.update(in);
+            assert(builtIn.getTargetVolume() == tuned.getTargetVolume());
+            assert(builtIn.getActiveModifiers() == tuned.getActiveModifiers());
+            policyClock.advance(std::chrono::milliseconds(rng() % 300));
+        }
+
+        // A tuned profile file is mapped and hot-swapped in
+        VolumeProfileSpec spec;
+        spec.speedCurve = {{0, 0}, {100, 20}};
+        spec.modifierMultiplier[1] = 0.25f; // deeper navigation duck
+        spec.suddenBrakeThreshold = 20;
+        VolumeProfileData data = compileVolumeProfile(spec);
+        assert(data.speedVolume[50] == 35.0f && data.speedVolume[200] == 45.0f);
+        assert(std::abs(evaluateCurve(spec.speedCurve, 25.0f) - 5.0f) < 1e-6f);
+        assert(data.targetVolume(50, 60, static_cast<Mode>(7), 0) == data.targetVolume(50, 60, Mode::COMFORT, 0));
+        assert(data.targetVolume(50, 60, static_cast<Mode>(-1), 0) == data.targetVolume(50, 60, Mode::COMFORT, 0));
+
+        // Clamps outside the volume range are limited on compile and rejected on load
+        VolumeProfileSpec wide;
+        wide.minVolume = -10.0f;
+        wide.maxVolume = 500.0f;
+        VolumeProfileData limited = compileVolumeProfile(wide);
+        assert(limited.minVolume == AdaptiveVolumeControl::MIN_VOLUME && limited.maxVolume == AdaptiveVolumeControl::MAX_VOLUME);
+        limited.maxVolume = 500.0f;
+        const char* profilePath = "test_profile.avpf";
+        assert(writeVolumeProfile(profilePath, limited));
+        assert(!engine.load(profilePath));
+
+        assert(writeVolumeProfile(profilePath, data));
+        assert(engine.load(profilePath));
+        policyClock.advance(std::chrono::seconds(1));
+        tuned.update(50, 40, false, false, true, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+        tuned.update(50, 40, false, false, true, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+        assert(tuned.getTargetVolume() == (35.0f + 40 * AdaptiveVolumeControl::NOISE_SLOPE) * 0.25f);
+        tuned.update(35, 40, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+        assert(tuned.getActiveModifiers() == MODIFIER_SPEED_DECREASE); // a 15 km/h drop is below the threshold
+
+        // Unchanged frames still pick up a swapped profile
+        float before = tuned.getTargetVolume();
+        tuned.update(35, 40, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+        engine.install(compileVolumeProfile(VolumeProfileSpec{}));
+        tuned.update(35, 40, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+        assert(tuned.getTargetVolume() != before);
+        assert(engine.collectRetired() == 2 && engine.collectRetired() == 0);
+
+        // Corrupt profiles are rejected and the current one stays active
+        if (std::FILE* f = std::fopen(profilePath, "r+b")) {
+            std::fseek(f, 100, SEEK_SET);
+            std::fputc(0x7F, f);
+            std::fclose(f);
+        }
+        const VolumeProfileData* current = &engine.current();
+        assert(!engine.load(profilePath) && &engine.current() == current);
+        assert(!engine.load("missing_profile.avpf"));
+        std::remove(profilePath);
+
+        // A profile still used by a controller survives collectRetired(); a swap is seen by generation, not address
+        {
+            PolicyEngine swapping;
+            AdaptiveVolumeControl user(policyClock);
+            user.setPolicyEngine(&swapping);
+            user.update(60, 50, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+            float builtInTarget = user.getTargetVolume();
+            std::uint64_t generation = swapping.generation();
+
+            VolumeProfileSpec quiet;
+            quiet.speedCurve = {{0, -20}, {200, -20}};
+            swapping.install(compileVolumeProfile(quiet));
+            assert(swapping.generation() == generation + 1);
+            assert(swapping.collectRetired() == 0); // the controller still holds the built-in profile
+            assert(user.targetVolumeAtNoise(70) > builtInTarget); // reads the retained profile
+
+            user.update(60, 50, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+            float quietTarget = user.getTargetVolume();
+            assert(quietTarget < builtInTarget);
+            assert(swapping.collectRetired() == 1);
+
+            // Swap back and forth with freeing in between: every commit follows the latest profile
+            for (int swap = 0; swap < 6; ++swap) {
+                swapping.install(compileVolumeProfile(swap % 2 ? quiet : VolumeProfileSpec{}));
+                swapping.collectRetired();
+                user.update(60, 50, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+                assert(user.getTargetVolume() == (swap % 2 ? quietTarget : builtInTarget));
+                assert(swapping.collectRetired() == 1);
+            }
+
+            // Picking up a swap takes no lock and allocates nothing
+            swapping.install(compileVolumeProfile(VolumeProfileSpec{}));
+            long before = heapAllocations.load();
+            user.update(60, 50, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+            assert(heapAllocations.load() == before && user.getTargetVolume() == builtInTarget);
+        }
+
+        // Hot swaps and collection on another thread while a controller follows them
+        {
+            PolicyEngine shared;
+            AdaptiveVolumeControl follower(policyClock);
+            follower.setPolicyEngine(&shared);
+            std::atomic<bool> stop{false};
+            std::thread loader([&] {
+                VolumeProfileSpec quiet;
+                quiet.speedCurve = {{0, -20}, {200, -20}};
+                for (int swap = 0; !stop; ++swap) {
+                    shared.install(compileVolumeProfile(swap % 2 ? quiet : VolumeProfileSpec{}));
+                    shared.collectRetired();
+                }
+            });
+            for (int i = 0; i < 20000; ++i) {
+                follower.update(60, 50 + i % 2, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+                assert(follower.getTargetVolume() > 0.0f);
+            }
+            stop = true;
+            loader.join();
+
+            // A controller may outlive its engine: the profile goes with the last reference
+            AdaptiveVolumeControl survivor(policyClock);
+            {
+                PolicyEngine shortLived;
+                survivor.setPolicyEngine(&shortLived);
+                survivor.setPolicyEngine(&shortLived);
+            }
+            survivor.setPolicyEngine(nullptr);
+        }
+    }
+    std::cout << "[Test 37] Policy Engine Passed\n";
+
+    // --- Test 38: Ducking arbiter ---
+    {
+        // The horn preset reproduces the built-in horn hold
+        ManualClock duckClock;
+        AdaptiveVolumeControl reference(duckClock);
+        DuckingArbiter hornArbiter;
+        int horn = hornArbiter.registerSource(DuckingArbiter::hornSource());
+        std::mt19937 rng(16);
+        bool pressed = false;
+        for (int frame = 0; frame < 3000; ++frame) {
+            if (rng() % 12 == 0) pressed = !pressed;
+            reference.update(50, 50, false, pressed, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+            hornArbiter.setActive(horn, pressed, duckClock.now());
+            float gain = hornArbiter.evaluate(duckClock.now());
+            bool ducked = (reference.getActiveModifiers() & MODIFIER_HORN_DUCK) != 0;
+            assert(gain == (ducked ? AdaptiveVolumeControl::HORN_DUCK_MULTIPLIER : 1.0f));
+            duckClock.advance(std::chrono::milliseconds(rng() % 150));
+        }
+
+        // Priorities: an exclusive source masks lower ones, higher ones still apply
+        DuckingArbiter arbiter;
+        DuckSourceConfig chime, phone, adas;
+        chime.priority = 50;  chime.depth = 0.5f;
+        phone.priority = 200; phone.depth = 0.2f; phone.mix = DuckMix::EXCLUSIVE;
+        adas.priority = 250;  adas.depth = 0.7f;
+        int chimeId = arbiter.registerSource(chime);
+        int phoneId = arbiter.registerSource(phone);
+        int adasId = arbiter.registerSource(adas);
+        ManualClock::time_point t0{};
+        arbiter.setActive(chimeId, true, t0);
+        assert(arbiter.evaluate(t0) == 0.5f && arbiter.getDominantSource() == chimeId);
+        arbiter.setActive(phoneId, true, t0);
+        assert(arbiter.evaluate(t0) == 0.2f);
+        arbiter.setActive(adasId, true, t0);
+        assert(arbiter.evaluate(t0) == 0.7f * 0.2f && arbiter.getDominantSource() == adasId);
+        arbiter.setActive(adasId, false, t0);
+        arbiter.setActive(phoneId, false, t0);
+        assert(arbiter.evaluate(t0) == 0.5f && arbiter.getDominantSource() == chimeId);
+
+        // Attack, hold and release envelope
+        DuckingArbiter envelope;
+        DuckSourceConfig voice;
+        voice.depth = 0.5f; voice.attack = 0.1f; voice.hold = 0.2f; voice.release = 0.4f;
+        int voiceId = envelope.registerSource(voice);
+        using ms = std::chrono::milliseconds;
+        envelope.setActive(voiceId, true, t0);
+        assert(std::abs(envelope.evaluate(t0 + ms(50)) - 0.75f) < 1e-5f);
+        envelope.setActive(voiceId, true, t0 + ms(500));
+        envelope.setActive(voiceId, false, t0 + ms(510));
+        assert(envelope.evaluate(t0 + ms(690)) == 0.5f);                      // held
+        assert(std::abs(envelope.evaluate(t0 + ms(900)) - 0.75f) < 1e-5f);    // half released
+        assert(envelope.evaluate(t0 + ms(1150)) == 1.0f && envelope.isIdle());
+
+        // Capacity limits
+        DuckingArbiter full;
+        for (int i = 0; i < DuckingArbiter::MAX_SOURCES; ++i) assert(full.registerSource(DuckSourceConfig{}) == i);
+        assert(full.registerSource(DuckSourceConfig{}) == -1);
+        for (int i = 0; i < DuckingArbiter::MAX_ACTIVE; ++i) assert(full.setActive(i, true, t0));
+        assert(!full.setActive(DuckingArbiter::MAX_ACTIVE, true, t0));
+
+        // Attached to a controller, the duck scales the target until the source has released
+        ManualClock avcClock;
+        DuckingArbiter attached;
+        DuckSourceConfig call;
+        call.depth = 0.25f; call.hold = 0.3f;
+        int callId = attached.registerSource(call);
+        AdaptiveVolumeControl ducked(avcClock);
+        ducked.setDuckingArbiter(&attached);
+        ducked.update(50, 50, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+        ducked.update(50, 50, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+        float undisturbed = ducked.getTargetVolume();
+        attached.setActive(callId, true, avcClock.now());
+        ducked.commit();
+        assert(ducked.getTargetVolume() == undisturbed * 0.25f);
+        assert(ducked.getActiveModifiers() == MODIFIER_EXTERNAL_DUCK);
+        attached.setActive(callId, false, avcClock.now());
+        avcClock.advance(ms(200));
+        ducked.commit();
+        assert(ducked.getTargetVolume() == undisturbed * 0.25f);
+        avcClock.advance(ms(200));
+        ducked.commit();
+        assert(ducked.getTargetVolume() == undisturbed && ducked.getActiveModifiers() == 0);
+    }
+    std::cout << "[Test 38] Ducking Arbiter Passed\n";
+
+    // --- Test 39: Fixed-point controller tracks the float controller ---
+    {
+        static_assert(addSat(std::numeric_limits<q16_t>::max(), 1) == std::numeric_limits<q16_t>::max(), "add saturates");
+        static_assert(subSat(std::numeric_limits<q16_t>::min(), 1) == std::numeric_limits<q16_t>::min(), "sub saturates");
+        static_assert(mulQ16(toQ16(-2.5), toQ16(4.0)) == toQ16(-10.0), "signed product");
+        static_assert(mulQ15(toQ15(-1.0), toQ15(-1.0)) == 32767, "Q15 product saturates");
+        static_assert(mulQ16Q15(toQ16(10.0), toQ15(0.5)) == toQ16(5.0), "Q16 x Q15");
+        static_assert(intToQ16(-3) == toQ16(-3.0) && intToQ16(-40000) == std::numeric_limits<q16_t>::min(),
+                      "negative integers convert without a signed shift");
+
+        ManualClock fixedClock;
+        AdaptiveVolumeControl reference(fixedClock);
+        FixedPointVolumeControl fixed(fixedClock);
+        std::mt19937 rng(17);
+        int speed = 40;
+        int settleMismatches = 0;
+        float carry = 0.0f; // gap left when only one side snapped; decays with the smoothing
+        for (int frame = 0; frame < 20000; ++frame) {
+            ControlInputs in;
+            speed = std::max(0, std::min(180, speed + int(rng() % 31) - 16));
+            in.speed = speed;
+            in.cabinNoise = int(rng() % 130);
+            in.reverseGear = rng() % 15 == 0;
+            in.hornActive = rng() % 9 == 0;
+            in.navSpeaking = rng() % 4 == 0;
+            in.mode = static_cast<Mode>(rng() % 3);
+            in.controlType = rng() % 12 == 0 ? VolumeControlType::MANUAL : VolumeControlType::ADAPTIVE;
+            in.manualVolume = int(rng() % 120);
+            reference.update(in);
+            fixed.update(in);
+            assert(fixed.getActiveModifiers() == reference.getActiveModifiers());
+            assert(std::abs(fixed.getTargetVolume() - reference.getTargetVolume()) <= FixedPointVolumeControl::FLOAT_TOLERANCE);
+
+            for (int t = 0; t < 3; ++t) {
+                reference.tick(AdaptiveVolumeControl::SMOOTH_INTERVAL);
+                fixed.tick();
+                carry *= 1.0f - AdaptiveVolumeControl::SMOOTH_FACTOR;
+                if (fixed.isSettled() != reference.isSettled()) {
+                    ++settleMismatches;
+                    carry = AdaptiveVolumeControl::SETTLE_THRESHOLD + FixedPointVolumeControl::FLOAT_TOLERANCE;
+                }
+                float gap = std::abs(fixed.getCurrentVolume() - reference.getCurrentVolume());
+                assert(gap <= FixedPointVolumeControl::FLOAT_TOLERANCE + carry);
+            }
+            fixedClock.advance(std::chrono::milliseconds(rng() % 200));
+        }
+        assert(settleMismatches < 200); // only where the two land on either side of the threshold
+
+        // Q15 block processing ramps to the settled gain
+        FixedPointVolumeControl dsp(fixedClock);
+        dsp.setTickInterval(480.0 / 48000.0);
+        dsp.update(50, 50, false, false, false, Mode::COMFORT, VolumeControlType::MANUAL, 50);
+        std::vector<q15_t> pcm(480 * 2, 16384);
+        for (int i = 0; i < 400 && !dsp.isSettled(); ++i) dsp.processBlock(pcm.data(), 480, 2);
+        std::fill(pcm.begin(), pcm.end(), q15_t(16384));
+        dsp.processBlock(pcm.data(), 480, 2);
+        assert(dsp.getCurrentVolumeQ16() == toQ16(50.0));
+        for (q15_t v : pcm) assert(v == 8192);
+
+        // Fading out steps the gain down (negative ramp) and ends on the new gain
+        dsp.update(50, 50, false, false, false, Mode::COMFORT, VolumeControlType::MANUAL, 10);
+        std::fill(pcm.begin(), pcm.end(), q15_t(16384));
+        dsp.processBlock(pcm.data(), 480, 2);
+        for (std::size_t i = 2; i < pcm.size(); ++i) assert(pcm[i] <= pcm[i - 2]);
+        assert(pcm.front() <= 8192 && pcm.back() < pcm.front());
+        assert(pcm.back() == mulQ15(16384, FixedPointVolumeControl::volumeToGain(dsp.getCurrentVolumeQ16())));
+        assert(FixedPointVolumeControl::volumeToGain(FixedPointVolumeControl::MAX_VOLUME) == 32767);
+    }
+    std::cout << "[Test 39] Fixed-Point Controller Passed\n";
+
+    // --- Test 40: Work-stealing pool runs every index exactly once across workers ---
+    {
+        WorkStealingPool pool(4);
+        assert(pool.size() == 4);
+        for (int run = 0; run < 3; ++run) {
+            const std::uint32_t count = 1000 + run * 777;
+            std::vector<std::atomic<int>> hits(count);
+            std::vector<std::uint64_t> perWorker(pool.size(), 0);
+            pool.parallelFor(count, 3, [&](unsigned worker, std::uint32_t index) {
+                // Uneven work: the first indices are much slower, so other workers must steal
+                if (index < 16) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                hits[index].fetch_add(1, std::memory_order_relaxed);
+                perWorker[worker] += index;
+            });
+            std::uint64_t sum = 0;
+            for (std::uint32_t i = 0; i < count; ++i) assert(hits[i].load() == 1);
+            for (std::uint64_t s : perWorker) sum += s;
+            assert(sum == std::uint64_t(count) * (count - 1) / 2);
+        }
+        int calls = 0;
+        pool.parallelFor(0, 1, [&](unsigned, std::uint32_t) { ++calls; });
+        assert(calls == 0);
+
+        WorkStealingPool single(1);
+        std::vector<std::uint32_t> order;
+        single.parallelFor(10, 4, [&](unsigned worker, std::uint32_t index) {
+            assert(worker == 0);
+            order.push_back(index);
+        });
+        for (std::uint32_t i = 0; i < 10; ++i) assert(order[i] == i);
+    }
+    std::cout << "[Test 40] Work-Stealing Pool Passed\n";
+
+    // --- Test 41: Smoothing curves reach the target exactly within maxTicks() ---
+    {
+        const double dt = 0.01;
+        const SmoothingMode modes[] = {SmoothingMode::DECIBEL_EXPONENTIAL, SmoothingMode::S_CURVE,
+                                       SmoothingMode::RATE_LIMITED};
+        for (SmoothingMode mode : modes) {
+            SmootherConfig config;
+            config.mode = mode;
+            config.attackMs = 250.0f;
+            config.releaseMs = 500.0f;
+            VolumeSmoother smoother(config, dt);
+            assert(smoother.maxTicks() == 50);
+
+            const float jumps[][2] = {{0.0f, 100.0f}, {100.0f, 0.0f}, {35.0f, 60.0f}, {60.0f, 12.5f}};
+            for (const auto& jump : jumps) {
+                float v = jump[0], to = jump[1];
+                int ticks = 0;
+                while (v != to) {
+                    float next = smoother.step(v, to);
+                    assert(to > jump[0] ? next >= v : next <= v); // monotonic
+                    v = next;
+                    assert(++ticks <= (to > jump[0] ? 25 : 50));
+                }
+                assert(smoother.remainingTicks() == 0);
+                if (mode != SmoothingMode::RATE_LIMITED) assert(ticks == (to > jump[0] ? 25 : 50));
+            }
+
+            // A new target mid-transition restarts from the current volume
+            float v = 20.0f;
+            for (int i = 0; i < 10; ++i) v = smoother.step(v, 80.0f);
+            assert(v > 20.0f && v < 80.0f);
+            int ticks = 0;
+            while (v != 30.0f) { v = smoother.step(v, 30.0f); ++ticks; }
+            assert(ticks <= 50);
+        }
+
+        // dB curve: equal volume ratio (constant dB) per tick
+        VolumeSmoother db(SmootherConfig(), dt);
+        float a = 10.0f, b = db.step(a, 40.0f), c = db.step(b, 40.0f);
+        assert(std::abs(b / a - c / b) < 1e-4f);
+
+        // Legacy mode is bit-identical to the built-in tick() smoothing
+        SmootherConfig legacy;
+        legacy.mode = SmoothingMode::LEGACY_LINEAR;
+        VolumeSmoother linear(legacy, dt);
+        AdaptiveVolumeControl builtin, smoothed;
+        smoothed.setVolumeSmoother(&linear);
+        builtin.update(120, 90, false, false, false, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0);
+        smoothed.update(120, 90, false, false, false, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0);
+        int steps = 0;
+        while (!builtin.isSettled() || builtin.getCurrentVolume() != builtin.getTargetVolume()) {
+            builtin.tick(dt);
+            smoothed.tick(dt);
+            assert(builtin.getCurrentVolume() == smoothed.getCurrentVolume());
+            ++steps;
+        }
+        assert(steps <= linear.maxTicks());
+
+        // Attached curve drives tick() and processBlock()
+        SmootherConfig sConfig;
+        sConfig.mode = SmoothingMode::S_CURVE;
+        VolumeSmoother sCurve(sConfig, 480.0 / 48000.0);
+        AdaptiveVolumeControl avc;
+        avc.setVolumeSmoother(&sCurve);
+        avc.update(0, 30, false, false, false, Mode::COMFORT, VolumeControlType::MANUAL, 90);
+        std::vector<float> pcm(480, 1.0f);
+        for (int i = 0; i < sCurve.maxTicks(); ++i) avc.processBlock(pcm.data(), 480, 1);
+        assert(avc.getCurrentVolume() == 90.0f);
+        std::fill(pcm.begin(), pcm.end(), 1.0f);
+        avc.processBlock(pcm.data(), 480, 1);
+        for (float v : pcm) assert(std::abs(v - 0.9f) < 1e-6f);
+
+        // Blocks of 480 and 512 frames step the curve in whole 10 ms ticks: it
+        // converges on schedule, is never reconfigured and never allocates
+        VolumeSmoother varied(sConfig, 0.01);
+        AdaptiveVolumeControl blocks;
+        blocks.setVolumeSmoother(&varied);
+        blocks.update(0, 30, false, false, false, Mode::COMFORT, VolumeControlType::MANUAL, 90);
+        std::vector<float> block(512, 1.0f);
+        double elapsed = 0.0;
+        long before = heapAllocations.load();
+        for (int i = 0; elapsed < varied.maxTicks() * 0.01 + 0.011; ++i) {
+            std::size_t frames = i % 2 ? 512 : 480;
+            blocks.processBlock(block.data(), frames, 1);
+            elapsed += frames / 48000.0;
+        }
+        assert(heapAllocations.load() == before);
+        assert(varied.getTickInterval() == 0.01);
+        assert(blocks.getCurrentVolume() == 90.0f);
+    }
+    std::cout << "[Test 41] Volume Smoother Curves Passed\n";
+
+    // --- Test 42: State snapshot round-trips through persistent memory and resumes identically ---
+    {
+        ManualClock clockA;
+        AdaptiveVolumeControl original(clockA);
+        original.update(80, 70, false, false, false, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0);
+        original.tick(0.1);
+        original.update(65, 70, false, true, true, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0);
+        clockA.advance(std::chrono::milliseconds(100));
+        original.update(65, 70, false, false, true, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0);
+        original.tick(0.1);
+        clockA.advance(std::chrono::milliseconds(800));
+
+        VolumeStateSnapshot state;
+        original.saveState(state);
+        unsigned char nvram[sizeof(VolumeStateSnapshot)];
+        std::memcpy(nvram, &state, sizeof(nvram));
+
+        // Wake on a clock that restarted from zero
+        ManualClock clockB;
+        AdaptiveVolumeControl resumed(clockB);
+        VolumeStateSnapshot loaded;
+        assert(validateVolumeState(nvram, sizeof(nvram), loaded));
+        assert(resumed.restoreState(loaded));
+        assert(resumed.getCurrentVolume() == original.getCurrentVolume());
+        assert(resumed.getTargetVolume() == original.getTargetVolume());
+        assert(resumed.getActiveModifiers() == original.getActiveModifiers());
+        assert(resumed.getActiveModifiers() & MODIFIER_HORN_DUCK);
+        assert(resumed.getMode() == Mode::SPORTS && resumed.isNavSpeaking());
+
+        // Both continue in lock step, including the horn hold expiring 1 s after release
+        for (int frame = 0; frame < 6; ++frame) {
+            clockA.advance(std::chrono::milliseconds(100));
+            clockB.advance(std::chrono::milliseconds(100));
+            original.update(65 - frame * 3, 72, false, false, frame < 3, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0);
+            resumed.update(65 - frame * 3, 72, false, false, frame < 3, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0);
+            original.tick(0.1);
+            resumed.tick(0.1);
+            assert(resumed.getTargetVolume() == original.getTargetVolume());
+            assert(resumed.getCurrentVolume() == original.getCurrentVolume());
+            assert(resumed.getActiveModifiers() == original.getActiveModifiers());
+        }
+        assert(!(original.getActiveModifiers() & MODIFIER_HORN_DUCK));
+
+        // Repeated frames after a restore take the unchanged fast path with the restored target
+        AdaptiveVolumeControl manual;
+        manual.update(0, 30, false, false, false, Mode::ECO, VolumeControlType::MANUAL, 42);
+        manual.saveState(state);
+        AdaptiveVolumeControl fresh;
+        assert(fresh.restoreState(state));
+        fresh.commit();
+        assert(fresh.getTargetVolume() == 42.0f && fresh.getManualVolume() == 42);
+
+        // Corrupted, truncated or foreign images are rejected without changing the controller
+        std::memcpy(nvram, &state, sizeof(nvram));
+        nvram[8] ^= 0x01;
+        assert(!validateVolumeState(nvram, sizeof(nvram), loaded));
+        assert(!validateVolumeState(nvram, sizeof(nvram) - 1, loaded));
+        VolumeStateSnapshot future = state;
+        future.version = VOLUME_STATE_VERSION + 1;
+        future.crc = crc32(&future, offsetof(VolumeStateSnapshot, crc));
+        assert(!fresh.restoreState(future));
+        VolumeStateSnapshot badMode = state;
+        badMode.mode = 7;
+        sealVolumeState(badMode);
+        assert(!fresh.restoreState(badMode));
+        VolumeStateSnapshot badVolume = state;
+        badVolume.currentVolume = -400.0f;
+        sealVolumeState(badVolume);
+        assert(!fresh.restoreState(badVolume));
+        assert(fresh.getTargetVolume() == 42.0f && fresh.getMode() == Mode::ECO);
+    }
+    std::cout << "[Test 42] State Snapshot Restore Passed\n";
+
+    // --- Test 43: Speed trend keys braking on m/s^2, independent of the update rate ---
+    {
+        using std::chrono::milliseconds;
+        ManualClock trendClock;
+
+        // Fitted slope of a quantized 100 Hz ramp; the prediction extrapolates it
+        SpeedTrend trend;
+        for (int i = 0; i <= 100; ++i) {
+            trend.addSample(trendClock.now(), std::round(100.0f - 25.2f * i * 0.01f));
+            trendClock.advance(milliseconds(10));
+        }
+        assert(std::abs(trend.acceleration() + 7.0f) < 0.2f);
+        assert(trend.size() == 51);
+        assert(std::abs(trend.predictSpeed(0.5) - (74.8f - 12.6f)) < 1.0f);
+
+        // Long drives move the time origin without losing precision
+        SpeedTrend cruise(1.0);
+        for (int i = 0; i < 15000; ++i) {
+            cruise.addSample(trendClock.now(), 20.0f + i * 0.01f); // 1 km/h per second
+            trendClock.advance(milliseconds(10));
+        }
+        assert(std::abs(cruise.acceleration() - 1.0f / 3.6f) < 1e-3f);
+        cruise.reset();
+        assert(cruise.size() == 0 && cruise.acceleration() == 0.0f);
+
+        // 1 kHz feed of a 0.3 m/s^2 coast in whole km/h: slots keep the full window,
+        // so the quantization error is the same as at 100 Hz and shrinks with the window
+        auto coast = [&](SpeedTrend& speedTrend, int rateHz, float& maxDeceleration) {
+            maxDeceleration = 0.0f;
+            for (int i = 0; i < rateHz * 10; ++i) {
+                speedTrend.addSample(trendClock.now(), std::round(100.0f - 0.3f * 3.6f * i / rateHz));
+                trendClock.advance(std::chrono::microseconds(1000000 / rateHz));
+                if (i >= rateHz * 3) maxDeceleration = std::max(maxDeceleration, -speedTrend.acceleration());
+            }
+        };
+        float fastCoast = 0.0f, slowCoast = 0.0f, longCoast = 0.0f;
+        SpeedTrend fast, slowFeed, longWindow(2.0);
+        coast(fast, 1000, fastCoast);
+        coast(slowFeed, 100, slowCoast);
+        coast(longWindow, 1000, longCoast);
+        assert(fast.size() <= SpeedTrend::CAPACITY && fast.size() > SpeedTrend::CAPACITY / 2);
+        assert(std::abs(fastCoast - slowCoast) < 0.02f);
+        assert(fastCoast < 1.5f / 0.5f / 3.6f + 0.3f);  // within one step's tilt, not 3.26 m/s^2
+        assert(longCoast < AdaptiveVolumeControl::SPEED_DECREASE_DECELERATION);
+
+        // 100 Hz CAN feed: a 7 m/s^2 stop drops only 0.25 km/h per frame
+        auto runBrake = [&](SpeedTrend* speedTrend, int periodMs, float deceleration, std::uint8_t& seen) {
+            ManualClock clock;
+            AdaptiveVolumeControl avc(clock);
+            avc.setSpeedTrend(speedTrend);
+            seen = 0;
+            double v = 100.0;
+            for (int t = 0; v > 20.0; t += periodMs) {
+                avc.update(static_cast<int>(std::lround(v)), 60, false, false, false, Mode::COMFORT,
+                           VolumeControlType::ADAPTIVE, 0);
+                if (t >= 1000) seen |= avc.getActiveModifiers(); // after the window filled
+                clock.advance(milliseconds(periodMs));
+                v -= deceleration * 3.6 * periodMs / 1000.0;
+            }
+        };
+        std::uint8_t seen = 0;
+        runBrake(nullptr, 10, 7.0f, seen);
+        assert(!(seen & MODIFIER_SUDDEN_BRAKE)); // per-update difference never fires at 100 Hz
+        SpeedTrend hard;
+        runBrake(&hard, 10, 7.0f, seen);
+        assert(seen & MODIFIER_SUDDEN_BRAKE);
+
+        // 1 Hz updates: 3 m/s^2 is normal slowing (11 km/h per update)
+        runBrake(nullptr, 1000, 3.0f, seen);
+        assert(seen & MODIFIER_SUDDEN_BRAKE);   // legacy misreads it as a sudden brake
+        SpeedTrend slow;                        // default window: the two newest updates are kept
+        runBrake(&slow, 1000, 3.0f, seen);
+        assert(!(seen & MODIFIER_SUDDEN_BRAKE) && (seen & MODIFIER_SPEED_DECREASE));
+
+        // The modifier clears once the speed is stable for a window
+        ManualClock clock;
+        AdaptiveVolumeControl avc(clock);
+        SpeedTrend steady;
+        avc.setSpeedTrend(&steady);
+        for (int i = 0; i < 30; ++i) {
+            avc.update(80 - i, 60, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+            clock.advance(milliseconds(10));
+        }
+        assert(avc.getActiveModifiers() & MODIFIER_SUDDEN_BRAKE);
+        for (int i = 0; i < 60; ++i) {
+            avc.update(50, 60, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+            clock.advance(milliseconds(10));
+        }
+        assert(avc.getActiveModifiers() == 0);
+    }
+    std::cout << "[Test 43] Speed Trend Braking Passed\n";
+
+    // --- Test 44: Shared-memory publisher and seqlock reader ---
+    {
+        const std::string name = "/avc_test_" + std::to_string(std::random_device{}());
+        SharedVolumeReader early;
+        assert(!early.open(name)); // nothing published yet
+
+        SharedVolumePublisher publisher;
+        assert(publisher.open(name));
+        SharedVolumeReader reader;
+        assert(reader.open(name));
+
+        AdaptiveVolumeControl avc;
+        avc.update(90, 80, false, true, true, Mode::SPORTS, VolumeControlType::ADAPTIVE, 0);
+        avc.tick(0.1);
+        publisher.publish(avc);
+        SharedVolumeSample sample;
+        assert(reader.read(sample));
+        assert(sample.currentVolume == avc.getCurrentVolume());
+        assert(sample.targetVolume == avc.getTargetVolume());
+        assert(sample.activeModifiers == (MODIFIER_HORN_DUCK | MODIFIER_NAVIGATION));
+        std::uint32_t first = sample.sequence;
+
+        // Readers never see a torn set while the owner publishes at full speed
+        std::atomic<bool> writing{true};
+        std::thread writer([&] {
+            for (int k = 1; k <= 200000; ++k)
+                publisher.publish(static_cast<float>(k), k + 0.5f, static_cast<std::uint8_t>(k & 0x1F));
+            writing = false;
+        });
+        std::uint32_t last = first;
+        int consistent = 0;
+        while (writing || consistent == 0) {
+            if (!reader.read(sample)) continue;
+            assert(sample.targetVolume - sample.currentVolume == 0.5f || sample.sequence == first);
+            if (sample.sequence != first)
+                assert(sample.activeModifiers == (static_cast<int>(sample.currentVolume) & 0x1F));
+            assert(sample.sequence >= last && (sample.sequence & 1u) == 0);
+            last = sample.sequence;
+            ++consistent;
+        }
+        writer.join();
+        assert(reader.read(sample) && sample.currentVolume == 200000.0f && sample.sequence == first + 400000);
+
+        // Closing the publisher removes the name; mapped readers keep the last values
+        publisher.close();
+        assert(reader.read(sample) && sample.currentVolume == 200000.0f);
+        SharedVolumeReader late;
+        assert(!late.open(name));
+    }
+    std::cout << "[Test 44] Shared-Memory Volume Publisher Passed\n";
+
+    // --- Test 45: Coroutine executor multiplexes controllers on one thread in virtual time ---
+#if defined(__cpp_impl_coroutine)
+    {
+        using std::chrono::milliseconds;
+
+        // Timers fire in deadline order, never early, including waits longer than one wheel rotation
+        ManualClock virtualClock;
+        AsyncExecutor executor(virtualClock);
+        const int sleepers = 300;
+        std::vector<Clock::time_point> woke(sleepers);
+        for (int i = 0; i < sleepers; ++i)
+            executor.spawn(sleepAndRecord(executor, milliseconds((i * 7919) % 5000 + 1), woke[i]));
+        assert(executor.getActiveTasks() == sleepers);
+        executor.run();
+        assert(executor.getActiveTasks() == 0 && executor.getArmedTimers() == 0);
+        Clock::time_point latest{};
+        for (int i = 0; i < sleepers; ++i) {
+            assert(woke[i] == Clock::time_point{} + milliseconds((i * 7919) % 5000 + 1));
+            latest = std::max(latest, woke[i]);
+        }
+        assert(virtualClock.now() == latest && latest > Clock::time_point{} + milliseconds(4900));
+
+        // Exceptions reach the awaiting coroutine, or escape run() from a spawned task
+        bool caught = false;
+        executor.spawn(catchNested(executor, caught));
+        executor.run();
+        assert(caught);
+        executor.spawn(failAfterYield(executor));
+        bool escaped = false;
+        try { executor.run(); } catch (const std::runtime_error&) { escaped = true; }
+        assert(escaped);
+
+        // Horn script: same targets as the blocking driver, duck released after the hold
+        ManualClock benchClock;
+        AsyncExecutor bench(benchClock);
+        std::vector<AdaptiveVolumeControl> vehicles(200, AdaptiveVolumeControl(benchClock));
+        std::vector<Clock::time_point> released(vehicles.size());
+        for (std::size_t i = 0; i < vehicles.size(); ++i) bench.spawn(hornScript(bench, vehicles[i], released[i]));
+        bench.run();
+        AdaptiveVolumeControl reference;
+        reference.update(50, 55, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+        for (std::size_t i = 0; i < vehicles.size(); ++i) {
+            assert(vehicles[i].getActiveModifiers() == 0);
+            assert(vehicles[i].getCurrentVolume() == reference.getTargetVolume());
+            assert(benchClock.now() - released[i] >= milliseconds(500));
+        }
+    }
+    std::cout << "[Test 45] Coroutine Async Driver Passed\n";
+#else
+    std::cout << "[Test 45] Coroutine Async Driver Skipped (build with -std=c++20)\n";
+#endif
+
+    // --- Test 46: Interned events and console formatting without heap allocation ---
+    {
+        EventRegistry registry;
+        EventId horn = registry.intern("Horn Pressed");
+        EventId brake = registry.intern("Sudden Brake");
+        assert(horn == 0 && brake == 1 && registry.intern("Horn Pressed") == horn);
+        assert(registry.name(brake) == "Sudden Brake" && registry.size() == 2);
+        assert(registry.find("Reverse Gear Engaged") == INVALID_EVENT_ID && registry.name(INVALID_EVENT_ID).empty());
+        EventRegistry full;
+        char name[3] = {'e', 0, 0};
+        for (std::size_t i = 0; i < EventRegistry::MAX_EVENTS; ++i) {
+            name[1] = static_cast<char>('A' + i / 26);
+            name[2] = static_cast<char>('a' + i % 26);
+            assert(full.intern(std::string_view(name, 3)) == i);
+        }
+        assert(full.intern("One More") == INVALID_EVENT_ID && full.size() == EventRegistry::MAX_EVENTS);
+        char longName[EventRegistry::ARENA_SIZE + 1];
+        std::memset(longName, 'x', sizeof(longName));
+        assert(registry.intern(std::string_view(longName, sizeof(longName))) == INVALID_EVENT_ID);
+
+        FormatBuffer line;
+        line << "Speed: " << 50 << " km/h, " << -7 << " " << std::numeric_limits<int>::min();
+        assert(line.view() == "Speed: 50 km/h, -7 -2147483648" && !line.truncated());
+        for (int i = 0; i < 200; ++i) line << "0123456789";
+        assert(line.truncated() && line.view().size() == FormatBuffer::CAPACITY);
+        line.clear();
+        assert(line.view().empty() && !line.truncated());
+
+        FixedStreamBuffer capture;
+        std::ostream out(&capture);
+        ConsoleVolumeSink console(out);
+        ManualClock clock;
+        AdaptiveVolumeControl avc(clock);
+        avc.setEventSink(&console);
+        avc.setEventRegistry(&registry);
+
+        // Warm-up pass, then the steady-state event path must not touch the heap
+        long allocations = 0;
+        for (int pass = 0; pass < 2; ++pass) {
+            capture.clear();
+            long before = heapAllocations.load();
+            for (int i = 0; i < 20; ++i) {
+                bool hornOn = i % 2 == 0;
+                avc.update(50, 55, false, hornOn, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+                clock.advance(std::chrono::seconds(1));
+                for (int k = 0; k < 100 && avc.getCurrentVolume() != avc.getTargetVolume(); ++k) avc.tick(0.2);
+                avc.printAndSmooth(hornOn ? horn : brake); // settled: prints without sleeping
+            }
+            allocations = heapAllocations.load() - before;
+        }
+        assert(allocations == 0);
+#ifndef ADAPTIVE_VOLUME_RT
+        std::string_view text = capture.view();
+        assert(text.find(" EVENT: Horn Pressed") != std::string_view::npos);
+        assert(text.find(" EVENT: Sudden Brake") != std::string_view::npos);
+        assert(text.find("Speed: 50 km/h | Noise: 55 dB | Mode: Comfort\n") != std::string_view::npos);
+        assert(text.find("[Final Volume Reached Target: ") != std::string_view::npos);
+        assert(console.getTruncatedLines() == 0);
+
+        // An event header that overflows the line ends with a visible marker and is counted
+        capture.clear();
+        EventId longEvent = registry.intern(std::string_view(longName, FormatBuffer::CAPACITY));
+        assert(longEvent != INVALID_EVENT_ID);
+        avc.printAndSmooth(longEvent);
+        std::string_view marked = capture.view();
+        assert(marked.find(FormatBuffer::TRUNCATION_MARKER) == FormatBuffer::CAPACITY - FormatBuffer::TRUNCATION_MARKER.size());
+        assert(console.getTruncatedLines() == 1);
+#else
+        // Real-time builds never write to the console sink
+        assert(capture.view().empty() && console.getTruncatedLines() == 0);
+#endif
+    }
+    std::cout << "[Test 46] Allocation-Free Event Pipeline Passed\n";
+
+    // --- Test 47: Golden trace files and the vectorized trace diff ---
+    {
+        std::mt19937 rng(47);
+        std::uniform_real_distribution<float> volume(0.0f, 100.0f);
+        for (std::size_t n : {std::size_t(0), std::size_t(3), std::size_t(4), std::size_t(1001)}) {
+            std::vector<float> expected(n), actual(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                expected[i] = volume(rng);
+                actual[i] = expected[i] + (rng() % 7 == 0 ? volume(rng) * 0.01f - 0.5f : 0.0f);
+            }
+            if (n > 100) actual[n - 1] = std::numeric_limits<float>::quiet_NaN(); // NaN in the scalar tail
+            if (n > 100) expected[17] = std::numeric_limits<float>::quiet_NaN();  // NaN in a SIMD block
+            TraceDiff fast = diffTraces(expected.data(), actual.data(), n, 0.25f);
+            TraceDiff reference = diffTracesScalar(expected.data(), actual.data(), n, 0.25f);
+            assert(fast.maxError == reference.maxError && fast.maxIndex == reference.maxIndex);
+            assert(fast.exceeding == reference.exceeding && fast.invalid == reference.invalid);
+            assert(std::abs(fast.meanError - reference.meanError) <= 1e-9);
+            if (n > 100) {
+                assert(fast.invalid == 2 && std::isinf(fast.maxError) && fast.maxIndex == 17);
+            }
+        }
+        float same[5] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+        TraceDiff exact = diffTraces(same, same, 5, 0.0f);
+        assert(exact.maxError == 0.0f && exact.meanError == 0.0 && exact.exceeding == 0);
+
+        // Round trip through a golden file
+        const char* path = "test_trace.golden";
+        float target[6] = {25.0f, 30.5f, 30.5f, 12.25f, 0.0f, 80.0f};
+        float current[6] = {25.0f, 26.1f, 28.9f, 20.0f, 10.0f, 45.0f};
+        assert(writeGoldenTrace(path, target, current, 6));
+        {
+            GoldenTraceView golden;
+            assert(golden.open(path) && golden.size() == 6);
+            assert(std::memcmp(golden.targetVolume(), target, sizeof(target)) == 0);
+            assert(std::memcmp(golden.currentVolume(), current, sizeof(current)) == 0);
+        }
+        std::FILE* truncated = std::fopen(path, "r+b");
+        assert(truncated);
+        GoldenTraceHeader header{};
+        assert(std::fread(&header, sizeof(header), 1, truncated) == 1);
+        header.frameCount = 7; // more frames than the file holds
+        std::fseek(truncated, 0, SEEK_SET);
+        assert(std::fwrite(&header, sizeof(header), 1, truncated) == 1);
+        std::fclose(truncated);
+        GoldenTraceView invalid;
+        assert(!invalid.open(path));
+        std::remove(path);
+    }
+    std::cout << "[Test 47] Golden Trace Diff Passed\n";
+
+    // --- Test 48: Multiband gain from band-split noise ---
+    {
+        using AVC = AdaptiveVolumeControl;
+        const float pi = 3.14159265f;
+        MultibandConfig config;
+        config.bands = 4;
+        config.averagingTime = 0.0f;
+
+        // Equal band gains (manual mode) reproduce the broadband gain exactly
+        MultibandGain flat(config);
+        assert(flat.getBands() == 4 && flat.getCrossover(0) == config.lowestCrossover);
+        assert(std::abs(flat.getCrossover(2) - config.highestCrossover) < 0.5f);
+        ManualClock clock;
+        AdaptiveVolumeControl manual(clock);
+        manual.update(80, 70, false, false, false, Mode::COMFORT, VolumeControlType::MANUAL, 40);
+        flat.updateTargets(manual);
+        std::mt19937 rng(48);
+        std::uniform_real_distribution<float> pcm(-0.5f, 0.5f);
+        std::vector<float> block(256 * 2), input;
+        for (int b = 0; b < 1000; ++b) {
+            for (float& s : block) s = pcm(rng);
+            input = block;
+            flat.processBlock(block.data(), 256, 2);
+        }
+        assert(flat.getBandVolume(0) == 40.0f && flat.getBandVolume(3) == 40.0f);
+        for (std::size_t i = 0; i < block.size(); ++i) assert(std::abs(block[i] - input[i] * 0.4f) < 1e-5f);
+
+        // Rumble below the first crossover raises the low band only
+        MultibandGain split(config);
+        std::vector<float> mic(48000);
+        for (std::size_t i = 0; i < mic.size(); ++i) mic[i] = 0.3f * std::sin(2.0f * pi * 60.0f * i / 48000.0f) +
+                                                            0.003f * std::sin(2.0f * pi * 3000.0f * i / 48000.0f);
+        split.analyze(mic.data(), mic.size());
+        assert(split.hasNoiseEstimate());
+        assert(split.getBandNoiseDb(0) > split.getBandNoiseDb(3) + 30.0f);
+        assert(split.getBandNoiseDb(1) < split.getBandNoiseDb(0) - 20.0f);
+
+        AdaptiveVolumeControl avc(clock);
+        avc.update(100, 85, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+        assert(avc.targetVolumeAtNoise(avc.getCabinNoise()) == avc.getTargetVolume());
+        split.updateTargets(avc);
+        assert(split.getBandTarget(0) > split.getBandTarget(1) && split.getBandTarget(1) >= split.getBandTarget(3));
+        assert(split.getBandTarget(0) == avc.targetVolumeAtNoise(split.getBandNoiseLevel(0)));
+
+        // Modifiers scale every band like the broadband target
+        avc.update(100, 85, false, false, true, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+        float navTarget = avc.targetVolumeAtNoise(split.getBandNoiseLevel(3));
+        avc.update(100, 85, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+        float plainTarget = avc.targetVolumeAtNoise(split.getBandNoiseLevel(3));
+        assert(std::abs(navTarget - plainTarget * AVC::NAV_DUCK_MULTIPLIER) < 1e-4f);
+
+        // Less output power than the broadband gain for the same (white) program
+        split.updateTargets(avc);
+        MultibandGain broadband(config); // never analyzed: every band tracks the broadband target
+        broadband.updateTargets(avc);
+        double multibandPower = 0.0, broadbandPower = 0.0;
+        for (int b = 0; b < 1000; ++b) {
+            for (float& s : block) s = pcm(rng);
+            input = block;
+            split.processBlock(block.data(), 256, 2);
+            broadband.processBlock(input.data(), 256, 2);
+            if (b >= 800) {
+                for (float s : block) multibandPower += double(s) * s;
+                for (float s : input) broadbandPower += double(s) * s;
+            }
+        }
+        assert(broadband.getBandVolume(0) == avc.getTargetVolume());
+        assert(multibandPower < 0.8 * broadbandPower);
+    }
+    std::cout << "[Test 48] Multiband Gain Passed\n";
+
+    // --- Test 49: Compile-time specialized controllers match the facade ---
+    {
+        using AVC = AdaptiveVolumeControl;
+        static_assert(!std::is_polymorphic<AVC>::value, "no virtual dispatch left in the facade");
+        static_assert(!std::is_polymorphic<BasicVolumeControl<Mode::ECO, VolumeControlType::ADAPTIVE>>::value,
+                      "specialized controller has no vtable");
+
+        ManualClock clock;
+        BasicVolumeControl<Mode::SPORTS, VolumeControlType::ADAPTIVE> sports(clock);
+        ControlInputs in;
+        in.speed = 80;
+        in.cabinNoise = 60;
+        sports.update(in);
+        assert(sports.getTargetVolume() == (AVC::BASE_VOLUME + AVC::HIGH_SPEED_BOOST + 60 * AVC::NOISE_SLOPE) * AVC::SPORTS_MULTIPLIER);
+        BasicVolumeControl<Mode::ECO, VolumeControlType::MANUAL, InstantSmoothing> manual(clock);
+        in.manualVolume = 140;
+        manual.update(in);
+        manual.tick(0.01);
+        assert(manual.getCurrentVolume() == AVC::MAX_VOLUME);
+
+        // Same random drive through the facade and the runtime wrapper, switching modes on the way
+        AVC avc(clock);
+        RuntimeVolumeControl<> runtime(clock);
+        std::mt19937 rng(49);
+        int speed = 40;
+        for (int i = 0; i < 20000; ++i) {
+            speed = std::max(0, std::min(160, speed + int(rng() % 31) - 17));
+            in.speed = speed;
+            in.cabinNoise = 20 + int(rng() % 100);
+            in.reverseGear = rng() % 40 == 0;
+            in.hornActive = rng() % 15 == 0;
+            in.navSpeaking = rng() % 6 == 0;
+            if (rng() % 200 == 0) in.mode = static_cast<Mode>(rng() % 3);
+            if (rng() % 300 == 0) in.controlType = in.controlType == VolumeControlType::MANUAL ? VolumeControlType::ADAPTIVE : VolumeControlType::MANUAL;
+            in.manualVolume = int(rng() % 110);
+            double dt = (1 + rng() % 4) * 0.05;
+            clock.advance(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(dt)));
+
+            avc.update(in);
+            assert(runtime.update(in));
+            assert(runtime.getMode() == in.mode && runtime.getControlType() == in.controlType);
+            assert(runtime.getTargetVolume() == avc.getTargetVolume());
+            assert(runtime.getActiveModifiers() == avc.getActiveModifiers());
+            avc.tick(dt);
+            runtime.tick(dt);
+            assert(runtime.getCurrentVolume() == avc.getCurrentVolume());
+        }
+
+        // Out-of-range enums reject the frame instead of keeping a stale instantiation
+        VolumeControlState before = runtime.state();
+        ControlInputs bad = in;
+        bad.speed = 150;
+        bad.mode = static_cast<Mode>(3);
+        assert(!runtime.update(bad));
+        bad.mode = Mode::ECO;
+        bad.controlType = static_cast<VolumeControlType>(-1);
+        assert(!runtime.update(bad));
+        assert(runtime.getMode() == in.mode && runtime.getControlType() == in.controlType);
+        assert(runtime.state().speed == before.speed && runtime.getTargetVolume() == before.targetVolume);
+    }
+    std::cout << "[Test 49] Compile-Time Policy Specialization Passed\n";
+
+    // --- Test 50: Amplifier output stage coalescing, rate limiting and hardware ramps ---
+    {
+        struct BusWrite { double time; float volume; double seconds; bool ramp; };
+        struct RecordingBus : AmplifierBus {
+            std::vector<BusWrite> writes;
+            double now = 0.0;
+            int failures = 0;
+            bool writeVolume(float volume) override {
+                if (failures > 0) { --failures; return false; }
+                writes.push_back({now, volume, 0.0, false});
+                return true;
+            }
+            bool writeRamp(float target, double seconds) override {
+                if (failures > 0) { --failures; return false; }
+                writes.push_back({now, target, seconds, true});
+                return true;
+            }
+        };
+
+        // Drive at 100 Hz: accelerate, horn tap, navigation prompt; returns the software update count
+        auto drive = [](RecordingBus& bus, AmplifierOutputStage& stage, AdaptiveVolumeControl& avc, ManualClock& clock) {
+            int steps = 0;
+            for (int i = 0; i < 1000; ++i) {
+                double t = i * 0.01;
+                bool horn = t >= 3.0 && t < 3.3;
+                bool nav = t >= 5.0 && t < 7.0;
+                avc.update(50, 55, false, horn, nav, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+                float before = avc.getCurrentVolume();
+                avc.tick(0.01);
+                if (avc.getCurrentVolume() != before) ++steps;
+                bus.now = t;
+                stage.update(avc, clock.now());
+                clock.advance(std::chrono::milliseconds(10));
+            }
+            return steps;
+        };
+
+        ManualClock clock;
+        AdaptiveVolumeControl avc(clock);
+        RecordingBus bus;
+        AmplifierOutputStage stage(bus); // 1.0 threshold, 20 writes/s
+        int steps = drive(bus, stage, avc, clock);
+        assert(avc.isSettled());
+        assert(stage.getWrittenVolume() == avc.getCurrentVolume());
+        assert(bus.writes.size() == stage.getVolumeWrites() && stage.getRampWrites() == 0);
+        assert(bus.writes.size() * 4 < static_cast<std::size_t>(steps));
+        for (std::size_t i = 1; i < bus.writes.size(); ++i) assert(bus.writes[i].time - bus.writes[i - 1].time >= 0.05 - 1e-9);
+        assert(stage.getCoalesced() > 0);
+
+        // Hardware ramps: one absolute write, then only the endpoints of target changes
+        ManualClock rampClock;
+        AdaptiveVolumeControl rampAvc(rampClock);
+        RecordingBus rampBus;
+        AmplifierOutputConfig config;
+        config.hardwareRamp = true;
+        AmplifierOutputStage rampStage(rampBus, config);
+        drive(rampBus, rampStage, rampAvc, rampClock);
+        assert(rampStage.getVolumeWrites() == 1 && !rampBus.writes[0].ramp);
+        assert(rampStage.getRampWrites() >= 4 && rampStage.getRampWrites() <= 6);
+        assert(rampStage.getWrittenVolume() == rampAvc.getTargetVolume());
+        assert(rampBus.writes[1].ramp && rampBus.writes[1].volume == 46.0f);
+        for (std::size_t i = 1; i < rampBus.writes.size(); ++i)
+            assert(rampBus.writes[i].ramp && rampBus.writes[i].seconds > 1.0 && rampBus.writes[i].seconds < 2.5);
+
+        // The built-in smoothing settles when settleTime() predicts
+        ManualClock settleClock;
+        AdaptiveVolumeControl settle(settleClock);
+        settle.update(50, 55, false, false, false, Mode::COMFORT, VolumeControlType::ADAPTIVE, 0);
+        double settled = 0.0;
+        while (!settle.isSettled()) { settle.tick(0.001); settled += 0.001; }
+        assert(std::abs(settled - AmplifierOutputStage::settleTime(25.0f, 46.0f)) < 0.002);
+
+        // Failed transfers are retried within the rate limit
+        RecordingBus flaky;
+        flaky.failures = 2;
+        AmplifierOutputStage retry(flaky);
+        Clock::time_point t0{};
+        retry.update(30.0f, 30.0f, t0);
+        retry.update(30.0f, 30.0f, t0 + std::chrono::milliseconds(10));  // inside the interval: waits
+        retry.update(30.0f, 30.0f, t0 + std::chrono::milliseconds(60));
+        retry.update(30.0f, 30.0f, t0 + std::chrono::milliseconds(120));
+        assert(retry.getBusErrors() == 2 && retry.getVolumeWrites() == 1 && retry.getWrittenVolume() == 30.0f);
+        retry.update(30.0f, 30.0f, t0 + std::chrono::milliseconds(500));
+        assert(flaky.writes.size() == 1); // unchanged: nothing to send
+    }
+    std::cout << "[Test 50] Amplifier Output Stage Passed\n";
+
+    // --- Test 51: Real-time mode: caller timestamps, bounded smoothing, no clock reads or allocations ---
+    {
+        using AVC = AdaptiveVolumeControl;
+        static_assert(AVC::MAX_SMOOTH_STEPS == 15, "100 -> 0.5 at a 0.3 factor takes 15 steps");
+
+        struct CountingClock : Clock {
+            mutable long reads = 0;
+            time_point now() const override { ++reads; return time_point{}; }
+        };
+
+        // Timestamped frames match a ManualClock-driven controller with an arbiter and a speed trend attached
+        CountingClock counting;
+        AVC rt(counting);
+        ManualClock clock;
+        AVC reference(clock);
+        DuckingArbiter rtDucks, referenceDucks;
+        int rtChime = rtDucks.registerSource(DuckSourceConfig{10, 0.7f, 0.05f, 0.2f, 0.3f, DuckMix::MULTIPLY});
+        int referenceChime = referenceDucks.registerSource(DuckSourceConfig{10, 0.7f, 0.05f, 0.2f, 0.3f, DuckMix::MULTIPLY});
+        SpeedTrend rtTrend, referenceTrend;
+        rt.setDuckingArbiter(&rtDucks);
+        rt.setSpeedTrend(&rtTrend);
+        reference.setDuckingArbiter(&referenceDucks);
+        reference.setSpeedTrend(&referenceTrend);
+        long counted = counting.reads; // construction stamps the horn-duck start once
+
+        std::mt19937 rng(51);
+        ControlInputs in;
+        int speed = 60;
+        long allocations = 0;
+        for (int pass = 0; pass < 2; ++pass) {
+            long before = heapAllocations.load();
+            for (int i = 0; i < 5000; ++i) {
+                speed = std::max(0, std::min(150, speed + int(rng() % 21) - 11));
+                in.speed = speed;
+                in.cabinNoise = 30 + int(rng() % 70);
+                in.hornActive = rng() % 12 == 0;
+                in.navSpeaking = rng() % 9 == 0;
+                in.reverseGear = rng() % 50 == 0;
+                bool chime = rng() % 7 == 0;
+                clock.advance(std::chrono::milliseconds(10));
+                Clock::time_point now = clock.now();
+
+                rtDucks.setActive(rtChime, chime, now);
+                referenceDucks.setActive(referenceChime, chime, now);
+                rt.update(in, now);
+                reference.update(in);
+                assert(rt.getTargetVolume() == reference.getTargetVolume());
+                assert(rt.getActiveModifiers() == reference.getActiveModifiers());
+                rt.tick(0.01);
+                reference.tick(0.01);
+                assert(rt.getCurrentVolume() == reference.getCurrentVolume());
+            }
+            allocations = heapAllocations.load() - before;
+        }
+        assert(allocations == 0);
+        assert(counting.reads == counted);
+
+        // Setter path with a timestamp, and the manual volume is kept while adaptive like update()
+        rt.setControlType(VolumeControlType::MANUAL);
+        rt.setManualVolume(70);
+        rt.commit(clock.now());
+        in.controlType = VolumeControlType::ADAPTIVE;
+        in.manualVolume = 5;
+        rt.update(in, clock.now());
+        assert(rt.getManualVolume() == 70 && counting.reads == counted);
+
+        // The largest transition settles within MAX_SMOOTH_STEPS built-in steps
+        AVC jump(clock);
+        jump.update(0, 0, false, false, false, Mode::COMFORT, VolumeControlType::MANUAL, 0);
+        while (jump.getCurrentVolume() != 0.0f) jump.tick(AVC::SMOOTH_INTERVAL);
+        int steps = 0;
+        jump.setManualVolume(100);
+        jump.commit();
+        while (jump.getCurrentVolume() != jump.getTargetVolume()) {
+            jump.tick(AVC::SMOOTH_INTERVAL);
+            ++steps;
+        }
+        assert(steps == AVC::MAX_SMOOTH_STEPS);
+
+        // Out-of-range manual volumes are clamped first, so the bound still holds
+        jump.setManualVolume(-1000);
+        jump.commit();
+        assert(jump.getTargetVolume() == AVC::MIN_VOLUME);
+        for (steps = 0; jump.getCurrentVolume() != jump.getTargetVolume(); ++steps) jump.tick(AVC::SMOOTH_INTERVAL);
+        assert(steps == AVC::MAX_SMOOTH_STEPS);
+        BasicVolumeControl<Mode::ECO, VolumeControlType::MANUAL, InstantSmoothing> negative(clock);
+        in.manualVolume = -5;
+        negative.update(in);
+        assert(negative.getTargetVolume() == AVC::MIN_VOLUME);
+    }
+    std::cout << "[Test 51] Real-Time Mode Passed\n";
+
+    // --- Test 52: Fleet state advances every vehicle exactly like its own controller, across shards ---
+    {
+        using AVC = AdaptiveVolumeControl;
+        static_assert(VehicleFleet::BYTES_PER_VEHICLE == 24, "a few dozen bytes per vehicle");
+
+        const std::uint32_t vehicles = 1000;
+        FleetConfig config;
+        config.vehicles = vehicles;
+        config.threads = 3;
+        config.blockVehicles = 64; // 16 blocks over 3 shards: uneven blocks and a partial last block
+        VehicleFleet fleet(config);
+        assert(fleet.getVehicles() == vehicles && fleet.getShards() == 3);
+        std::uint32_t covered = 0;
+        for (unsigned s = 0; s < fleet.getShards(); ++s) covered += fleet.getShardVehicles(s);
+        assert(covered == vehicles);
+        for (std::uint32_t v = 0; v < vehicles; ++v) assert(fleet.getCurrentVolume(v) == AVC::DEFAULT_VOLUME);
+
+        // One compact controller per vehicle on a shared frame clock, plus the facade for vehicle 0
+        ManualClock clock;
+        std::vector<RuntimeVolumeControl<>> reference(vehicles, RuntimeVolumeControl<>(clock));
+        std::vector<ControlInputs> inputs(vehicles);
+        AVC facade(clock);
+
+        std::mt19937 rng(52);
+        std::int64_t timestampNs = 0;
+        std::vector<FleetTelemetry> batch;
+        std::vector<float> volumes;
+        for (int frame = 0; frame < 300; ++frame) {
+            double dt = frame % 50 < 40 ? 0.1 : 0.05; // the shared smoothing factor changes with dt
+            timestampNs += static_cast<std::int64_t>(dt * 1e9);
+
+            batch.clear();
+            for (int r = 0; r < 200; ++r) {
+                FleetTelemetry record{};
+                record.vehicle = frame == 0 && r == 0 ? 0 : rng() % vehicles; // the facade evaluates from its first change
+                record.speed = static_cast<std::int16_t>(rng() % 140);
+                record.cabinNoise = static_cast<std::uint8_t>(rng() % 110);
+                record.manualVolume = static_cast<std::uint8_t>(rng() % 101);
+                record.flags = static_cast<std::uint8_t>((rng() % 10 == 0 ? FLEET_HORN : 0) | (rng() % 8 == 0 ? FLEET_NAVIGATION : 0) |
+                                                         (rng() % 40 == 0 ? FLEET_REVERSE : 0) | (rng() % 6 == 0 ? FLEET_MANUAL : 0));
+                record.mode = static_cast<std::uint8_t>(rng() % 3);
+                batch.push_back(record);
+            }
+            FleetTelemetry unknown{};
+            unknown.vehicle = vehicles;
+            batch.push_back(unknown);
+            FleetTelemetry badMode{};
+            badMode.vehicle = 0;
+            badMode.mode = 7;
+            batch.push_back(badMode);
+
+            assert(fleet.ingest(batch.data(), batch.size()) == batch.size() - 2);
+            fleet.advance(timestampNs, dt);
+
+            // Later records win; vehicles without a record repeat their inputs
+            for (std::size_t r = 0; r + 2 < batch.size(); ++r) {
+                ControlInputs next = fleetInputs(batch[r]);
+                if (next.controlType != VolumeControlType::MANUAL) next.manualVolume = inputs[batch[r].vehicle].manualVolume;
+                inputs[batch[r].vehicle] = next;
+            }
+            clock.set(Clock::time_point(std::chrono::nanoseconds(timestampNs)));
+            for (std::uint32_t v = 0; v < vehicles; ++v) {
+                reference[v].update(inputs[v]);
+                reference[v].tick(dt);
+                assert(fleet.getTargetVolume(v) == reference[v].getTargetVolume());
+                assert(fleet.getCurrentVolume(v) == reference[v].getCurrentVolume());
+            }
+            facade.update(inputs[0], clock.now());
+            facade.tick(dt);
+            assert(fleet.getTargetVolume(0) == facade.getTargetVolume());
+            assert(fleet.getCurrentVolume(0) == facade.getCurrentVolume());
+
+            volumes.assign(batch.size(), 0.0f);
+            fleet.trace(batch.data(), batch.size(), volumes.data());
+            assert(volumes[0] == fleet.getCurrentVolume(batch[0].vehicle));
+            assert(std::isnan(volumes[batch.size() - 2]));
+        }
+
+        // Wire layout of a batch: header, then packed records
+        static_assert(sizeof(FleetFrameHeader) + 2 * sizeof(FleetTelemetry) == 40, "no padding on the wire");
+        FleetTelemetry encoded{7, -3, 90, 40, FLEET_MANUAL | FLEET_HORN, static_cast<std::uint8_t>(Mode::SPORTS), 0};
+        ControlInputs decoded = fleetInputs(encoded);
+        assert(decoded.speed == -3 && decoded.cabinNoise == 90 && decoded.manualVolume == 40 && decoded.mode == Mode::SPORTS);
+        assert(decoded.controlType == VolumeControlType::MANUAL && decoded.hornActive && !decoded.navSpeaking && !decoded.reverseGear);
+    }
+    std::cout << "[Test 52] Vehicle Fleet Passed\n";
+
+    std::cout << "\nAll 52 tests passed successfully!\n";
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,286 @@
+/**
+ * @file wcet_bench.cpp
+ * @brief Measures the worst observed execution time of the control path over randomized inputs.
+ *
+ * Usage: wcet_bench [--frames N] [--seed N]
+ *
+ * Build with -DADAPTIVE_VOLUME_RT. Every frame draws random inputs (speed
+ * jumps and brakes, noise, horn taps and holds, navigation, reverse, mode
+ * and control-type changes, duck sources) and times update(inputs, now)
+ * and tick(dt) separately with readCycleCounter(). Three configurations run:
+ *   builtin  AdaptiveVolumeControl with the built-in policy
+ *   full     plus PolicyEngine, DuckingArbiter (4 sources), SpeedTrend and VolumeSmoother
+ *   basic    RuntimeVolumeControl (compile-time specialized policy)
+ * The report lists p50 / p99.99 / max counter ticks per call and the frame
+ * of the maximum. Measured maxima complement WCET.md; they are not a bound.
+ */
+
+#include "AdaptiveVolumeControl.h"
+#include "BasicVolumeControl.h"
+#include "DuckingArbiter.h"
+#include "Instrumentation.h"
+#include "PolicyEngine.h"
+#include "SpeedTrend.h"
+#include "VolumeSmoother.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifndef ADAPTIVE_VOLUME_RT
+#warning "wcet_bench measures the real-time build; compile with -DADAPTIVE_VOLUME_RT"
+#endif
+
+namespace {
+
+constexpr double FRAME_DT = 0.001;          ///< Control period (1 kHz)
+constexpr int DUCK_SOURCES = 4;             ///< Arbiter sources in the full configuration
+constexpr std::size_t BUCKETS = 1 << 16;    ///< Histogram range in counter ticks (larger values go to the last bucket)
+
+/**
+ * @struct BenchConfig
+ * @brief Command-line parameters.
+ */
+struct BenchConfig {
+    std::uint64_t frames = 2000000;     ///< Timed frames per configuration
+    std::uint64_t seed = 1;             ///< Input stream seed
+};
+
+/**
+ * @class CallTimes
+ * @brief Preallocated histogram of per-call counter ticks (no allocation while timing).
+ */
+class CallTimes {
+public:
+    CallTimes() : histogram(BUCKETS, 0) {}
+
+    /**
+     * @brief Records one call.
+     * @param ticks Counter ticks of the call.
+     * @param frame Frame index (kept for the maximum).
+     */
+    void add(std::uint64_t ticks, std::uint64_t frame) {
+        ++histogram[std::min<std::uint64_t>(ticks, BUCKETS - 1)];
+        ++count;
+        if(ticks > maximum) {
+            maximum = ticks;
+            maximumFrame = frame;
+        }
+    }
+
+    /**
+     * @brief Gets a percentile from the histogram.
+     * @param fraction Percentile in [0, 1].
+     * @return Counter ticks.
+     */
+    std::uint64_t percentile(double fraction) const {
+        std::uint64_t rank = static_cast<std::uint64_t>(fraction * static_cast<double>(count));
+        std::uint64_t seen = 0;
+        for(std::size_t ticks = 0; ticks < BUCKETS; ++ticks) {
+            seen += histogram[ticks];
+            if(seen > rank) return ticks;
+        }
+        return maximum;
+    }
+
+    /**
+     * @brief Prints one report line.
+     * @param configuration Configuration name.
+     * @param call Timed call.
+     */
+    void print(const char* configuration, const char* call) const {
+        std::printf("%-8s %-7s %10llu %10llu %10llu %12llu\n", configuration, call,
+                    static_cast<unsigned long long>(percentile(0.5)), static_cast<unsigned long long>(percentile(0.9999)),
+                    static_cast<unsigned long long>(maximum), static_cast<unsigned long long>(maximumFrame));
+    }
+
+private:
+    std::vector<std::uint32_t> histogram;   ///< Calls per tick count
+    std::uint64_t count = 0;                ///< Calls recorded
+    std::uint64_t maximum = 0;              ///< Largest tick count seen
+    std::uint64_t maximumFrame = 0;         ///< Frame of the maximum
+};
+
+/**
+ * @struct FrameInputs
+ * @brief One randomized frame.
+ */
+struct FrameInputs {
+    ControlInputs inputs;                   ///< Controller inputs
+    bool duck[DUCK_SOURCES];                ///< Arbiter source activity
+};
+
+/**
+ * @class InputStream
+ * @brief Randomized but drivable input sequence (xorshift, no allocation).
+ */
+class InputStream {
+public:
+    explicit InputStream(std::uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ull + 1) {}
+
+    /**
+     * @brief Draws the next frame.
+     * @param frame Receives the inputs.
+     */
+    void next(FrameInputs& frame) {
+        ControlInputs& in = frame.inputs;
+        std::uint32_t r = draw();
+        // Mostly smooth driving, with jumps and hard brakes to hit both brake modifiers
+        if(r % 500 == 0) speed = static_cast<int>(draw() % 180);
+        else if(r % 97 == 0) speed = std::max(0, speed - 11 - static_cast<int>(draw() % 30));
+        else speed = std::max(0, std::min(200, speed + static_cast<int>(draw() % 5) - 2));
+        in.speed = speed;
+        in.cabinNoise = static_cast<int>(draw() % 140);
+        if(draw() % 200 == 0) horn = !horn;
+        in.hornActive = horn;
+        if(draw() % 300 == 0) navigation = !navigation;
+        in.navSpeaking = navigation;
+        if(draw() % 1000 == 0) reverse = !reverse;
+        in.reverseGear = reverse;
+        if(draw() % 2000 == 0) in.mode = static_cast<Mode>(draw() % 3);
+        if(draw() % 5000 == 0)
+            in.controlType = in.controlType == VolumeControlType::MANUAL ? VolumeControlType::ADAPTIVE : VolumeControlType::MANUAL;
+        in.manualVolume = static_cast<int>(draw() % 110);
+        for(bool& duck : frame.duck) if(draw() % 150 == 0) duck = !duck;
+    }
+
+private:
+    std::uint64_t state;    ///< xorshift state
+    int speed = 50;         ///< Current speed
+    bool horn = false;      ///< Horn held
+    bool navigation = false; ///< Prompt speaking
+    bool reverse = false;   ///< Reverse engaged
+
+    std::uint32_t draw() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<std::uint32_t>(state >> 32);
+    }
+};
+
+/**
+ * @brief Times update() and tick() of one controller setup over the input stream.
+ * @param config Parameters.
+ * @param name Configuration name.
+ * @param step Called per frame with the inputs, the frame time and both histograms.
+ */
+template <class Step>
+void measure(const BenchConfig& config, const char* name, Step step) {
+    CallTimes update, tick;
+    InputStream stream(config.seed);
+    FrameInputs frame{};
+    Clock::time_point now{};
+    std::uint64_t warmup = std::min<std::uint64_t>(config.frames / 10, 100000);
+    for(std::uint64_t i = 0; i < warmup + config.frames; ++i) {
+        stream.next(frame);
+        now += std::chrono::microseconds(1000);
+        std::uint64_t updateTicks = 0, tickTicks = 0;
+        step(frame, now, updateTicks, tickTicks);
+        if(i >= warmup) {
+            update.add(updateTicks, i - warmup);
+            tick.add(tickTicks, i - warmup);
+        }
+    }
+    update.print(name, "update");
+    tick.print(name, "tick");
+}
+
+/**
+ * @brief Parses the command line.
+ * @param argc Argument count.
+ * @param argv Arguments.
+ * @param config Receives the parameters.
+ * @return False on a malformed command line.
+ */
+bool parseArguments(int argc, char** argv, BenchConfig& config) {
+    for(int i = 1; i < argc; ++i) {
+        if(i + 1 >= argc) return false;
+        const char* name = argv[i];
+        const char* value = argv[++i];
+        char* end = nullptr;
+        if(!std::strcmp(name, "--frames")) config.frames = std::strtoull(value, &end, 10);
+        else if(!std::strcmp(name, "--seed")) config.seed = std::strtoull(value, &end, 10);
+        else return false;
+        if(!end || *end) return false;
+    }
+    return config.frames > 0;
+}
+
+} // namespace
+
+/**
+ * @brief Main entry point. Runs every configuration and prints the cycle report.
+ * @return Exit code.
+ */
+int main(int argc, char** argv) {
+    BenchConfig config;
+    if(!parseArguments(argc, argv, config)) {
+        std::fprintf(stderr, "usage: %s [--frames N] [--seed N]\n", argv[0]);
+        return 2;
+    }
+
+    std::printf("%llu frames per configuration at %.0f Hz, readCycleCounter() ticks per call\n",
+                static_cast<unsigned long long>(config.frames), 1.0 / FRAME_DT);
+    std::printf("%-8s %-7s %10s %10s %10s %12s\n", "config", "call", "p50", "p99.99", "max", "max frame");
+
+    ManualClock unused; // never read: every frame passes its timestamp
+    {
+        AdaptiveVolumeControl avc(unused);
+        measure(config, "builtin", [&](const FrameInputs& frame, Clock::time_point now, std::uint64_t& u, std::uint64_t& t) {
+            std::uint64_t start = readCycleCounter();
+            avc.update(frame.inputs, now);
+            std::uint64_t middle = readCycleCounter();
+            avc.tick(FRAME_DT);
+            std::uint64_t stop = readCycleCounter();
+            u = middle - start;
+            t = stop - middle;
+        });
+    }
+    {
+        AdaptiveVolumeControl avc(unused);
+        PolicyEngine policy;
+        DuckingArbiter ducking;
+        int sources[DUCK_SOURCES];
+        for(int i = 0; i < DUCK_SOURCES; ++i) {
+            DuckSourceConfig source{static_cast<std::uint8_t>(10 * i), 0.5f + 0.1f * i, 0.05f, 0.2f, 0.3f,
+                                    i == DUCK_SOURCES - 1 ? DuckMix::EXCLUSIVE : DuckMix::MULTIPLY};
+            sources[i] = ducking.registerSource(source);
+        }
+        SpeedTrend trend;
+        SmootherConfig curve;
+        VolumeSmoother smoother(curve, FRAME_DT); // tick interval = frame period: one step per tick()
+        avc.setPolicyEngine(&policy);
+        avc.setDuckingArbiter(&ducking);
+        avc.setSpeedTrend(&trend);
+        avc.setVolumeSmoother(&smoother);
+        measure(config, "full", [&](const FrameInputs& frame, Clock::time_point now, std::uint64_t& u, std::uint64_t& t) {
+            for(int i = 0; i < DUCK_SOURCES; ++i) ducking.setActive(sources[i], frame.duck[i], now);
+            std::uint64_t start = readCycleCounter();
+            avc.update(frame.inputs, now);
+            std::uint64_t middle = readCycleCounter();
+            avc.tick(FRAME_DT);
+            std::uint64_t stop = readCycleCounter();
+            u = middle - start;
+            t = stop - middle;
+        });
+    }
+    {
+        // The template reads the clock only around horn presses; feed it the frame time the same way
+        ManualClock frameClock;
+        RuntimeVolumeControl<> basic(frameClock);
+        measure(config, "basic", [&](const FrameInputs& frame, Clock::time_point now, std::uint64_t& u, std::uint64_t& t) {
+            frameClock.set(now);
+            std::uint64_t start = readCycleCounter();
+            basic.update(frame.inputs);
+            std::uint64_t middle = readCycleCounter();
+            basic.tick(FRAME_DT);
+            std::uint64_t stop = readCycleCounter();
+            u = middle - start;
+            t = stop - middle;
+        });
+    }
+    return 0;
+}